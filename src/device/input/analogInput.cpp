@@ -14,6 +14,16 @@
 #include "device/input/input.hpp"
 #include "device/interface/HomeAssistant.hpp"
 
+// Microphone dont les échantillons sont traités par l'interruption du convertisseur analogique-numérique.
+static Microphone *sampledMicrophone = nullptr;
+
+// Fin d'une conversion du convertisseur en mode continu.
+ISR(ADC_vect)
+{
+    if (sampledMicrophone != nullptr)
+        sampledMicrophone->storeSample(ADC);
+}
+
 /// @brief Constructeur de la classe.
 /// @param friendlyName Le nom formaté pour être présenté à l'utilisateur du périphérique.
 /// @param ID L'identifiant unique du périphérique utilisé pour communiquer avec Home Assistant.
@@ -58,7 +68,238 @@ void AnalogInput::loop()
 unsigned int AnalogInput::getValue()
 {
     if (m_operational)
-        m_value = analogRead(m_pin);
+        m_value = readPin(m_pin);
 
     return m_value;
-}
\ No newline at end of file
+}
+
+/// @brief Lecture analogique compatible avec l'échantillonnage en continu du microphone : le convertisseur est suspendu le temps de la lecture.
+/// @param pin La broche à lire.
+/// @return La valeur lue, de `0` à `1023`.
+unsigned int AnalogInput::readPin(unsigned int pin)
+{
+    if (!(ADCSRA & _BV(ADATE)))
+        return analogRead(pin);
+
+    uint8_t oldADCSRA = ADCSRA;
+    uint8_t oldADMUX = ADMUX;
+    uint8_t oldADCSRB = ADCSRB;
+
+    // Arrêt du mode continu et attente de la fin de la conversion en cours.
+    ADCSRA = oldADCSRA & ~(_BV(ADATE) | _BV(ADIE));
+    while (ADCSRA & _BV(ADSC))
+        ;
+
+    unsigned int value = analogRead(pin);
+
+    // Reprise de l'échantillonnage (l'écriture de `ADIF` efface le drapeau laissé par la lecture).
+    ADMUX = oldADMUX;
+    ADCSRB = oldADCSRB;
+    ADCSRA = oldADCSRA | _BV(ADSC) | _BV(ADIF);
+
+    return value;
+}
+
+/// @brief Constructeur de la classe.
+/// @param friendlyName Le nom formaté pour être présenté à l'utilisateur du périphérique.
+/// @param ID L'identifiant unique du périphérique utilisé pour communiquer avec Home Assistant.
+/// @param connection L'instance utilisée pour la communication avec Home Assistant.
+/// @param pin La broche analogique liée au microphone.
+/// @param connected Permet d'envoyer l'état du capteur à Home Assistant ou non.
+Microphone::Microphone(const __FlashStringHelper *friendlyName, unsigned int ID, HomeAssistant &connection, unsigned int pin, bool connected) : AnalogInput(friendlyName, ID, connection, pin, connected), m_samples(), m_sampleIndex(0), m_consumersNumber(0), m_levelsPosition(0), m_bias(512UL << 10), m_envelope(0), m_averageLevel(0) {}
+
+/// @brief Initialise l'objet. L'échantillonnage en continu ne démarre que si un utilisateur l'a déjà demandé.
+void Microphone::setup()
+{
+    if (m_operational)
+        return;
+
+    AnalogInput::setup();
+    sampledMicrophone = this;
+
+    if (m_consumersNumber > 0)
+        this->startConversions();
+}
+
+/// @brief Boucle d'exécution des tâches liées au microphone : met à jour la composante continue et l'enveloppe avec les échantillons reçus tant que l'échantillonnage est actif.
+void Microphone::loop()
+{
+    AnalogInput::loop();
+
+    if (m_operational && m_consumersNumber > 0)
+        this->updateLevels();
+}
+
+/// @brief Méthode permettant de récupérer le dernier échantillon du microphone, ou une lecture analogique si l'échantillonnage est arrêté.
+/// @return Le dernier échantillon brut, de `0` à `1023`.
+unsigned int Microphone::getValue()
+{
+    if (!m_operational || m_consumersNumber == 0)
+        return AnalogInput::getValue();
+
+    noInterrupts();
+    m_value = m_samples[(m_sampleIndex - 1) & (MICROPHONE_BUFFER_SIZE - 1)];
+    interrupts();
+
+    return m_value;
+}
+
+/// @brief Ajoute un utilisateur de l'échantillonnage en continu. Le convertisseur démarre avec le premier utilisateur.
+void Microphone::startSampling()
+{
+    m_consumersNumber++;
+
+    if (m_consumersNumber == 1 && m_operational)
+        this->startConversions();
+}
+
+/// @brief Retire un utilisateur de l'échantillonnage en continu. Le convertisseur s'arrête avec le dernier utilisateur : l'interruption ne coûte plus rien aux autres tâches.
+void Microphone::stopSampling()
+{
+    if (m_consumersNumber == 0)
+        return;
+
+    m_consumersNumber--;
+
+    if (m_consumersNumber == 0)
+        ADCSRA &= ~(_BV(ADATE) | _BV(ADIE));
+}
+
+/// @brief Méthode permettant de savoir si l'échantillonnage en continu est actif.
+/// @return `true` si au moins un utilisateur a demandé l'échantillonnage.
+bool Microphone::isSampling() const
+{
+    return m_consumersNumber > 0;
+}
+
+/// @brief Méthode permettant d'obtenir l'enveloppe du signal (niveau crête avec une attaque rapide et un relâchement d'environ 100 ms).
+/// @return L'enveloppe, de `0` à `1023`.
+unsigned int Microphone::getEnvelope() const
+{
+    return m_envelope >> 16;
+}
+
+/// @brief Méthode permettant d'obtenir le niveau moyen du signal sur environ une seconde, utilisé comme référence pour la détection des battements.
+/// @return Le niveau moyen, de `0` à `1023`.
+unsigned int Microphone::getAverageLevel() const
+{
+    return m_averageLevel >> 16;
+}
+
+/// @brief Méthode permettant d'obtenir une position de lecture à partir de laquelle seuls les prochains échantillons seront lus.
+/// @return La position du prochain échantillon.
+unsigned int Microphone::getSamplePosition() const
+{
+    noInterrupts();
+    unsigned int sampleIndex = m_sampleIndex;
+    interrupts();
+
+    return sampleIndex;
+}
+
+/// @brief Méthode permettant d'estimer l'instant d'enregistrement d'un échantillon : le dernier échantillon a été enregistré il y a moins d'une période d'échantillonnage, et les précédents sont espacés d'une période.
+/// @param position La position de l'échantillon, parmi les `MICROPHONE_BUFFER_SIZE` derniers échantillons ou peu avant.
+/// @return L'instant d'enregistrement de l'échantillon, en millisecondes.
+unsigned long Microphone::getSampleTime(unsigned int position) const
+{
+    noInterrupts();
+    unsigned int sampleIndex = m_sampleIndex;
+    unsigned long time = millis();
+    interrupts();
+
+    return time - ((unsigned long)(sampleIndex - 1 - position) * 1000UL) / MICROPHONE_SAMPLE_RATE;
+}
+
+/// @brief Copie les échantillons reçus depuis la dernière lecture. Chaque utilisateur conserve sa propre position de lecture, ce qui permet plusieurs lecteurs indépendants.
+/// @param buffer Le tableau recevant les échantillons centrés sur zéro.
+/// @param samplesNumber Le nombre maximal d'échantillons à copier.
+/// @param position La position de lecture de l'utilisateur, mise à jour par la méthode. Si l'utilisateur a pris trop de retard, les échantillons écrasés sont ignorés.
+/// @return Le nombre d'échantillons copiés.
+unsigned int Microphone::readSamples(int *buffer, unsigned int samplesNumber, unsigned int &position) const
+{
+    unsigned int sampleIndex = this->getSamplePosition();
+    unsigned int available = sampleIndex - position;
+
+    if (available > MICROPHONE_BUFFER_SIZE)
+    {
+        position = sampleIndex - MICROPHONE_BUFFER_SIZE;
+        available = MICROPHONE_BUFFER_SIZE;
+    }
+
+    if (available > samplesNumber)
+        available = samplesNumber;
+
+    int bias = m_bias >> 10;
+
+    for (unsigned int i = 0; i < available; i++)
+        buffer[i] = int(m_samples[(position + i) & (MICROPHONE_BUFFER_SIZE - 1)]) - bias;
+
+    position += available;
+    return available;
+}
+
+/// @brief Arrête l'échantillonnage en continu avant l'arrêt du système.
+void Microphone::shutdown()
+{
+    ADCSRA &= ~(_BV(ADATE) | _BV(ADIE));
+    sampledMicrophone = nullptr;
+
+    AnalogInput::shutdown();
+}
+
+/// @brief Enregistre un échantillon dans le tampon circulaire depuis l'interruption du convertisseur. Aucun calcul n'est fait dans l'interruption.
+/// @param sample L'échantillon brut, de `0` à `1023`.
+void Microphone::storeSample(unsigned int sample)
+{
+    m_samples[m_sampleIndex & (MICROPHONE_BUFFER_SIZE - 1)] = sample;
+    m_sampleIndex++;
+}
+
+/// @brief Démarre le convertisseur en mode continu sur la broche du microphone. Les échantillons enregistrés avant l'arrêt précédent sont ignorés par le suivi d'enveloppe.
+void Microphone::startConversions()
+{
+    uint8_t channel = (m_pin >= A0) ? (m_pin - A0) : m_pin;
+    m_levelsPosition = this->getSamplePosition();
+
+    // Mode continu (source de déclenchement nulle), référence AVcc, horloge du convertisseur à 125 kHz.
+    ADCSRA = 0;
+    ADCSRB = (channel >= 8) ? _BV(MUX5) : 0;
+    ADMUX = _BV(REFS0) | (channel & 0x07);
+    ADCSRA = _BV(ADEN) | _BV(ADSC) | _BV(ADATE) | _BV(ADIE) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+}
+
+/// @brief Traite les échantillons reçus depuis le dernier appel : suppression de la composante continue et suivi d'enveloppe en virgule fixe. Si la boucle a pris plus de `MICROPHONE_BUFFER_SIZE` échantillons de retard (environ 13 ms), les échantillons écrasés sont ignorés.
+void Microphone::updateLevels()
+{
+    unsigned int sampleIndex = this->getSamplePosition();
+
+    if ((sampleIndex - m_levelsPosition) > MICROPHONE_BUFFER_SIZE)
+        m_levelsPosition = sampleIndex - MICROPHONE_BUFFER_SIZE;
+
+    while (m_levelsPosition != sampleIndex)
+    {
+        unsigned int sample = m_samples[m_levelsPosition & (MICROPHONE_BUFFER_SIZE - 1)];
+        m_levelsPosition++;
+
+        // La composante continue est suivie par un filtre passe-bas (constante de temps de 1024 échantillons, environ 100 ms).
+        m_bias += sample;
+        m_bias -= m_bias >> 10;
+        int centered = int(sample) - int(m_bias >> 10);
+
+        // Enveloppe crête (format 16.16) : attaque sur 4 échantillons, relâchement sur 1024 échantillons.
+        unsigned long level = (unsigned long)abs(centered) << 16;
+
+        if (level > m_envelope)
+            m_envelope += (level - m_envelope) >> 2;
+
+        else
+            m_envelope -= (m_envelope - level) >> 10;
+
+        // Niveau moyen de l'enveloppe sur 8192 échantillons (environ 850 ms).
+        if (m_envelope > m_averageLevel)
+            m_averageLevel += (m_envelope - m_averageLevel) >> 13;
+
+        else
+            m_averageLevel -= (m_averageLevel - m_envelope) >> 13;
+    }
+}
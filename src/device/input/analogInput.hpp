@@ -19,10 +19,51 @@ public:
     virtual unsigned int getValue();
 
 protected:
+    static unsigned int readPin(unsigned int pin);
+
     unsigned int m_value;
     const unsigned int m_pin;
     bool m_connected;
     unsigned long m_lastTime;
 };
 
+// Fréquence d'échantillonnage du microphone en mode continu (16 MHz / 128 / 13 cycles par conversion).
+#define MICROPHONE_SAMPLE_RATE 9615
+
+// Taille du tampon circulaire des échantillons (doit être une puissance de deux).
+#define MICROPHONE_BUFFER_SIZE 128
+
+/// @brief Classe représentant un microphone échantillonné en continu par interruption, avec un suivi d'enveloppe du signal.
+/// L'échantillonnage ne fonctionne que tant qu'au moins un utilisateur l'a demandé (`startSampling()`). L'interruption se limite à l'écriture du tampon circulaire : la composante continue et l'enveloppe sont calculées dans la boucle.
+class Microphone : public AnalogInput
+{
+public:
+    Microphone(const __FlashStringHelper *friendlyName, unsigned int ID, HomeAssistant &connection, unsigned int pin, bool connected);
+    virtual void setup() override;
+    virtual void loop() override;
+    virtual unsigned int getValue() override;
+    virtual void startSampling();
+    virtual void stopSampling();
+    virtual bool isSampling() const;
+    virtual unsigned int getEnvelope() const;
+    virtual unsigned int getAverageLevel() const;
+    virtual unsigned int getSamplePosition() const;
+    virtual unsigned long getSampleTime(unsigned int position) const;
+    virtual unsigned int readSamples(int *buffer, unsigned int samplesNumber, unsigned int &position) const;
+    virtual void shutdown() override;
+    void storeSample(unsigned int sample);
+
+protected:
+    void startConversions();
+    void updateLevels();
+
+    volatile unsigned int m_samples[MICROPHONE_BUFFER_SIZE];
+    volatile unsigned int m_sampleIndex;
+    unsigned int m_consumersNumber;
+    unsigned int m_levelsPosition;
+    unsigned long m_bias;
+    unsigned long m_envelope;
+    unsigned long m_averageLevel;
+};
+
 #endif
\ No newline at end of file
@@ -26,7 +26,7 @@
 /// @param ID L'identifiant unique du périphérique utilisé pour communiquer avec Home Assistant.
 /// @param serial Le port série utilisé pour la communication entre l'Arduino et l'ESP.
 /// @param display L'écran utilisé par le système de domotique.
-HomeAssistant::HomeAssistant(const __FlashStringHelper *friendlyName, unsigned int ID, HardwareSerial &serial, Display &display) : Device(friendlyName, ID), m_serial(serial), m_display(display), m_deviceList(nullptr), m_devicesNumber(0), m_inputDeviceList(nullptr), m_inputDevicesNumber(0), m_remoteDeviceList(nullptr), m_remoteDevicesNumber(0), m_colorModeList(nullptr), m_rainbowModeList(nullptr), m_soundreactModeList(nullptr), m_alarmModeList(nullptr), m_RGBLEDStripModesNumber(0), m_initialisationFinishTime(0) {}
+HomeAssistant::HomeAssistant(const __FlashStringHelper *friendlyName, unsigned int ID, HardwareSerial &serial, Display &display) : Device(friendlyName, ID), m_serial(serial), m_display(display), m_deviceList(nullptr), m_devicesNumber(0), m_inputDeviceList(nullptr), m_inputDevicesNumber(0), m_remoteDeviceList(nullptr), m_remoteDevicesNumber(0), m_colorModeList(nullptr), m_rainbowModeList(nullptr), m_soundreactModeList(nullptr), m_alarmModeList(nullptr), m_spectrumModeList(nullptr), m_RGBLEDStripModesNumber(0), m_initialisationFinishTime(0) {}
 
 /// @brief Initialise la liste des périphériques connectés.
 /// @param deviceList La liste des périphériques de sortie du système de domotique connectés à Home Assistant.
@@ -40,7 +40,7 @@ HomeAssistant::HomeAssistant(const __FlashStringHelper *friendlyName, unsigned i
 /// @param soundreactMode La liste de modes de son-réaction utilisés pour les rubans de DEL.
 /// @param alarmMode La liste de modes des alarmes utilisés pour les rubans de DEL.
 /// @param RGBLEDStripModesNumber Le nombre de modes dans chaque liste (correspondant au nombre de ruban de DEL RVB donné dans `deviceList`).
-void HomeAssistant::setDevices(Output *deviceList[], int &devicesNumber, Input *inputDeviceList[], int &inputDevicesNumber, ConnectedOutput *remoteDeviceList[], int &remoteDevicesNumber, RGBLEDStripMode *colorModeList[], RGBLEDStripMode *rainbowModeList[], RGBLEDStripMode *soundreactModeList[], RGBLEDStripMode *alarmModeList[], int &RGBLEDStripModesNumber)
+void HomeAssistant::setDevices(Output *deviceList[], int &devicesNumber, Input *inputDeviceList[], int &inputDevicesNumber, ConnectedOutput *remoteDeviceList[], int &remoteDevicesNumber, RGBLEDStripMode *colorModeList[], RGBLEDStripMode *rainbowModeList[], RGBLEDStripMode *soundreactModeList[], RGBLEDStripMode *alarmModeList[], RGBLEDStripMode *spectrumModeList[], int &RGBLEDStripModesNumber)
 {
     m_deviceList = deviceList;
     m_devicesNumber = devicesNumber;
@@ -55,6 +55,7 @@ void HomeAssistant::setDevices(Output *deviceList[], int &devicesNumber, Input *
     m_rainbowModeList = rainbowModeList;
     m_soundreactModeList = soundreactModeList;
     m_alarmModeList = alarmModeList;
+    m_spectrumModeList = spectrumModeList;
     m_RGBLEDStripModesNumber = RGBLEDStripModesNumber;
 }
 
@@ -424,6 +425,20 @@ void HomeAssistant::playVideo(String videoURL)
     m_serial.println(videoURL);
 }
 
+/// @brief Méthode permettant de demander à l'ESP les actions suivantes d'une musique diffusée (méthode à utiliser uniquement par la classe de la télévision).
+/// @param ID L'identifiant unique de la télévision.
+/// @param streamNumber Le numéro de la musique sur l'ESP.
+/// @param firstIndex La position de la première action demandée.
+/// @param actionsNumber Le nombre d'actions demandées, qui correspond à la place libre dans la mémoire tampon de la télévision.
+void HomeAssistant::requestMusicActions(unsigned int ID, unsigned int streamNumber, unsigned int firstIndex, unsigned int actionsNumber)
+{
+    m_serial.print(5);
+    m_serial.print(this->addZeros(ID, 2));
+    m_serial.print(this->addZeros(streamNumber, 2));
+    m_serial.print(this->addZeros(firstIndex, 4));
+    m_serial.println(this->addZeros(actionsNumber, 2));
+}
+
 /// @brief Méthode permettant d'éteidre l'alimentation du système de domotique.
 /// @param restart Redémarre ou non l'alimentation quelques secondes plus tard.
 void HomeAssistant::stopSystem(bool restart)
@@ -505,6 +520,12 @@ void HomeAssistant::processMessage()
                 strip->setMode(static_cast<RGBLEDStripMode *>(this->getRGBLEDStripModeFromID(strip->getID(), m_alarmModeList)), true);
                 break;
             }
+
+            case 5:
+            {
+                strip->setMode(static_cast<RGBLEDStripMode *>(this->getRGBLEDStripModeFromID(strip->getID(), m_spectrumModeList)), true);
+                break;
+            }
             }
 
             break;
@@ -567,6 +588,22 @@ void HomeAssistant::processMessage()
             case 4:
                 television->toggleMute(true);
                 break;
+
+            // Réception d'une action d'une musique diffusée : position (4 chiffres), moment en ms (8 chiffres) puis l'action. Une trame tronquée ou mal formée est ignorée (elle sera demandée à nouveau).
+            case 5:
+                if (m_receivedMessage.length() <= 18 || !this->isNumber(m_receivedMessage, 6, 12))
+                    break;
+
+                television->receiveMusicAction(this->getIntFromString(m_receivedMessage, 6, 4), m_receivedMessage.substring(10, 18).toInt(), m_receivedMessage.c_str() + 18);
+                break;
+
+            // Fin d'une musique diffusée : nombre total d'actions (4 chiffres).
+            case 6:
+                if (m_receivedMessage.length() < 10 || !this->isNumber(m_receivedMessage, 6, 4))
+                    break;
+
+                television->receiveMusicEnd(this->getIntFromString(m_receivedMessage, 6, 4));
+                break;
             }
 
             break;
@@ -790,4 +827,23 @@ int HomeAssistant::getIntFromString(const String &string, int position, int leng
     }
 
     return result;
+}
+
+/// @brief Méthode permettant de vérifier qu'une partie d'une chaîne de caractères ne contient que des chiffres.
+/// @param string La chaîne de caractères à vérifier.
+/// @param position La position du premier caractère à vérifier.
+/// @param length Le nombre de caractères à vérifier.
+/// @return `true` si la partie existe et ne contient que des chiffres.
+bool HomeAssistant::isNumber(const String &string, int position, int length)
+{
+    if ((unsigned int)(position + length) > string.length())
+        return false;
+
+    for (int i = position; i < (position + length); i++)
+    {
+        if (!isDigit(string.charAt(i)))
+            return false;
+    }
+
+    return true;
 }
\ No newline at end of file
@@ -14,6 +14,7 @@ class ColorMode;
 class RainbowMode;
 class SoundreactMode;
 class AlarmMode;
+class SpectrumMode;
 class RGBLEDStrip;
 class RGBLEDStripMode;
 class Alarm;
@@ -28,7 +29,7 @@ class HomeAssistant : public Device
 {
 public:
     HomeAssistant(const __FlashStringHelper *friendlyName, unsigned int ID, HardwareSerial &serial, Display &display);
-    virtual void setDevices(Output *deviceList[], int &devicesNumber, Input *inputDeviceList[], int &inputDevicesNumber, ConnectedOutput *remoteDeviceList[], int &remoteDevicesNumber, RGBLEDStripMode *colorModeList[], RGBLEDStripMode *rainbowModeList[], RGBLEDStripMode *soundreactModeList[], RGBLEDStripMode *alarmModeList[], int &RGBLEDStripModesNumber);
+    virtual void setDevices(Output *deviceList[], int &devicesNumber, Input *inputDeviceList[], int &inputDevicesNumber, ConnectedOutput *remoteDeviceList[], int &remoteDevicesNumber, RGBLEDStripMode *colorModeList[], RGBLEDStripMode *rainbowModeList[], RGBLEDStripMode *soundreactModeList[], RGBLEDStripMode *alarmModeList[], RGBLEDStripMode *spectrumModeList[], int &RGBLEDStripModesNumber);
     virtual void setup() override;
     virtual void loop() override;
     virtual void turnOnConnectedDevice(unsigned int ID);
@@ -52,6 +53,7 @@ public:
     virtual void updateAirSensor(unsigned int ID, float temperature, float humidity);
     virtual void sayMessage(String message);
     virtual void playVideo(String videoURL);
+    virtual void requestMusicActions(unsigned int ID, unsigned int streamNumber, unsigned int firstIndex, unsigned int actionsNumber);
     virtual void stopSystem(bool restart = false);
 
 protected:
@@ -61,6 +63,7 @@ protected:
     virtual RGBLEDStripMode *getRGBLEDStripModeFromID(unsigned int ID, RGBLEDStripMode **list);
     static String addZeros(int number, int length);
     static int getIntFromString(const String &string, int position, int lenght);
+    static bool isNumber(const String &string, int position, int length);
     HardwareSerial &m_serial;
     String m_receivedMessage;
     Display &m_display;
@@ -74,6 +77,7 @@ protected:
     RGBLEDStripMode **m_rainbowModeList;
     RGBLEDStripMode **m_soundreactModeList;
     RGBLEDStripMode **m_alarmModeList;
+    RGBLEDStripMode **m_spectrumModeList;
     int m_RGBLEDStripModesNumber;
     unsigned long m_initialisationFinishTime;
 };
@@ -9,22 +9,1209 @@
 // Ajout des bibilothèques au programme.
 #include <Arduino.h>
 #include <Adafruit_SSD1306.h>
+#include <util/crc16.h>
 
 // Autres fichiers du programme.
 #include "display.hpp"
 #include "device/device.hpp"
 #include "bitmaps.hpp"
-#include "device/output/television.hpp"
-#include "utils/readPROGMEMString.hpp"
+#include "utils/musicActions.hpp"
+
+// Glyphes de la page de code 437 correspondant aux caractères Latin-1 de U+00A0 à U+00FF. Les lettres sans équivalent sont remplacées par leur version sans accent.
+static const uint8_t latin1Glyphs[] PROGMEM = {
+    0xFF, 0xAD, 0x9B, 0x9C, '?', 0x9D, '|', 0x15, '"', 'c', 0xA6, 0xAE, 0xAA, '-', 'R', '-',   // U+00A0 à U+00AF
+    0xF8, 0xF1, 0xFD, '3', '\'', 0xE6, 0x14, 0xFA, ',', '1', 0xA7, 0xAF, 0xAC, 0xAB, '?', 0xA8, // U+00B0 à U+00BF
+    'A', 'A', 'A', 'A', 0x8E, 0x8F, 0x92, 0x80, 'E', 0x90, 'E', 'E', 'I', 'I', 'I', 'I',        // U+00C0 à U+00CF
+    'D', 0xA5, 'O', 'O', 'O', 'O', 0x99, 'x', 'O', 'U', 'U', 'U', 0x9A, 'Y', '?', 0xE1,         // U+00D0 à U+00DF
+    0x85, 0xA0, 0x83, 'a', 0x84, 0x86, 0x91, 0x87, 0x8A, 0x82, 0x88, 0x89, 0x8D, 0xA1, 0x8C, 0x8B, // U+00E0 à U+00EF
+    'd', 0xA4, 0x95, 0xA2, 0x93, 'o', 0x94, 0xF6, 'o', 0x97, 0xA3, 0x96, 0x81, 'y', '?', 0x98,   // U+00F0 à U+00FF
+};
+
+/// @brief Constructeur de la classe.
+UTF8Decoder::UTF8Decoder() : m_codePoint(0), m_remainingBytes(0) {}
+
+/// @brief Ajoute un octet au caractère en cours de décodage. Une séquence interrompue est ignorée, un octet invalide est remplacé par `UTF8_UNKNOWN_GLYPH`.
+/// @param byte L'octet suivant du texte.
+/// @param glyph Le glyphe du caractère complété par l'octet.
+/// @return `true` si l'octet termine un caractère (`glyph` est alors renseigné).
+bool UTF8Decoder::decode(uint8_t byte, uint8_t &glyph)
+{
+    // Caractère ASCII.
+    if (byte < 0x80)
+    {
+        m_remainingBytes = 0;
+        glyph = byte;
+        return true;
+    }
+
+    // Octet de continuation.
+    if ((byte & 0xC0) == 0x80)
+    {
+        if (m_remainingBytes == 0)
+        {
+            glyph = UTF8_UNKNOWN_GLYPH;
+            return true;
+        }
+
+        m_codePoint = (m_codePoint << 6) | (byte & 0x3F);
+        m_remainingBytes--;
+
+        if (m_remainingBytes > 0)
+            return false;
+
+        glyph = getGlyph(m_codePoint);
+        return true;
+    }
+
+    // Premier octet d'un caractère sur 2, 3 ou 4 octets.
+    if ((byte & 0xE0) == 0xC0)
+    {
+        m_codePoint = byte & 0x1F;
+        m_remainingBytes = 1;
+    }
+
+    else if ((byte & 0xF0) == 0xE0)
+    {
+        m_codePoint = byte & 0x0F;
+        m_remainingBytes = 2;
+    }
+
+    else if ((byte & 0xF8) == 0xF0)
+    {
+        m_codePoint = byte & 0x07;
+        m_remainingBytes = 3;
+    }
+
+    else
+    {
+        m_remainingBytes = 0;
+        glyph = UTF8_UNKNOWN_GLYPH;
+        return true;
+    }
+
+    return false;
+}
+
+/// @brief Convertit un point de code Unicode en glyphe de la police de l'écran.
+/// @param codePoint Le point de code à convertir.
+/// @return Le glyphe correspondant, ou `UTF8_UNKNOWN_GLYPH` si la police ne contient pas de caractère équivalent.
+uint8_t UTF8Decoder::getGlyph(unsigned long codePoint)
+{
+    if (codePoint < 0x80)
+        return codePoint;
+
+    if (codePoint >= UTF8_LATIN1_FIRST_CODE_POINT && codePoint <= 0xFF)
+        return pgm_read_byte(&latin1Glyphs[codePoint - UTF8_LATIN1_FIRST_CODE_POINT]);
+
+    // Apostrophes et guillemets typographiques.
+    if (codePoint == 0x2018 || codePoint == 0x2019)
+        return '\'';
+
+    if (codePoint == 0x201C || codePoint == 0x201D)
+        return '"';
+
+    return UTF8_UNKNOWN_GLYPH;
+}
+
+/// @brief Constructeur de la classe.
+/// @param width La largeur de l'écran en pixels (128 au maximum).
+/// @param height La hauteur de l'écran en pixels (64 au maximum).
+/// @param twi Le bus I2C de l'écran.
+/// @param resetPin La broche de réinitialisation de l'écran (`-1` si elle n'est pas utilisée).
+SSD1306PartialDisplay::SSD1306PartialDisplay(uint8_t width, uint8_t height, TwoWire *twi, int8_t resetPin) : Adafruit_SSD1306(width, height, twi, resetPin), m_dirtyBlocks(), m_contentBlocks(), m_blockChecksums(), m_fullRefresh(true), m_transferredBytes(0), m_flushPending(false), m_flushRequested(false), m_transferError(false), m_flushPage(0), m_flushBlock(0), m_transferState(TRANSFER_IDLE), m_transaction(0), m_position(0), m_regionCommands(), m_regionData(), m_regionDataLength(0), m_startPage(0), m_stateTime(0) {}
+
+/// @brief Dessine un pixel dans la mémoire tampon et marque son bloc comme modifié.
+void SSD1306PartialDisplay::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    this->markDirty(x, y, 1, 1);
+    Adafruit_SSD1306::drawPixel(x, y, color);
+}
+
+/// @brief Dessine une ligne horizontale dans la mémoire tampon et marque ses blocs comme modifiés.
+void SSD1306PartialDisplay::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    this->markDirty(x, y, w, 1);
+    Adafruit_SSD1306::drawFastHLine(x, y, w, color);
+}
+
+/// @brief Dessine une ligne verticale dans la mémoire tampon et marque ses blocs comme modifiés.
+void SSD1306PartialDisplay::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    this->markDirty(x, y, 1, h);
+    Adafruit_SSD1306::drawFastVLine(x, y, h, color);
+}
+
+/// @brief Efface la mémoire tampon : seuls les blocs qui avaient un contenu sont marqués comme modifiés.
+void SSD1306PartialDisplay::clearDisplay()
+{
+    for (uint8_t page = 0; page < SSD1306_PAGES_NUMBER; page++)
+    {
+        m_dirtyBlocks[page] |= m_contentBlocks[page];
+        m_contentBlocks[page] = 0;
+    }
+
+    Adafruit_SSD1306::clearDisplay();
+}
+
+/// @brief Décompresse un pictogramme plein écran au format PackBits (voir `bitmaps.hpp`) directement dans la mémoire tampon. Les octets sont déjà dans l'ordre de l'écran : les suites d'octets vides sont simplement sautées, et seuls les blocs contenant des pixels sont marqués comme modifiés.
+/// @param bitmap Le pictogramme compressé, stocké dans la mémoire flash.
+/// @param color La couleur des pixels allumés du pictogramme (`WHITE`, `BLACK` ou `INVERSE`).
+void SSD1306PartialDisplay::drawCompressedBitmap(const uint8_t *bitmap, uint16_t color)
+{
+    unsigned int size = width() * (height() / 8);
+    unsigned int position = 0;
+
+    while (position < size)
+    {
+        uint8_t header = pgm_read_byte(bitmap++);
+        if (header == 128)
+            continue;
+
+        bool repeated = header > 128;
+        unsigned int length = repeated ? (257 - header) : (header + 1);
+        uint8_t value = repeated ? pgm_read_byte(bitmap++) : 0;
+
+        if (length > (size - position))
+            length = size - position;
+
+        for (unsigned int i = 0; i < length; i++, position++)
+        {
+            uint8_t byte = repeated ? value : pgm_read_byte(bitmap++);
+            if (byte == 0)
+                continue;
+
+            uint8_t page = position / width();
+            uint8_t block = 1 << ((position % width()) / SSD1306_BLOCK_WIDTH);
+            m_dirtyBlocks[page] |= block;
+            m_contentBlocks[page] |= block;
+
+            if (color == SSD1306_WHITE)
+                buffer[position] |= byte;
+
+            else if (color == SSD1306_BLACK)
+                buffer[position] &= ~byte;
+
+            else if (color == SSD1306_INVERSE)
+                buffer[position] ^= byte;
+        }
+    }
+}
+
+/// @brief Inverse les couleurs de l'écran. La commande passe par la bibliothèque Wire : l'affichage en cours est terminé avant.
+/// @param inverted `true` pour inverser les couleurs.
+void SSD1306PartialDisplay::invertDisplay(bool inverted)
+{
+    this->waitForFlush();
+    Adafruit_SSD1306::invertDisplay(inverted);
+    m_transferredBytes += 2;
+}
+
+/// @brief Réduit la luminosité de l'écran. La commande passe par la bibliothèque Wire : l'affichage en cours est terminé avant.
+/// @param dimmed `true` pour réduire la luminosité.
+void SSD1306PartialDisplay::dim(bool dimmed)
+{
+    this->waitForFlush();
+    Adafruit_SSD1306::dim(dimmed);
+
+    // La bibliothèque envoie la commande et son paramètre dans deux transactions séparées.
+    m_transferredBytes += 4;
+}
+
+/// @brief Marque une zone de la mémoire tampon comme modifiée.
+/// @param x La colonne du coin supérieur gauche.
+/// @param y La ligne du coin supérieur gauche.
+/// @param w La largeur de la zone.
+/// @param h La hauteur de la zone.
+void SSD1306PartialDisplay::markDirty(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    // Découpage de la zone aux limites de l'écran.
+    if (x < 0)
+    {
+        w += x;
+        x = 0;
+    }
+
+    if (y < 0)
+    {
+        h += y;
+        y = 0;
+    }
+
+    if (x + w > width())
+        w = width() - x;
+
+    if (y + h > height())
+        h = height() - y;
+
+    if (w <= 0 || h <= 0)
+        return;
+
+    uint8_t firstBlock = x / SSD1306_BLOCK_WIDTH;
+    uint8_t lastBlock = (x + w - 1) / SSD1306_BLOCK_WIDTH;
+    uint8_t blocks = (0xFF >> (7 - (lastBlock - firstBlock))) << firstBlock;
+
+    for (uint8_t page = y / 8; page <= (y + h - 1) / 8; page++)
+    {
+        m_dirtyBlocks[page] |= blocks;
+        m_contentBlocks[page] |= blocks;
+    }
+}
+
+/// @brief Demande l'envoi à l'écran des blocs modifiés. L'envoi est effectué en arrière-plan par `update()` ; s'il est déjà en cours, un nouveau parcours sera effectué à la fin du parcours actuel.
+void SSD1306PartialDisplay::display()
+{
+    if (wire == nullptr)
+    {
+        Adafruit_SSD1306::display();
+        return;
+    }
+
+    if (m_flushPending)
+    {
+        m_flushRequested = true;
+        return;
+    }
+
+#if ARDUINO >= 157
+    wire->setClock(wireClk);
+#endif
+
+    m_flushPending = true;
+    m_flushPage = 0;
+    m_flushBlock = 0;
+}
+
+/// @brief Envoie immédiatement à l'écran les blocs modifiés, en attendant la fin de l'envoi (pour les animations bloquantes).
+void SSD1306PartialDisplay::displayNow()
+{
+    this->display();
+    this->waitForFlush();
+}
+
+/// @brief Fait avancer l'envoi en arrière-plan pendant une durée limitée. Le bus I2C est piloté directement, sans interruption, pour ne pas bloquer la boucle dans la bibliothèque Wire.
+/// @param budget La durée maximale passée dans la méthode, en microsecondes.
+/// @return `true` si un envoi est encore en cours.
+bool SSD1306PartialDisplay::update(unsigned int budget)
+{
+    if (!m_flushPending)
+        return false;
+
+    unsigned long startTime = micros();
+
+    do
+    {
+        if (m_transferState == TRANSFER_IDLE && !this->startRegion())
+        {
+            // Un affichage demandé pendant le parcours relance un parcours complet.
+            if (m_flushRequested)
+            {
+                m_flushRequested = false;
+                m_flushPage = 0;
+                m_flushBlock = 0;
+                continue;
+            }
+
+            // Après une erreur de transmission, le prochain affichage renverra tout l'écran.
+            m_fullRefresh = m_transferError;
+            m_transferError = false;
+            m_flushPending = false;
+
+            // Le bus est rendu à la bibliothèque Wire dans l'état où elle l'a initialisé.
+            TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWEA);
+#if ARDUINO >= 157
+            wire->setClock(restoreClk);
+#endif
+
+            return false;
+        }
+
+        this->stepTransfer();
+    } while ((micros() - startTime) < budget);
+
+    return true;
+}
+
+/// @brief Méthode permettant de savoir si un envoi est en cours.
+/// @return `true` si des blocs restent à envoyer.
+bool SSD1306PartialDisplay::isFlushPending() const
+{
+    return m_flushPending;
+}
+
+/// @brief Termine l'envoi en cours de manière bloquante.
+void SSD1306PartialDisplay::waitForFlush()
+{
+    while (this->update(1000))
+        ;
+}
+
+/// @brief Fait défiler le contenu de l'écran d'une page (8 lignes) vers le haut en déplaçant la ligne de départ matérielle, sans renvoyer de données : la page sortant en haut réapparaît en bas. Les sommes de contrôle suivent le défilement, donc le prochain affichage n'envoie que les blocs qui diffèrent du contenu décalé (en général la ligne entrante). L'envoi en cours est terminé avant.
+void SSD1306PartialDisplay::scrollPage()
+{
+    this->waitForFlush();
+
+    m_startPage = (m_startPage + 1) % SSD1306_PAGES_NUMBER;
+    ssd1306_command(SSD1306_SETSTARTLINE | (m_startPage * 8));
+    m_transferredBytes += 2;
+
+    uint8_t pagesNumber = height() / 8;
+    uint16_t firstChecksums[SSD1306_BLOCKS_NUMBER];
+    memcpy(firstChecksums, m_blockChecksums[0], sizeof(firstChecksums));
+    memmove(m_blockChecksums[0], m_blockChecksums[1], (pagesNumber - 1) * sizeof(m_blockChecksums[0]));
+    memcpy(m_blockChecksums[pagesNumber - 1], firstChecksums, sizeof(firstChecksums));
+
+    // Tous les blocs sont comparés au prochain affichage, puisque le contenu de chaque page de l'écran a changé.
+    memset(m_dirtyBlocks, 0xFF, sizeof(m_dirtyBlocks));
+
+    // Sur un écran de moins de 64 lignes, la page entrante n'était pas affichée : son contenu est inconnu.
+    if (pagesNumber < SSD1306_PAGES_NUMBER)
+        m_fullRefresh = true;
+}
+
+/// @brief Méthode permettant de connaître le nombre d'octets envoyés à l'écran depuis le démarrage, commandes d'adressage comprises.
+/// @return Le nombre d'octets envoyés.
+unsigned long SSD1306PartialDisplay::getTransferredBytes() const
+{
+    return m_transferredBytes;
+}
+
+/// @brief La mémoire tampon complète ne limite pas le nombre de dessins : aucun n'est jamais ignoré.
+/// @return `0`.
+unsigned long SSD1306PartialDisplay::getDroppedDrawings() const
+{
+    return 0;
+}
+
+/// @brief Cherche la prochaine suite de blocs modifiés d'une page et la copie dans le tampon d'envoi : un dessin effectué pendant l'envoi ne modifie donc pas les données en cours de transmission, et marque à nouveau son bloc pour le prochain affichage.
+/// @return `false` si tous les blocs ont été parcourus.
+bool SSD1306PartialDisplay::startRegion()
+{
+    uint8_t blocksNumber = width() / SSD1306_BLOCK_WIDTH;
+
+    while (m_flushPage < (height() / 8))
+    {
+        while (m_flushBlock < blocksNumber)
+        {
+            if (!this->isBlockChanged(m_flushPage, m_flushBlock))
+            {
+                m_flushBlock++;
+                continue;
+            }
+
+            // Les blocs modifiés voisins sont regroupés dans une seule région.
+            uint8_t firstBlock = m_flushBlock;
+            m_flushBlock++;
+
+            while (m_flushBlock < blocksNumber && this->isBlockChanged(m_flushPage, m_flushBlock))
+                m_flushBlock++;
+
+            uint8_t firstColumn = firstBlock * SSD1306_BLOCK_WIDTH;
+            uint8_t lastColumn = (m_flushBlock * SSD1306_BLOCK_WIDTH) - 1;
+
+            m_regionCommands[0] = 0x00;
+            m_regionCommands[1] = SSD1306_PAGEADDR;
+            m_regionCommands[2] = (m_flushPage + m_startPage) % SSD1306_PAGES_NUMBER;
+            m_regionCommands[3] = m_regionCommands[2];
+            m_regionCommands[4] = SSD1306_COLUMNADDR;
+            m_regionCommands[5] = firstColumn;
+            m_regionCommands[6] = lastColumn;
+
+            m_regionDataLength = lastColumn - firstColumn + 2;
+            m_regionData[0] = 0x40;
+            memcpy(&m_regionData[1], buffer + (m_flushPage * width()) + firstColumn, m_regionDataLength - 1);
+
+            m_transferredBytes += sizeof(m_regionCommands) + m_regionDataLength;
+            m_transaction = 0;
+            m_position = 0;
+            m_transferState = TRANSFER_BEGIN;
+            m_stateTime = micros();
+            return true;
+        }
+
+        m_flushPage++;
+        m_flushBlock = 0;
+    }
+
+    return false;
+}
+
+/// @brief Détermine si un bloc doit être envoyé : il doit avoir été touché par un dessin et son contenu doit différer de celui déjà envoyé.
+/// @param page La page du bloc.
+/// @param block La position du bloc dans la page.
+/// @return `true` si le bloc doit être envoyé.
+bool SSD1306PartialDisplay::isBlockChanged(uint8_t page, uint8_t block)
+{
+    bool dirty = m_fullRefresh || (m_dirtyBlocks[page] & (1 << block));
+    m_dirtyBlocks[page] &= ~(1 << block);
+
+    if (!dirty)
+        return false;
+
+    uint16_t checksum = this->getBlockChecksum(page, block);
+    if (!m_fullRefresh && checksum == m_blockChecksums[page][block])
+        return false;
+
+    m_blockChecksums[page][block] = checksum;
+    return true;
+}
+
+/// @brief Avance d'une étape l'envoi de la région en cours (commandes d'adressage, puis données), sans jamais attendre le bus.
+void SSD1306PartialDisplay::stepTransfer()
+{
+    const uint8_t *bytes = (m_transaction == 0) ? m_regionCommands : m_regionData;
+    uint8_t length = (m_transaction == 0) ? sizeof(m_regionCommands) : m_regionDataLength;
+
+    switch (m_transferState)
+    {
+    case TRANSFER_BEGIN:
+        if (TWCR & _BV(TWSTO))
+        {
+            this->checkTransferTimeout();
+            return;
+        }
+
+        TWCR = _BV(TWINT) | _BV(TWSTA) | _BV(TWEN);
+        m_transferState = TRANSFER_ADDRESS;
+        break;
+
+    case TRANSFER_ADDRESS:
+        if (!(TWCR & _BV(TWINT)))
+        {
+            this->checkTransferTimeout();
+            return;
+        }
+
+        // Condition de départ (0x08) ou de départ répété (0x10) envoyée.
+        if ((TWSR & 0xF8) != 0x08 && (TWSR & 0xF8) != 0x10)
+        {
+            this->abortTransfer();
+            return;
+        }
+
+        TWDR = i2caddr << 1;
+        TWCR = _BV(TWINT) | _BV(TWEN);
+        m_transferState = TRANSFER_DATA;
+        break;
+
+    case TRANSFER_DATA:
+        if (!(TWCR & _BV(TWINT)))
+        {
+            this->checkTransferTimeout();
+            return;
+        }
+
+        // Adresse (0x18) ou octet (0x28) acquitté par l'écran.
+        if ((TWSR & 0xF8) != 0x18 && (TWSR & 0xF8) != 0x28)
+        {
+            this->abortTransfer();
+            return;
+        }
+
+        if (m_position < length)
+        {
+            TWDR = bytes[m_position++];
+            TWCR = _BV(TWINT) | _BV(TWEN);
+            break;
+        }
+
+        TWCR = _BV(TWINT) | _BV(TWSTO) | _BV(TWEN);
+        m_transferState = TRANSFER_STOP;
+        break;
+
+    case TRANSFER_STOP:
+        if (TWCR & _BV(TWSTO))
+        {
+            this->checkTransferTimeout();
+            return;
+        }
+
+        if (m_transaction == 0)
+        {
+            m_transaction = 1;
+            m_position = 0;
+            m_transferState = TRANSFER_BEGIN;
+        }
+
+        else
+            m_transferState = TRANSFER_IDLE;
+
+        break;
+
+    default:
+        break;
+    }
+
+    // L'étape a avancé : le délai de la suivante part de maintenant.
+    m_stateTime = micros();
+}
+
+/// @brief Abandonne la région en cours après une erreur du bus : la transmission est arrêtée et l'écran complet sera renvoyé au prochain affichage.
+void SSD1306PartialDisplay::abortTransfer()
+{
+    TWCR = _BV(TWINT) | _BV(TWSTO) | _BV(TWEN);
+    m_transferError = true;
+    m_transaction = 1;
+    m_transferState = TRANSFER_STOP;
+    m_stateTime = micros();
+}
+
+/// @brief Vérifie que l'étape en cours n'attend pas le bus depuis trop longtemps. Un bus bloqué (SDA maintenu au niveau bas, arbitrage perdu) ne doit pas bloquer le programme : après `SSD1306_TRANSFER_TIMEOUT`, le module TWI est réinitialisé (comme le fait `Wire.setWireTimeout()`) et le parcours en cours abandonné ; l'écran complet sera renvoyé au prochain affichage.
+void SSD1306PartialDisplay::checkTransferTimeout()
+{
+    if ((micros() - m_stateTime) < SSD1306_TRANSFER_TIMEOUT)
+        return;
+
+    TWCR = 0;
+    TWCR = _BV(TWEN);
+    m_transferError = true;
+    m_transferState = TRANSFER_IDLE;
+    m_flushPage = height() / 8;
+}
+
+/// @brief Calcule une somme de contrôle CRC-16 (CCITT) du contenu d'un bloc de la mémoire tampon. Contrairement à une somme de Fletcher sur 8 bit, elle détecte toujours un pixel déplacé ou jusqu'à trois pixels modifiés : un bloc modifié ne peut pas être pris pour le bloc déjà envoyé.
+/// @param page La page du bloc.
+/// @param block La position du bloc dans la page.
+/// @return La somme de contrôle du bloc.
+uint16_t SSD1306PartialDisplay::getBlockChecksum(uint8_t page, uint8_t block) const
+{
+    const uint8_t *data = buffer + (page * width()) + (block * SSD1306_BLOCK_WIDTH);
+    uint16_t checksum = 0xFFFF;
+
+    for (uint8_t i = 0; i < SSD1306_BLOCK_WIDTH; i++)
+        checksum = _crc_ccitt_update(checksum, data[i]);
+
+    return checksum;
+}
+
+/// @brief Constructeur de la classe. La broche de réinitialisation de l'écran n'est pas gérée (`-1`).
+/// @param width La largeur de l'écran en pixels (128 au maximum).
+/// @param height La hauteur de l'écran en pixels (64 au maximum).
+/// @param twi Le bus I2C de l'écran.
+SSD1306PageDisplay::SSD1306PageDisplay(uint8_t width, uint8_t height, TwoWire *twi, int8_t) : Adafruit_GFX(width, height), m_wire(twi), m_address(0), m_vccState(SSD1306_SWITCHCAPVCC), m_commands(), m_commandsNumber(0), m_text(), m_textLength(0), m_page(), m_renderedPage(0), m_rendering(false), m_blockChecksums(), m_fullRefresh(true), m_transferredBytes(0), m_droppedDrawings(0), m_startPage(0) {}
+
+/// @brief Initialise l'écran (128 × 64) avec la même configuration que la bibliothèque Adafruit.
+/// @param vccState L'alimentation de l'écran (`SSD1306_SWITCHCAPVCC` ou `SSD1306_EXTERNALVCC`).
+/// @param address L'adresse I2C de l'écran.
+/// @return `true` si l'écran a répondu.
+bool SSD1306PageDisplay::begin(uint8_t vccState, uint8_t address)
+{
+    m_vccState = vccState;
+    m_address = address;
+
+    m_wire->begin();
+    m_wire->setClock(400000UL);
+
+    const uint8_t commands[] = {SSD1306_DISPLAYOFF,
+                                SSD1306_SETDISPLAYCLOCKDIV, 0x80,
+                                SSD1306_SETMULTIPLEX, uint8_t(height() - 1),
+                                SSD1306_SETDISPLAYOFFSET, 0x00,
+                                SSD1306_SETSTARTLINE | 0x00,
+                                SSD1306_CHARGEPUMP, uint8_t((vccState == SSD1306_EXTERNALVCC) ? 0x10 : 0x14),
+                                SSD1306_MEMORYMODE, 0x00,
+                                SSD1306_SEGREMAP | 0x01,
+                                SSD1306_COMSCANDEC,
+                                SSD1306_SETCOMPINS, 0x12,
+                                SSD1306_SETCONTRAST, uint8_t((vccState == SSD1306_EXTERNALVCC) ? 0x9F : 0xCF),
+                                SSD1306_SETPRECHARGE, uint8_t((vccState == SSD1306_EXTERNALVCC) ? 0x22 : 0xF1),
+                                SSD1306_SETVCOMDETECT, 0x40,
+                                SSD1306_DISPLAYALLON_RESUME,
+                                SSD1306_NORMALDISPLAY,
+                                SSD1306_DEACTIVATE_SCROLL,
+                                SSD1306_DISPLAYON};
+
+    m_wire->beginTransmission(m_address);
+    m_wire->write(uint8_t(0x00));
+    m_wire->write(commands, sizeof(commands));
+    return m_wire->endTransmission() == 0;
+}
+
+/// @brief Dessine un pixel : la commande est mémorisée, ou le pixel est placé dans la page en cours de rendu.
+void SSD1306PageDisplay::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (!m_rendering)
+    {
+        this->addCommand(PAGE_COMMAND_FILL_RECT, x, y, 1, 1, color);
+        return;
+    }
+
+    if (x < 0 || x >= width() || y < 0 || (y / 8) != m_renderedPage)
+        return;
+
+    uint8_t bit = 1 << (y & 7);
+
+    if (color == SSD1306_WHITE)
+        m_page[x] |= bit;
+
+    else if (color == SSD1306_BLACK)
+        m_page[x] &= ~bit;
+
+    else if (color == SSD1306_INVERSE)
+        m_page[x] ^= bit;
+}
+
+/// @brief Dessine une ligne horizontale.
+void SSD1306PageDisplay::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    this->fillRect(x, y, w, 1, color);
+}
+
+/// @brief Dessine une ligne verticale.
+void SSD1306PageDisplay::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    this->fillRect(x, y, 1, h, color);
+}
+
+/// @brief Dessine un rectangle plein.
+void SSD1306PageDisplay::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (m_rendering)
+        this->renderRect(x, y, w, h, color);
+
+    else
+        this->addCommand(PAGE_COMMAND_FILL_RECT, x, y, w, h, color);
+}
+
+/// @brief Remplit tout l'écran d'une couleur.
+void SSD1306PageDisplay::fillScreen(uint16_t color)
+{
+    this->fillRect(0, 0, width(), height(), color);
+}
+
+/// @brief Dessine une ligne quelconque.
+void SSD1306PageDisplay::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    if (m_rendering)
+        Adafruit_GFX::drawLine(x0, y0, x1, y1, color);
+
+    else
+        this->addCommand(PAGE_COMMAND_LINE, x0, y0, x1, y1, color);
+}
+
+/// @brief Dessine le contour d'un rectangle.
+void SSD1306PageDisplay::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (m_rendering)
+        Adafruit_GFX::drawRect(x, y, w, h, color);
+
+    else
+        this->addCommand(PAGE_COMMAND_RECT, x, y, w, h, color);
+}
+
+/// @brief Dessine le contour d'un cercle.
+void SSD1306PageDisplay::drawCircle(int16_t x, int16_t y, int16_t r, uint16_t color)
+{
+    this->addCommand(PAGE_COMMAND_CIRCLE, x, y, 0, 0, color, r);
+}
+
+/// @brief Dessine un cercle plein.
+void SSD1306PageDisplay::fillCircle(int16_t x, int16_t y, int16_t r, uint16_t color)
+{
+    this->addCommand(PAGE_COMMAND_FILL_CIRCLE, x, y, 0, 0, color, r);
+}
+
+/// @brief Dessine le contour d'un rectangle aux coins arrondis.
+void SSD1306PageDisplay::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color)
+{
+    this->addCommand(PAGE_COMMAND_ROUND_RECT, x, y, w, h, color, r);
+}
+
+/// @brief Dessine un rectangle plein aux coins arrondis.
+void SSD1306PageDisplay::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color)
+{
+    this->addCommand(PAGE_COMMAND_FILL_ROUND_RECT, x, y, w, h, color, r);
+}
+
+/// @brief Mémorise un caractère à la position du curseur, en reprenant le placement de la police par défaut de la bibliothèque Adafruit. Les caractères consécutifs d'une même ligne sont regroupés dans une seule commande ; ceux situés hors de l'écran sont ignorés. Seul le texte sans couleur de fond est géré.
+/// @param c Le caractère à afficher.
+/// @return Le nombre de caractères traités.
+size_t SSD1306PageDisplay::write(uint8_t c)
+{
+    if (c == '\n')
+    {
+        cursor_x = 0;
+        cursor_y += textsize_y * 8;
+        return 1;
+    }
+
+    if (c == '\r')
+        return 1;
+
+    if (wrap && ((cursor_x + (textsize_x * 6)) > width()))
+    {
+        cursor_x = 0;
+        cursor_y += textsize_y * 8;
+    }
+
+    int16_t x = cursor_x;
+    cursor_x += textsize_x * 6;
+
+    if (x >= width() || cursor_y >= height() || (x + (textsize_x * 6)) <= 0 || (cursor_y + (textsize_y * 8)) <= 0)
+        return 1;
+
+    if (m_textLength >= SSD1306_PAGE_TEXT_SIZE)
+    {
+        m_droppedDrawings++;
+        return 1;
+    }
+
+    // Le caractère prolonge le texte de la dernière commande s'il le suit directement.
+    SSD1306PageCommand *command = (m_commandsNumber > 0) ? &m_commands[m_commandsNumber - 1] : nullptr;
+    if (command == nullptr || command->type != PAGE_COMMAND_TEXT || command->y != cursor_y || command->size != textsize_x || command->color != textcolor || (command->x + (command->width * textsize_x * 6)) != x)
+    {
+        command = this->addCommand(PAGE_COMMAND_TEXT, x, cursor_y, 0, textsize_y * 8, textcolor, textsize_x);
+        if (command == nullptr)
+            return 1;
+
+        command->data = &m_text[m_textLength];
+    }
+
+    m_text[m_textLength++] = c;
+    command->width++;
+    return 1;
+}
+
+/// @brief Mémorise un pictogramme plein écran compressé au format PackBits (voir `bitmaps.hpp`).
+/// @param bitmap Le pictogramme compressé, stocké dans la mémoire flash.
+/// @param color La couleur des pixels allumés du pictogramme (`WHITE`, `BLACK` ou `INVERSE`).
+void SSD1306PageDisplay::drawCompressedBitmap(const uint8_t *bitmap, uint16_t color)
+{
+    SSD1306PageCommand *command = this->addCommand(PAGE_COMMAND_BITMAP, 0, 0, width(), height(), color);
+    if (command != nullptr)
+        command->data = bitmap;
+}
+
+/// @brief Efface l'écran en vidant la liste de commandes.
+void SSD1306PageDisplay::clearDisplay()
+{
+    m_commandsNumber = 0;
+    m_textLength = 0;
+}
+
+/// @brief Inverse les couleurs de l'écran.
+/// @param inverted `true` pour inverser les couleurs.
+void SSD1306PageDisplay::invertDisplay(bool inverted)
+{
+    uint8_t command = inverted ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY;
+    this->sendCommands(&command, 1);
+}
+
+/// @brief Réduit la luminosité de l'écran.
+/// @param dimmed `true` pour réduire la luminosité.
+void SSD1306PageDisplay::dim(bool dimmed)
+{
+    uint8_t commands[] = {SSD1306_SETCONTRAST, uint8_t(dimmed ? 0x00 : ((m_vccState == SSD1306_EXTERNALVCC) ? 0x9F : 0xCF))};
+    this->sendCommands(commands, sizeof(commands));
+}
+
+/// @brief Affiche la liste de commandes : chaque page est rendue puis ses blocs modifiés sont envoyés à l'écran.
+void SSD1306PageDisplay::display()
+{
+    uint8_t blocksNumber = width() / SSD1306_BLOCK_WIDTH;
+
+    for (uint8_t page = 0; page < (height() / 8); page++)
+    {
+        this->renderPage(page);
+
+        // Les blocs modifiés voisins sont regroupés dans une seule région.
+        int firstBlock = -1;
+        for (uint8_t block = 0; block <= blocksNumber; block++)
+        {
+            bool changed = false;
+
+            if (block < blocksNumber)
+            {
+                uint16_t checksum = this->getBlockChecksum(block);
+                changed = m_fullRefresh || (checksum != m_blockChecksums[page][block]);
+                m_blockChecksums[page][block] = checksum;
+            }
+
+            if (changed && firstBlock < 0)
+                firstBlock = block;
+
+            else if (!changed && firstBlock >= 0)
+            {
+                this->sendRegion(page, firstBlock * SSD1306_BLOCK_WIDTH, (block * SSD1306_BLOCK_WIDTH) - 1);
+                firstBlock = -1;
+            }
+        }
+    }
+
+    m_fullRefresh = false;
+}
+
+/// @brief Affiche la liste de commandes (l'envoi est toujours immédiat dans ce mode).
+void SSD1306PageDisplay::displayNow()
+{
+    this->display();
+}
+
+/// @brief L'envoi étant bloquant dans ce mode, aucun envoi n'est jamais en attente.
+/// @return `false`.
+bool SSD1306PageDisplay::update(unsigned int)
+{
+    return false;
+}
+
+/// @brief L'envoi étant bloquant dans ce mode, aucun envoi n'est jamais en attente.
+/// @return `false`.
+bool SSD1306PageDisplay::isFlushPending() const
+{
+    return false;
+}
+
+/// @brief L'envoi étant bloquant dans ce mode, il n'y a rien à attendre.
+void SSD1306PageDisplay::waitForFlush()
+{
+}
+
+/// @brief Fait défiler le contenu de l'écran d'une page (8 lignes) vers le haut en déplaçant la ligne de départ matérielle, sans renvoyer de données : la page sortant en haut réapparaît en bas. Les sommes de contrôle suivent le défilement, donc le prochain affichage n'envoie que les blocs qui diffèrent du contenu décalé (en général la ligne entrante).
+void SSD1306PageDisplay::scrollPage()
+{
+    m_startPage = (m_startPage + 1) % SSD1306_PAGES_NUMBER;
+    uint8_t command = SSD1306_SETSTARTLINE | (m_startPage * 8);
+    this->sendCommands(&command, 1);
+
+    uint8_t pagesNumber = height() / 8;
+    uint16_t firstChecksums[SSD1306_BLOCKS_NUMBER];
+    memcpy(firstChecksums, m_blockChecksums[0], sizeof(firstChecksums));
+    memmove(m_blockChecksums[0], m_blockChecksums[1], (pagesNumber - 1) * sizeof(m_blockChecksums[0]));
+    memcpy(m_blockChecksums[pagesNumber - 1], firstChecksums, sizeof(firstChecksums));
+
+    // Sur un écran de moins de 64 lignes, la page entrante n'était pas affichée : son contenu est inconnu.
+    if (pagesNumber < SSD1306_PAGES_NUMBER)
+        m_fullRefresh = true;
+}
+
+/// @brief Méthode permettant de connaître le nombre d'octets envoyés à l'écran depuis le démarrage, commandes d'adressage comprises.
+/// @return Le nombre d'octets envoyés.
+unsigned long SSD1306PageDisplay::getTransferredBytes() const
+{
+    return m_transferredBytes;
+}
+
+/// @brief Méthode permettant de connaître le nombre de dessins ignorés depuis le démarrage faute de place dans la liste de commandes ou de caractères. Un nombre non nul signifie qu'au moins un écran a été affiché incomplet.
+/// @return Le nombre de commandes et de caractères ignorés.
+unsigned long SSD1306PageDisplay::getDroppedDrawings() const
+{
+    return m_droppedDrawings;
+}
+
+/// @brief Ajoute une commande à la liste. Les commandes au-delà de `SSD1306_PAGE_COMMANDS_NUMBER` sont ignorées et comptées.
+/// @return La commande ajoutée, ou `nullptr` si la liste est pleine.
+SSD1306PageCommand *SSD1306PageDisplay::addCommand(SSD1306PageCommandType type, int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color, uint8_t size)
+{
+    if (m_commandsNumber >= SSD1306_PAGE_COMMANDS_NUMBER)
+    {
+        m_droppedDrawings++;
+        return nullptr;
+    }
+
+    SSD1306PageCommand &command = m_commands[m_commandsNumber++];
+    command.type = type;
+    command.color = color;
+    command.size = size;
+    command.x = x;
+    command.y = y;
+    command.width = width;
+    command.height = height;
+    command.data = nullptr;
+    return &command;
+}
+
+/// @brief Détermine si une commande peut dessiner sur une page, à partir de ses lignes extrêmes.
+/// @param command La commande à vérifier.
+/// @param page La page à rendre.
+/// @return `true` si la commande doit être rejouée pour cette page.
+bool SSD1306PageDisplay::isCommandOnPage(const SSD1306PageCommand &command, uint8_t page) const
+{
+    int16_t top = command.y;
+    int16_t bottom = command.y + command.height - 1;
+
+    if (command.type == PAGE_COMMAND_LINE)
+    {
+        top = min(command.y, command.height);
+        bottom = max(command.y, command.height);
+    }
+
+    else if (command.type == PAGE_COMMAND_CIRCLE || command.type == PAGE_COMMAND_FILL_CIRCLE)
+    {
+        top = command.y - command.size;
+        bottom = command.y + command.size;
+    }
+
+    return (bottom >= (page * 8)) && (top <= ((page * 8) + 7));
+}
+
+/// @brief Rejoue la liste de commandes dans la mémoire tampon d'une page.
+/// @param page La page à rendre.
+void SSD1306PageDisplay::renderPage(uint8_t page)
+{
+    memset(m_page, 0, sizeof(m_page));
+    m_renderedPage = page;
+    m_rendering = true;
+
+    for (uint8_t i = 0; i < m_commandsNumber; i++)
+    {
+        if (this->isCommandOnPage(m_commands[i], page))
+            this->renderCommand(m_commands[i]);
+    }
+
+    m_rendering = false;
+}
+
+/// @brief Dessine une commande dans la page en cours de rendu, à l'aide des fonctions de la bibliothèque Adafruit.
+/// @param command La commande à dessiner.
+void SSD1306PageDisplay::renderCommand(const SSD1306PageCommand &command)
+{
+    switch (command.type)
+    {
+    case PAGE_COMMAND_FILL_RECT:
+        this->renderRect(command.x, command.y, command.width, command.height, command.color);
+        break;
+
+    case PAGE_COMMAND_RECT:
+        Adafruit_GFX::drawRect(command.x, command.y, command.width, command.height, command.color);
+        break;
+
+    case PAGE_COMMAND_LINE:
+        Adafruit_GFX::drawLine(command.x, command.y, command.width, command.height, command.color);
+        break;
+
+    case PAGE_COMMAND_CIRCLE:
+        Adafruit_GFX::drawCircle(command.x, command.y, command.size, command.color);
+        break;
+
+    case PAGE_COMMAND_FILL_CIRCLE:
+        Adafruit_GFX::fillCircle(command.x, command.y, command.size, command.color);
+        break;
+
+    case PAGE_COMMAND_ROUND_RECT:
+        Adafruit_GFX::drawRoundRect(command.x, command.y, command.width, command.height, command.size, command.color);
+        break;
+
+    case PAGE_COMMAND_FILL_ROUND_RECT:
+        Adafruit_GFX::fillRoundRect(command.x, command.y, command.width, command.height, command.size, command.color);
+        break;
+
+    case PAGE_COMMAND_TEXT:
+        for (int16_t i = 0; i < command.width; i++)
+            this->drawChar(command.x + (i * command.size * 6), command.y, command.data[i], command.color, command.color, command.size);
+
+        break;
+
+    case PAGE_COMMAND_BITMAP:
+        this->renderBitmap(command.data, command.color);
+        break;
+    }
+}
+
+/// @brief Décompresse la partie d'un pictogramme PackBits correspondant à la page en cours de rendu.
+/// @param bitmap Le pictogramme compressé, stocké dans la mémoire flash.
+/// @param color La couleur des pixels allumés du pictogramme.
+void SSD1306PageDisplay::renderBitmap(const uint8_t *bitmap, uint16_t color)
+{
+    unsigned int begin = m_renderedPage * width();
+    unsigned int end = begin + width();
+    unsigned int position = 0;
+
+    while (position < end)
+    {
+        uint8_t header = pgm_read_byte(bitmap++);
+        if (header == 128)
+            continue;
+
+        bool repeated = header > 128;
+        unsigned int length = repeated ? (257 - header) : (header + 1);
+
+        // Les blocs situés avant la page sont sautés sans être lus.
+        if ((position + length) <= begin)
+        {
+            bitmap += repeated ? 1 : length;
+            position += length;
+            continue;
+        }
+
+        uint8_t value = repeated ? pgm_read_byte(bitmap++) : 0;
+
+        for (unsigned int i = 0; i < length; i++, position++)
+        {
+            uint8_t byte = repeated ? value : pgm_read_byte(bitmap++);
+            if (position < begin || position >= end || byte == 0)
+                continue;
+
+            if (color == SSD1306_WHITE)
+                m_page[position - begin] |= byte;
+
+            else if (color == SSD1306_BLACK)
+                m_page[position - begin] &= ~byte;
+
+            else if (color == SSD1306_INVERSE)
+                m_page[position - begin] ^= byte;
+        }
+    }
+}
+
+/// @brief Dessine la partie d'un rectangle plein située dans la page en cours de rendu, colonne par colonne.
+void SSD1306PageDisplay::renderRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    int16_t top = max(y, int16_t(m_renderedPage * 8));
+    int16_t bottom = min(int16_t(y + h), int16_t((m_renderedPage * 8) + 8));
+    int16_t left = max(x, int16_t(0));
+    int16_t right = min(int16_t(x + w), width());
+
+    if (w <= 0 || h <= 0 || top >= bottom || left >= right)
+        return;
+
+    uint8_t mask = uint8_t(0xFF << (top & 7)) & uint8_t(0xFF >> (((m_renderedPage * 8) + 8) - bottom));
+
+    for (int16_t column = left; column < right; column++)
+    {
+        if (color == SSD1306_WHITE)
+            m_page[column] |= mask;
+
+        else if (color == SSD1306_BLACK)
+            m_page[column] &= ~mask;
+
+        else if (color == SSD1306_INVERSE)
+            m_page[column] ^= mask;
+    }
+}
+
+/// @brief Envoie une suite de commandes à l'écran.
+/// @param commands Les commandes à envoyer.
+/// @param length Le nombre d'octets à envoyer.
+void SSD1306PageDisplay::sendCommands(const uint8_t *commands, uint8_t length)
+{
+    m_wire->beginTransmission(m_address);
+    m_wire->write(uint8_t(0x00));
+    m_wire->write(commands, length);
+    m_wire->endTransmission();
+    m_transferredBytes += length + 1;
+}
+
+/// @brief Envoie une partie de la page rendue à l'écran, à l'emplacement de la page dans la mémoire de l'écran après défilement.
+/// @param page La page rendue.
+/// @param firstColumn La première colonne de la région.
+/// @param lastColumn La dernière colonne de la région.
+void SSD1306PageDisplay::sendRegion(uint8_t page, uint8_t firstColumn, uint8_t lastColumn)
+{
+    uint8_t physicalPage = (page + m_startPage) % SSD1306_PAGES_NUMBER;
+    uint8_t commands[] = {SSD1306_PAGEADDR, physicalPage, physicalPage, SSD1306_COLUMNADDR, firstColumn, lastColumn};
+    this->sendCommands(commands, sizeof(commands));
+
+    for (uint8_t column = firstColumn; column <= lastColumn; column += SSD1306_PAGE_I2C_CHUNK_SIZE)
+    {
+        uint8_t length = min(SSD1306_PAGE_I2C_CHUNK_SIZE, lastColumn - column + 1);
+
+        m_wire->beginTransmission(m_address);
+        m_wire->write(uint8_t(0x40));
+        m_wire->write(&m_page[column], length);
+        m_wire->endTransmission();
+        m_transferredBytes += length + 1;
+    }
+}
+
+/// @brief Calcule une somme de contrôle CRC-16 (CCITT) d'un bloc de la page rendue (voir `SSD1306PartialDisplay::getBlockChecksum()`).
+/// @param block La position du bloc dans la page.
+/// @return La somme de contrôle du bloc.
+uint16_t SSD1306PageDisplay::getBlockChecksum(uint8_t block) const
+{
+    const uint8_t *data = m_page + (block * SSD1306_BLOCK_WIDTH);
+    uint16_t checksum = 0xFFFF;
+
+    for (uint8_t i = 0; i < SSD1306_BLOCK_WIDTH; i++)
+        checksum = _crc_ccitt_update(checksum, data[i]);
+
+    return checksum;
+}
+
+/// @brief Constructeur de la classe.
+DisplayAnimation::DisplayAnimation() : m_type(ANIMATION_NONE), m_startTime(0), m_duration(0), m_lastFrameTime(0), m_framePeriod(DISPLAY_ANIMATION_FRAME_PERIOD) {}
+
+/// @brief Démarre une animation (l'animation en cours est remplacée). La première image est dessinée au prochain appel de `nextFrame()`.
+/// @param type L'animation à jouer.
+/// @param duration La durée de l'animation en millisecondes.
+void DisplayAnimation::start(DisplayAnimationType type, unsigned int duration)
+{
+    m_type = type;
+    m_duration = duration;
+    m_startTime = millis();
+    m_lastFrameTime = m_startTime - DISPLAY_ANIMATION_FRAME_PERIOD;
+    m_framePeriod = DISPLAY_ANIMATION_FRAME_PERIOD;
+}
+
+/// @brief Arrête l'animation en cours.
+void DisplayAnimation::stop()
+{
+    m_type = ANIMATION_NONE;
+}
+
+/// @brief Méthode permettant de savoir si une animation est en cours.
+/// @return `true` si une animation est en cours.
+bool DisplayAnimation::isRunning() const
+{
+    return m_type != ANIMATION_NONE;
+}
+
+/// @brief Méthode permettant de connaître l'animation en cours.
+/// @return L'animation en cours (`ANIMATION_NONE` s'il n'y en a pas).
+DisplayAnimationType DisplayAnimation::getType() const
+{
+    return m_type;
+}
+
+/// @brief Détermine si une nouvelle image doit être dessinée. L'avancement dépend uniquement du temps écoulé : si la boucle a été ralentie, les images intermédiaires sont sautées. La dernière image est toujours dessinée, sans attendre la fin de la période.
+/// @param progress L'avancement de l'image à dessiner, de `0` à `DISPLAY_ANIMATION_FULL_PROGRESS`.
+/// @return `true` si une image doit être dessinée.
+bool DisplayAnimation::nextFrame(unsigned int &progress)
+{
+    if (m_type == ANIMATION_NONE)
+        return false;
+
+    unsigned long currentTime = millis();
+    unsigned long elapsedTime = currentTime - m_startTime;
+    bool finished = elapsedTime >= m_duration;
+
+    if (!finished && (currentTime - m_lastFrameTime) < m_framePeriod)
+        return false;
+
+    progress = finished ? DISPLAY_ANIMATION_FULL_PROGRESS : (elapsedTime * DISPLAY_ANIMATION_FULL_PROGRESS) / m_duration;
+
+    m_lastFrameTime = currentTime;
+    return true;
+}
+
+/// @brief Indique la durée de dessin de l'image : si elle dépasse `DISPLAY_ANIMATION_RENDER_BUDGET`, les images suivantes sont espacées en proportion pour limiter le temps consacré à l'animation.
+/// @param renderTime La durée de dessin de l'image, en microsecondes.
+void DisplayAnimation::endFrame(unsigned long renderTime)
+{
+    m_framePeriod = DISPLAY_ANIMATION_FRAME_PERIOD;
+
+    if (renderTime > DISPLAY_ANIMATION_RENDER_BUDGET)
+        m_framePeriod = (renderTime * DISPLAY_ANIMATION_FRAME_PERIOD) / DISPLAY_ANIMATION_RENDER_BUDGET;
+}
+
+/// @brief Calcule une valeur intermédiaire entre deux valeurs.
+/// @param from La valeur de départ.
+/// @param to La valeur d'arrivée.
+/// @param progress L'avancement, de `0` à `DISPLAY_ANIMATION_FULL_PROGRESS`.
+/// @return La valeur correspondant à l'avancement.
+int DisplayAnimation::tween(int from, int to, unsigned int progress)
+{
+    return from + ((long(to) - from) * long(progress)) / DISPLAY_ANIMATION_FULL_PROGRESS;
+}
 
 /// @brief Constructeur de la classe.
 /// @param friendlyName Le nom formaté pour être présenté à l'utilisateur du périphérique.
 /// @param ID L'identifiant unique du périphérique utilisé pour communiquer avec Home Assistant.
-Display::Display(const __FlashStringHelper *friendlyName, unsigned int ID) : Device(friendlyName, ID), m_display(128, 64, &Wire, -1), m_lastTime(0), m_menuHelpList(nullptr), m_menuHelpMenu(1), m_deviceStateAnimationType(true), m_deviceStateAnimationStep(0) {}
+Display::Display(const __FlashStringHelper *friendlyName, unsigned int ID) : Device(friendlyName, ID), m_display(128, 64, &Wire, -1), m_lastTime(0), m_menuHelpList(nullptr), m_menuHelpMenu(1), m_animation(), m_screenPriority(PRIORITY_MENU), m_screenTime(0), m_screenDuration(0), m_screenSignature(0), m_redrawPending(false), m_queue(), m_queueLength(0), m_renderStart(0), m_renderTime(0), m_marqueeMessage(), m_marqueeTitle(), m_marqueeLine(0), m_marqueeLines(0), m_marqueeTime(0) {}
 
 /// @brief Initialise l'objet.
 void Display::setup()
 {
+    // Les transmissions passant par la bibliothèque Wire (initialisation, commandes) sont elles aussi limitées dans le temps.
+    Wire.setWireTimeout(SSD1306_TRANSFER_TIMEOUT, true);
+
     if (m_operational || !m_display.begin(SSD1306_SWITCHCAPVCC, 0x3c))
         return;
 
@@ -40,7 +1227,7 @@ void Display::setup()
 /// @param devicesNumber Le nombre d'éléments de la liste.
 void Display::displayUnavailableDevices(Device *deviceList[], int &devicesNumber)
 {
-    if (!m_operational)
+    if (!m_operational || !this->acquireScreen(PRIORITY_NOTIFICATION, DISPLAY_NOTIFICATION_DURATION, 0))
         return;
 
     this->resetDisplay();
@@ -55,13 +1242,13 @@ void Display::displayUnavailableDevices(Device *deviceList[], int &devicesNumber
 
     // Si aucune erreur n'a été détectée, affichage d'un message.
     if (counter == 0)
-        this->displayMessage("Démarré !");
+        this->drawMessage("Démarré !", "Info");
 
     // Affichage de la liste des périphériques indisponibles.
     else
     {
         m_display.setCursor(0, 0);
-        this->displayMessage("", "ERREURS");
+        this->drawMessage("", "ERREURS");
 
         counter = 0;
         for (int i = 0; i < devicesNumber; i++)
@@ -84,9 +1271,14 @@ void Display::displayBell()
     if (!m_operational)
         return;
 
-    this->resetDisplay();
-    m_display.drawBitmap(0, 0, bellBitmap, 128, 64, WHITE);
-    this->display();
+    uint16_t signature = getSignature(SCREEN_BELL, nullptr, 0);
+    if (!this->acquireScreen(PRIORITY_DOORBELL, DISPLAY_DOORBELL_DURATION, signature))
+    {
+        this->enqueueRequest(DisplayRequest{SCREEN_BELL, PRIORITY_DOORBELL, DISPLAY_DOORBELL_DURATION, signature, false, String(), String()});
+        return;
+    }
+
+    this->drawBell();
 }
 
 /// @brief Affiche un message à l'écran avec un titre centré.
@@ -97,11 +1289,14 @@ void Display::displayMessage(const String &message, const String &title)
     if (!m_operational)
         return;
 
-    this->resetDisplay();
-    this->printCenteredAccents(title, 1, 0);
-    m_display.setCursor(0, 10);
-    this->printAccents(message);
-    this->display();
+    uint16_t signature = getSignature(getSignature(SCREEN_MESSAGE, title.c_str(), title.length()), message.c_str(), message.length());
+    if (!this->acquireScreen(PRIORITY_NOTIFICATION, DISPLAY_NOTIFICATION_DURATION, signature))
+    {
+        this->enqueueRequest(DisplayRequest{SCREEN_MESSAGE, PRIORITY_NOTIFICATION, DISPLAY_NOTIFICATION_DURATION, signature, false, message, title});
+        return;
+    }
+
+    this->drawMessage(message, title);
 }
 
 /// @brief Affiche le volume actuel.
@@ -109,23 +1304,24 @@ void Display::displayMessage(const String &message, const String &title)
 /// @param volume Le volume actuel (par défaut `0`, pour les actions qui n'affichent pas le volume actuel).
 void Display::displayVolume(VolumeType action, int volume)
 {
-    if (!m_operational)
+    int values[] = {action, volume};
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, getSignature(SCREEN_VOLUME, values, sizeof(values))))
         return;
 
     this->resetDisplay();
 
     // Affichage d'un pictogramme en fonction de l'action sélectionnée.
     if (action == DECREASE)
-        m_display.drawBitmap(0, 0, volumeDecreaseBitmap, 128, 64, WHITE);
+        m_display.drawCompressedBitmap(volumeDecreaseBitmap, WHITE);
 
     else if (action == INCREASE)
-        m_display.drawBitmap(0, 0, volumeIncreaseBitmap, 128, 64, WHITE);
+        m_display.drawCompressedBitmap(volumeIncreaseBitmap, WHITE);
 
     else if (action == MUTE)
-        m_display.drawBitmap(0, 0, muteBitmap, 128, 64, WHITE);
+        m_display.drawCompressedBitmap(muteBitmap, WHITE);
 
     else if (action == UNMUTE)
-        m_display.drawBitmap(0, 0, unmuteBitmap, 128, 64, WHITE);
+        m_display.drawCompressedBitmap(unmuteBitmap, WHITE);
 
     // Affichage du volume selon le mode sélectionné.
     if (action == DECREASE || action == INCREASE || action == UNMUTE)
@@ -148,13 +1344,14 @@ void Display::displayAlarmTriggered(bool colorsInverted)
     if (!m_operational)
         return;
 
-    this->resetDisplay();
-    m_display.drawBitmap(0, 0, alarmTriggeredBitmap, 128, 64, 1);
-
-    if (colorsInverted)
-        m_display.invertDisplay(true);
+    uint16_t signature = getSignature(SCREEN_ALARM_TRIGGERED, &colorsInverted, sizeof(colorsInverted));
+    if (!this->acquireScreen(PRIORITY_ALARM, DISPLAY_ALARM_DURATION, signature))
+    {
+        this->enqueueRequest(DisplayRequest{SCREEN_ALARM_TRIGGERED, PRIORITY_ALARM, DISPLAY_ALARM_DURATION, signature, colorsInverted, String(), String()});
+        return;
+    }
 
-    this->display();
+    this->drawAlarmTriggered(colorsInverted);
 }
 
 /// @brief Affiche les valeurs des capteurs de température et d'humidité, avec deux pictogrammes.
@@ -162,11 +1359,12 @@ void Display::displayAlarmTriggered(bool colorsInverted)
 /// @param humidity La valeur de l'humidité à afficher.
 void Display::displayAirValues(float temperature, float humidity)
 {
-    if (!m_operational)
+    float values[] = {temperature, humidity};
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, getSignature(SCREEN_AIR_VALUES, values, sizeof(values))))
         return;
 
     this->resetDisplay();
-    m_display.drawBitmap(0, 0, airBitmap, 128, 64, WHITE);
+    m_display.drawCompressedBitmap(airBitmap, WHITE);
     m_display.setTextSize(2);
     // Affichage de la température.
     m_display.setCursor(40, 42);
@@ -186,11 +1384,11 @@ void Display::displayAirValues(float temperature, float humidity)
 /// @param value La valeur du capteur analogique.
 void Display::displayAnalogSensorValue(int value)
 {
-    if (!m_operational)
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, getSignature(SCREEN_ANALOG_SENSOR, &value, sizeof(value))))
         return;
 
     this->resetDisplay();
-    m_display.drawBitmap(0, 0, analogSensorBitmap, 128, 64, WHITE);
+    m_display.drawCompressedBitmap(analogSensorBitmap, WHITE);
     this->printCenteredAccents(String(value), 2, 45);
     this->display();
 }
@@ -199,11 +1397,11 @@ void Display::displayAnalogSensorValue(int value)
 /// @param value La valeur du capteur binaire.
 void Display::displayBinarySensorValue(bool value)
 {
-    if (!m_operational)
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, getSignature(SCREEN_BINARY_SENSOR, &value, sizeof(value))))
         return;
 
     this->resetDisplay();
-    m_display.drawBitmap(0, 0, binarySensorBitmap, 128, 64, WHITE);
+    m_display.drawCompressedBitmap(binarySensorBitmap, WHITE);
     this->printCenteredAccents(String(value), 2, 45);
     this->display();
 }
@@ -214,7 +1412,8 @@ void Display::displayBinarySensorValue(bool value)
 /// @param b La valeur de l'intensité du bleu.
 void Display::displayLEDState(int r, int g, int b)
 {
-    if (!m_operational)
+    int values[] = {r, g, b};
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, getSignature(SCREEN_LED_STATE, values, sizeof(values))))
         return;
 
     this->resetDisplay();
@@ -241,24 +1440,12 @@ void Display::displayLEDState(int r, int g, int b)
 /// @param on Mise en marche ou errêt.
 void Display::displayDeviceState(bool on)
 {
-    if (!m_operational)
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, 0))
         return;
 
     this->resetDisplay();
 
-    // Animation de mise en marche.
-    if (on)
-    {
-        m_deviceStateAnimationType = true;
-        m_deviceStateAnimationStep = 51;
-    }
-
-    // Animation d'arrêt.
-    else
-    {
-        m_deviceStateAnimationType = false;
-        m_deviceStateAnimationStep = 75;
-    }
+    m_animation.start(on ? ANIMATION_DEVICE_ON : ANIMATION_DEVICE_OFF, DISPLAY_DEVICE_STATE_ANIMATION_DURATION);
 }
 
 /// @brief Affiche le menu actuel du clavier.
@@ -266,7 +1453,8 @@ void Display::displayDeviceState(bool on)
 /// @param menuName Le nom du menu.
 void Display::displayKeypadMenu(MenuIcons menuIcon, const __FlashStringHelper *menuName)
 {
-    if (!m_operational)
+    uint16_t signature = getSignature(getSignature(SCREEN_KEYPAD_MENU, &menuIcon, sizeof(menuIcon)), &menuName, sizeof(menuName));
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, signature))
         return;
 
     this->resetDisplay();
@@ -274,27 +1462,27 @@ void Display::displayKeypadMenu(MenuIcons menuIcon, const __FlashStringHelper *m
     switch (menuIcon)
     {
     case OUTPUTS:
-        m_display.drawBitmap(0, 0, devicesMenuBitmap, 128, 64, WHITE);
+        m_display.drawCompressedBitmap(devicesMenuBitmap, WHITE);
         break;
 
     case LIGHTS:
-        m_display.drawBitmap(0, 0, lightsMenuBitmap, 128, 64, WHITE);
+        m_display.drawCompressedBitmap(lightsMenuBitmap, WHITE);
         break;
 
     case INPUTS:
-        m_display.drawBitmap(0, 0, sensorsMenuBitmap, 128, 64, WHITE);
+        m_display.drawCompressedBitmap(sensorsMenuBitmap, WHITE);
         break;
 
     case TELEVISIONS:
-        m_display.drawBitmap(0, 0, TVMenuBitmap, 128, 64, WHITE);
+        m_display.drawCompressedBitmap(TVMenuBitmap, WHITE);
         break;
 
     case ALARMS:
-        m_display.drawBitmap(0, 0, AlarmMenuBitmap, 128, 64, WHITE);
+        m_display.drawCompressedBitmap(AlarmMenuBitmap, WHITE);
         break;
 
     case CONTROLS:
-        m_display.drawBitmap(0, 0, deviceControlMenuBitmap, 128, 64, WHITE);
+        m_display.drawCompressedBitmap(deviceControlMenuBitmap, WHITE);
         break;
     }
 
@@ -307,7 +1495,7 @@ void Display::displayKeypadMenu(MenuIcons menuIcon, const __FlashStringHelper *m
 /// @param menuTitle Le nom du menu.
 void Display::displayKeypadMenuHelp(const __FlashStringHelper **menuHelpList, const __FlashStringHelper *menuName)
 {
-    if (!m_operational)
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, 0))
         return;
 
     this->resetDisplay(false);
@@ -351,55 +1539,16 @@ void Display::displayKeypadMenuHelp(const __FlashStringHelper **menuHelpList, co
     this->display();
 }
 
-/// @brief Affiche l'animation d'ouverture ou de fermeture du plateau.
-/// @param on Ouverture ou fermeture du plateau.
-/// @param shareInformation Affichage ou non de l'animation (permet d'obtenir un délai sans rien afficher).
-void Display::displayTray(bool on, bool shareInformation)
+/// @brief Démarre l'animation d'ouverture ou de fermeture du plateau. L'animation avance dans `loop()` en fonction du temps écoulé.
+/// @param opening Ouverture ou fermeture du plateau.
+/// @param duration La durée de l'animation en millisecondes (celle du déplacement du plateau).
+void Display::displayTray(bool opening, unsigned int duration)
 {
-    if (!m_operational)
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, 0))
         return;
 
     this->resetDisplay();
-    m_display.fillRoundRect(5, -10, 118, 20, 5, WHITE);
-
-    if (on)
-    {
-        for (int i = 0; i < 40; i++)
-        {
-            m_display.drawLine(28, 11 + i, 100, 11 + i, WHITE);
-            if (shareInformation)
-                m_display.display();
-
-            else
-                delay(15);
-
-            delay(15);
-        }
-    }
-
-    else
-    {
-        for (int i = 0; i < 40; i++)
-            m_display.drawLine(28, 11 + i, 100, 11 + i, WHITE);
-
-        if (shareInformation)
-            m_display.display();
-
-        for (int i = 0; i < 40; i++)
-        {
-            m_display.drawLine(28, 50 - i, 100, 50 - i, BLACK);
-            if (shareInformation)
-                m_display.display();
-
-            else
-                delay(15);
-
-            delay(15);
-        }
-    }
-
-    if (shareInformation)
-        this->display();
+    m_animation.start(opening ? ANIMATION_TRAY_OPENING : ANIMATION_TRAY_CLOSING, duration);
 }
 
 /// @brief Affiche la température de couleur actuelle d'une ampoule.
@@ -408,11 +1557,12 @@ void Display::displayTray(bool on, bool shareInformation)
 /// @param temperature La température actuelle en kelvin.
 void Display::displayLightColorTemperature(int minimum, int maximum, int temperature)
 {
-    if (!m_operational)
+    int values[] = {minimum, maximum, temperature};
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, getSignature(SCREEN_LIGHT_COLOR_TEMPERATURE, values, sizeof(values))))
         return;
 
     this->resetDisplay();
-    m_display.drawBitmap(0, 0, lightColorTemperatureBitmap, 128, 64, WHITE);
+    m_display.drawCompressedBitmap(lightColorTemperatureBitmap, WHITE);
     m_display.drawRect(13, 45, 102, 6, WHITE);
 
     if (temperature > minimum)
@@ -427,11 +1577,11 @@ void Display::displayLightColorTemperature(int minimum, int maximum, int tempera
 /// @param luminosity La luminosité de `0` à `255`.
 void Display::displayLuminosity(int luminosity)
 {
-    if (!m_operational)
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, getSignature(SCREEN_LUMINOSITY, &luminosity, sizeof(luminosity))))
         return;
 
     this->resetDisplay();
-    m_display.drawBitmap(0, 0, lightLuminosityBitmap, 128, 64, WHITE);
+    m_display.drawCompressedBitmap(lightLuminosityBitmap, WHITE);
     m_display.drawRect(13, 45, 102, 6, WHITE);
 
     if (luminosity > 0)
@@ -446,7 +1596,8 @@ void Display::displayLuminosity(int luminosity)
 /// @param value Le pourcentage de la jauge.
 void Display::displayPercentage(String name, int value)
 {
-    if (!m_operational)
+    uint16_t signature = getSignature(getSignature(SCREEN_PERCENTAGE, name.c_str(), name.length()), &value, sizeof(value));
+    if (!m_operational || !this->acquireScreen(PRIORITY_MENU, 0, signature))
         return;
 
     this->resetDisplay();
@@ -460,12 +1611,26 @@ void Display::displayPercentage(String name, int value)
     this->display();
 }
 
+/// @brief Lit une musique d'une liste stockée dans la mémoire flash.
+/// @param musicList La liste des musiques.
+/// @param musicIndex La position de la musique dans la liste.
+/// @return La musique lue.
+static Music readMusic(const Music *const *musicList, unsigned int musicIndex)
+{
+    const Music *musicPtr;
+    memcpy_P(&musicPtr, &musicList[musicIndex], sizeof(Music *));
+    Music music;
+    memcpy_P(&music, musicPtr, sizeof(Music));
+    return music;
+}
+
 /// @brief Affiche à l'écran la liste des musiques disponibles, avec en son centre la musique sélectionnée.
-/// @param television La télévision fournissant les musiques.
+/// @param musicList La liste des musiques de la télévision (`Television::getMusicsList()`).
+/// @param musicsNumber Le nombre de musiques de la liste.
 /// @param musicIndex La position de la musique dans la liste des musiques de la télévision.
-void Display::displaySelectedMusic(Television &television, unsigned int musicIndex)
+void Display::displaySelectedMusic(const Music *const *musicList, unsigned int musicsNumber, unsigned int musicIndex)
 {
-    if (!m_operational || musicIndex >= television.getMusicNumber())
+    if (!m_operational || musicIndex >= musicsNumber || !this->acquireScreen(PRIORITY_MENU, 0, getSignature(SCREEN_SELECTED_MUSIC, &musicIndex, sizeof(musicIndex))))
         return;
 
     this->resetDisplay();
@@ -474,23 +1639,28 @@ void Display::displaySelectedMusic(Television &television, unsigned int musicInd
     // Affiche la musique sélectionnée.
     m_display.setCursor(0, 25);
     m_display.setTextWrap(false);
-    Music music = television.getMusicFromIndex(musicIndex);
-    this->printAccents("-> " + readProgmemString(music.friendlyName));
+    Music music = readMusic(musicList, musicIndex);
+    m_display.print(F("-> "));
+    this->printAccents(music.friendlyName, true);
 
     // Affiche la musique précédente.
     if (musicIndex > 0)
     {
         m_display.setCursor(0, 17);
-        Music previousMusic = television.getMusicFromIndex(musicIndex - 1);
-        this->printAccents(String(musicIndex) + ". " + readProgmemString(previousMusic.friendlyName));
+        Music previousMusic = readMusic(musicList, musicIndex - 1);
+        m_display.print(musicIndex);
+        m_display.print(F(". "));
+        this->printAccents(previousMusic.friendlyName, true);
     }
 
     // Affiche la musique suivante.
-    if (musicIndex < (television.getMusicNumber() - 1))
+    if (musicIndex < (musicsNumber - 1))
     {
         m_display.setCursor(0, 33);
-        Music nextMusic = television.getMusicFromIndex(musicIndex + 1);
-        this->printAccents(String(musicIndex + 2) + ". " + readProgmemString(nextMusic.friendlyName));
+        Music nextMusic = readMusic(musicList, musicIndex + 1);
+        m_display.print(musicIndex + 2);
+        m_display.print(F(". "));
+        this->printAccents(nextMusic.friendlyName, true);
     }
 
     m_display.setTextWrap(true);
@@ -503,134 +1673,111 @@ void Display::loop()
     if (!m_operational)
         return;
 
+    m_display.update(DISPLAY_FLUSH_BUDGET);
+    this->processQueue();
+    this->updateAnimation();
+    this->updateMarquee();
+
     if ((m_lastTime != 0) && ((millis() - m_lastTime) >= 15000))
     {
         m_lastTime = 0;
+        m_screenSignature = 0;
+        m_redrawPending = false;
+        this->stopMarquee();
         resetDisplay();
         m_display.display();
         m_menuHelpList = nullptr;
         m_menuHelpMenu = 1;
     }
-
-    if (m_deviceStateAnimationStep != 0)
-    {
-        if (m_deviceStateAnimationType)
-        {
-            m_display.clearDisplay();
-            m_display.drawRoundRect(41, 14, 46, 24, 12, WHITE);
-            m_display.drawRoundRect(40, 13, 48, 26, 13, WHITE);
-            m_display.drawCircle(m_deviceStateAnimationStep, 26, 8, WHITE);
-            m_display.drawCircle(m_deviceStateAnimationStep, 26, 7, WHITE);
-            m_display.fillCircle(m_deviceStateAnimationStep, 26, 4, WHITE);
-            m_display.display();
-            m_deviceStateAnimationStep += 4;
-
-            if (m_deviceStateAnimationStep >= 75)
-            {
-                m_deviceStateAnimationStep = 0;
-                this->display();
-            }
-        }
-
-        else
-        {
-            m_display.clearDisplay();
-            m_display.drawRoundRect(41, 14, 46, 24, 12, WHITE);
-            m_display.drawRoundRect(40, 13, 48, 26, 13, WHITE);
-            m_display.drawCircle(m_deviceStateAnimationStep, 26, 8, WHITE);
-            m_display.drawCircle(m_deviceStateAnimationStep, 26, 7, WHITE);
-            m_display.display();
-            m_deviceStateAnimationStep -= 4;
-
-            if (m_deviceStateAnimationStep <= 51)
-            {
-                m_deviceStateAnimationStep = 0;
-                this->display();
-            }
-        }
-    }
 }
 
 /// @brief Méthode d'arrêt des services de l'écran.
 void Display::shutdown()
 {
     this->resetDisplay();
-    m_display.display();
+    m_display.displayNow();
 }
 
-/// @brief Méthode permettant d'afficher un texte intégrant des accents et autres caractères spéciaux. Le texte est imprimé en suivant les instructions précédentes (taille du texte, position...).
-/// @param string Le texte à afficher et pouvant inclure des accents.
-void Display::printAccents(const String &string)
+/// @brief Méthode permettant d'afficher un texte UTF-8 pouvant contenir des accents et autres caractères Latin-1. Le texte est décodé au fil de l'eau et imprimé en suivant les instructions précédentes (taille du texte, position...).
+/// @param text Le texte à afficher.
+/// @param flash `true` si le texte est stocké dans la mémoire flash.
+void Display::printAccents(const char *text, bool flash)
 {
-    int stringBeginIndex = 0;
-    for (unsigned int i = 0; i < string.length(); i++)
-    {
-        String c = string.substring(i, i + 2);
-        if (c != "é" && c != "à" && c != "è" && c != "ù" && c != "â" && c != "ê" && c != "î" && c != "ô" && c != "û" && c != "ç")
-            continue;
-
-        m_display.print(string.substring(stringBeginIndex, i));
-        stringBeginIndex = i + 2;
-
-        if (c == "é")
-            m_display.write(0x82);
-
-        else if (c == "à")
-            m_display.write(0x85);
-
-        else if (c == "è")
-            m_display.write(0x8A);
-
-        else if (c == "ù")
-            m_display.write(0x97);
-
-        else if (c == "â")
-            m_display.write(0x83);
+    UTF8Decoder decoder;
+    uint8_t glyph;
 
-        else if (c == "ê")
-            m_display.write(0x88);
-
-        else if (c == "î")
-            m_display.write(0x8C);
-
-        else if (c == "ô")
-            m_display.write(0x93);
-
-        else if (c == "û")
-            m_display.write(0x96);
+    for (;; text++)
+    {
+        uint8_t byte = flash ? pgm_read_byte(text) : *text;
+        if (byte == '\0')
+            return;
 
-        else if (c == "ç")
-            m_display.write(0x87);
+        if (decoder.decode(byte, glyph))
+            m_display.write(glyph);
     }
+}
 
-    m_display.print(string.substring(stringBeginIndex, string.length()));
+/// @brief Méthode permettant d'afficher un texte de la mémoire flash pouvant contenir des accents.
+/// @param text Le texte à afficher.
+void Display::printAccents(const __FlashStringHelper *text)
+{
+    this->printAccents(reinterpret_cast<const char *>(text), true);
 }
 
-/// @brief Affiche un texte contenant des accents centré verticalement.
-/// @param string Le texte à afficher et pouvant inclure des accents.
-/// @param textSize La taile du texte.
-/// @param y La position horizontale du texte.
-void Display::printCenteredAccents(const String &string, int textSize, int y)
+/// @brief Méthode permettant d'afficher un texte pouvant contenir des accents.
+/// @param string Le texte à afficher.
+void Display::printAccents(const String &string)
+{
+    this->printAccents(string.c_str());
+}
+
+/// @brief Affiche un texte UTF-8 centré horizontalement. Le texte est décodé une seule fois : les glyphes sont mémorisés pendant le calcul de la largeur, puis imprimés. Seuls les `DISPLAY_CENTERED_TEXT_SIZE` premiers caractères sont affichés.
+/// @param text Le texte à afficher et pouvant inclure des accents.
+/// @param textSize La taille du texte.
+/// @param y La position verticale du texte.
+/// @param flash `true` si le texte est stocké dans la mémoire flash.
+void Display::printCenteredAccents(const char *text, int textSize, int y, bool flash)
 {
-    // Un caractère spécial est compté comme double : il faut donc reprendre la bonne longueur.
-    int stringLength = string.length();
-    for (unsigned int i = 0; i < string.length(); i++)
+    UTF8Decoder decoder;
+    uint8_t glyphs[DISPLAY_CENTERED_TEXT_SIZE];
+    unsigned int glyphsNumber = 0;
+
+    for (; glyphsNumber < DISPLAY_CENTERED_TEXT_SIZE; text++)
     {
-        String c = string.substring(i, i + 2);
-        if (c != "é" && c != "à" && c != "è" && c != "ù" && c != "â" && c != "ê" && c != "î" && c != "ô" && c != "û" && c != "ç")
-            continue;
+        uint8_t byte = flash ? pgm_read_byte(text) : *text;
+        if (byte == '\0')
+            break;
 
-        stringLength--;
+        if (decoder.decode(byte, glyphs[glyphsNumber]))
+            glyphsNumber++;
     }
 
     // Affichage du texte.
-    m_display.setCursor(ceil((128.0 - double((6 * textSize) * stringLength)) / 2), y);
+    m_display.setCursor(ceil((128.0 - double((6 * textSize) * glyphsNumber)) / 2), y);
     m_display.setTextWrap(false);
     m_display.setTextSize(textSize);
-    this->printAccents(string);
+    m_display.write(glyphs, glyphsNumber);
     m_display.setTextWrap(true);
 }
 
+/// @brief Affiche un texte de la mémoire flash centré horizontalement.
+/// @param text Le texte à afficher et pouvant inclure des accents.
+/// @param textSize La taille du texte.
+/// @param y La position verticale du texte.
+void Display::printCenteredAccents(const __FlashStringHelper *text, int textSize, int y)
+{
+    this->printCenteredAccents(reinterpret_cast<const char *>(text), textSize, y, true);
+}
+
+/// @brief Affiche un texte centré horizontalement.
+/// @param string Le texte à afficher et pouvant inclure des accents.
+/// @param textSize La taille du texte.
+/// @param y La position verticale du texte.
+void Display::printCenteredAccents(const String &string, int textSize, int y)
+{
+    this->printCenteredAccents(string.c_str(), textSize, y);
+}
+
 /// @brief Réinitialise l'écran actuel de la mémoire tampon, avec les paramètres par défaut.
 /// @param resetHelpMenu
 void Display::resetDisplay(bool resetHelpMenu)
@@ -641,6 +1788,7 @@ void Display::resetDisplay(bool resetHelpMenu)
     m_display.setTextWrap(true);
     m_display.invertDisplay(false);
     m_display.setTextSize(1);
+    m_renderStart = micros();
 
     if (resetHelpMenu)
     {
@@ -649,10 +1797,315 @@ void Display::resetDisplay(bool resetHelpMenu)
     }
 }
 
+/// @brief Renvoie la durée de dessin du dernier écran affiché, de sa remise à zéro jusqu'à la demande d'affichage (envoi à l'écran non compris).
+/// @return La durée en microsecondes.
+unsigned long Display::getRenderTime() const
+{
+    return m_renderTime;
+}
+
+/// @brief Renvoie le nombre total d'octets envoyés à l'écran depuis son initialisation, pour mesurer le coût des affichages.
+/// @return Le nombre d'octets envoyés.
+unsigned long Display::getTransferredBytes() const
+{
+    return m_display.getTransferredBytes();
+}
+
+/// @brief Méthode permettant de savoir si des écrans ont été affichés incomplets : en mode page par page, les dessins au-delà de la capacité de la liste de commandes sont ignorés.
+/// @return Le nombre de dessins ignorés depuis le démarrage.
+unsigned long Display::getDroppedDrawings() const
+{
+    return m_display.getDroppedDrawings();
+}
+
 /// @brief Affiche le contenu de la mémoire tampon proprement.
 void Display::display()
 {
+    m_renderTime = micros() - m_renderStart;
     m_display.display();
     m_lastTime = millis();
-    m_deviceStateAnimationStep = 0;
+    m_animation.stop();
+}
+
+/// @brief Réserve l'écran pour un nouvel affichage. Un écran identique à celui affiché n'est pas redessiné, et un écran prioritaire ne peut être remplacé pendant sa durée minimale d'affichage que par un écran de priorité supérieure. Un menu ignoré pendant cette durée est signalé (voir `isRedrawPending()`), pour que l'écran ne reste pas sur un menu périmé.
+/// @param priority La priorité du nouvel écran.
+/// @param duration La durée minimale d'affichage du nouvel écran, en millisecondes.
+/// @param signature La signature du contenu du nouvel écran (`0` pour toujours le redessiner).
+/// @return `true` si l'écran peut être dessiné.
+bool Display::acquireScreen(DisplayPriority priority, unsigned int duration, uint16_t signature)
+{
+    bool held = (millis() - m_screenTime) < m_screenDuration && priority <= m_screenPriority;
+    if (priority == PRIORITY_MENU)
+        m_redrawPending = held;
+
+    if (held || (signature != 0 && signature == m_screenSignature))
+        return false;
+
+    m_screenPriority = priority;
+    m_screenTime = millis();
+    m_screenDuration = duration;
+    m_screenSignature = signature;
+    this->stopMarquee();
+    return true;
+}
+
+/// @brief Méthode permettant de savoir si un menu a été ignoré pendant l'affichage d'un écran prioritaire, et doit être redessiné maintenant que cet écran peut être remplacé (et qu'aucun autre n'est en attente).
+/// @return `true` si le menu actuel doit être redessiné.
+bool Display::isRedrawPending() const
+{
+    return m_redrawPending && m_queueLength == 0 && (millis() - m_screenTime) >= m_screenDuration;
+}
+
+/// @brief Met un écran en attente. Un écran identique à celui affiché ou déjà en attente est ignoré, et un message en attente avec le même titre est remplacé par le plus récent. Si la file est pleine, l'écran le moins prioritaire est abandonné.
+/// @param request L'écran à mettre en attente.
+void Display::enqueueRequest(const DisplayRequest &request)
+{
+    if (request.signature == m_screenSignature)
+        return;
+
+    for (uint8_t i = 0; i < m_queueLength; i++)
+    {
+        if (m_queue[i].signature == request.signature)
+            return;
+
+        if (request.screen == SCREEN_MESSAGE && m_queue[i].screen == SCREEN_MESSAGE && m_queue[i].title == request.title)
+        {
+            m_queue[i] = request;
+            return;
+        }
+    }
+
+    if (m_queueLength >= DISPLAY_QUEUE_SIZE)
+    {
+        uint8_t lowest = 0;
+        for (uint8_t i = 1; i < m_queueLength; i++)
+        {
+            if (m_queue[i].priority <= m_queue[lowest].priority)
+                lowest = i;
+        }
+
+        if (m_queue[lowest].priority >= request.priority)
+            return;
+
+        for (uint8_t i = lowest; i < (m_queueLength - 1); i++)
+            m_queue[i] = m_queue[i + 1];
+
+        m_queueLength--;
+    }
+
+    m_queue[m_queueLength++] = request;
+}
+
+/// @brief Affiche l'écran en attente le plus prioritaire (le plus ancien à priorité égale) lorsque la durée minimale de l'écran affiché est écoulée.
+void Display::processQueue()
+{
+    if (m_queueLength == 0 || (millis() - m_screenTime) < m_screenDuration)
+        return;
+
+    uint8_t next = 0;
+    for (uint8_t i = 1; i < m_queueLength; i++)
+    {
+        if (m_queue[i].priority > m_queue[next].priority)
+            next = i;
+    }
+
+    DisplayRequest request = m_queue[next];
+
+    for (uint8_t i = next; i < (m_queueLength - 1); i++)
+        m_queue[i] = m_queue[i + 1];
+
+    m_queueLength--;
+    m_queue[m_queueLength] = DisplayRequest();
+
+    if (!this->acquireScreen(request.priority, request.duration, request.signature))
+        return;
+
+    switch (request.screen)
+    {
+    case SCREEN_MESSAGE:
+        this->drawMessage(request.message, request.title);
+        break;
+
+    case SCREEN_BELL:
+        this->drawBell();
+        break;
+
+    case SCREEN_ALARM_TRIGGERED:
+        this->drawAlarmTriggered(request.colorsInverted);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/// @brief Dessine un message avec un titre centré. Un message trop long pour l'écran défile ensuite ligne par ligne (voir `updateMarquee()`), et sa durée minimale d'affichage est prolongée d'autant.
+/// @param message Le message à afficher.
+/// @param title Le titre du message.
+void Display::drawMessage(const String &message, const String &title)
+{
+    int16_t lastLine = this->renderMessage(message, title, 0);
+    if (lastLine <= DISPLAY_MESSAGE_LAST_LINE)
+        return;
+
+    m_marqueeMessage = message;
+    m_marqueeTitle = title;
+    m_marqueeLine = 0;
+    m_marqueeLines = (lastLine - DISPLAY_MESSAGE_LAST_LINE + 7) / 8;
+    m_marqueeTime = millis();
+    m_screenDuration += m_marqueeLines * DISPLAY_MARQUEE_PERIOD;
+}
+
+/// @brief Dessine un message décalé d'un nombre de lignes vers le haut, sous un titre fixe.
+/// @param message Le message à afficher.
+/// @param title Le titre du message.
+/// @param line Le nombre de lignes du message déjà défilées.
+/// @return L'ordonnée de la dernière ligne du message.
+int16_t Display::renderMessage(const String &message, const String &title, uint8_t line)
+{
+    this->resetDisplay();
+    m_display.setCursor(0, DISPLAY_MESSAGE_FIRST_LINE - (line * 8));
+    this->printAccents(message);
+    int16_t lastLine = m_display.getCursorY();
+
+    // Le titre reste fixe : les lignes défilées sous lui sont masquées.
+    m_display.fillRect(0, 0, m_display.width(), DISPLAY_MESSAGE_FIRST_LINE, BLACK);
+    this->printCenteredAccents(title, 1, 0);
+    this->display();
+    return lastLine;
+}
+
+/// @brief Fait défiler le message affiché d'une ligne lorsque le délai est écoulé. Le défilement est effectué par l'écran lui-même : seuls le titre et la ligne entrante sont renvoyés.
+void Display::updateMarquee()
+{
+    if (m_marqueeLine >= m_marqueeLines || m_display.isFlushPending() || (millis() - m_marqueeTime) < DISPLAY_MARQUEE_PERIOD)
+        return;
+
+    m_display.scrollPage();
+    m_marqueeLine++;
+    m_marqueeTime = millis();
+    this->renderMessage(m_marqueeMessage, m_marqueeTitle, m_marqueeLine);
+
+    if (m_marqueeLine >= m_marqueeLines)
+        this->stopMarquee();
+}
+
+/// @brief Arrête le défilement du message affiché.
+void Display::stopMarquee()
+{
+    m_marqueeLine = 0;
+    m_marqueeLines = 0;
+    m_marqueeMessage = String();
+    m_marqueeTitle = String();
+}
+
+/// @brief Dessine un pictogramme de cloche.
+void Display::drawBell()
+{
+    this->resetDisplay();
+    m_display.drawCompressedBitmap(bellBitmap, WHITE);
+    this->display();
+}
+
+/// @brief Dessine un pictogramme d'alerte (point d'exclamation).
+/// @param colorsInverted Inversion ou non des couleurs de l'écran.
+void Display::drawAlarmTriggered(bool colorsInverted)
+{
+    this->resetDisplay();
+    m_display.drawCompressedBitmap(alarmTriggeredBitmap, WHITE);
+
+    if (colorsInverted)
+        m_display.invertDisplay(true);
+
+    this->display();
+}
+
+/// @brief Calcule une signature sur 16 bit (CRC-16 CCITT) du contenu d'un écran, pour détecter les affichages identiques. Contrairement à une somme de Fletcher sur 8 bit, deux écrans différents ne se confondent que par hasard (une chance sur 65536).
+/// @param seed La signature des données précédentes (ou le type de l'écran pour les premières données).
+/// @param data Les données à ajouter à la signature.
+/// @param length La taille des données en octets.
+/// @return La signature mise à jour.
+uint16_t Display::getSignature(uint16_t seed, const void *data, unsigned int length)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    uint16_t signature = seed;
+
+    for (unsigned int i = 0; i < length; i++)
+        signature = _crc_ccitt_update(signature, bytes[i]);
+
+    return signature;
+}
+
+/// @brief Dessine l'image suivante de l'animation en cours, si la période entre deux images est écoulée et que l'image précédente a été envoyée à l'écran.
+void Display::updateAnimation()
+{
+    unsigned int progress;
+    if (m_display.isFlushPending() || !m_animation.nextFrame(progress))
+        return;
+
+    unsigned long renderStart = micros();
+    this->drawAnimationFrame(m_animation.getType(), progress);
+
+    if (progress < DISPLAY_ANIMATION_FULL_PROGRESS)
+    {
+        m_display.display();
+        m_animation.endFrame(micros() - renderStart);
+    }
+
+    else
+        this->display();
+}
+
+/// @brief Dessine une image d'une animation.
+/// @param type L'animation à dessiner.
+/// @param progress L'avancement de l'animation, de `0` à `DISPLAY_ANIMATION_FULL_PROGRESS`.
+void Display::drawAnimationFrame(DisplayAnimationType type, unsigned int progress)
+{
+    switch (type)
+    {
+    case ANIMATION_DEVICE_ON:
+        this->drawDeviceState(DisplayAnimation::tween(51, 75, progress), true);
+        break;
+
+    case ANIMATION_DEVICE_OFF:
+        this->drawDeviceState(DisplayAnimation::tween(75, 51, progress), false);
+        break;
+
+    case ANIMATION_TRAY_OPENING:
+        this->drawTray(DisplayAnimation::tween(0, DISPLAY_TRAY_ANIMATION_STEPS, progress));
+        break;
+
+    case ANIMATION_TRAY_CLOSING:
+        this->drawTray(DisplayAnimation::tween(DISPLAY_TRAY_ANIMATION_STEPS, 0, progress));
+        break;
+
+    default:
+        break;
+    }
+}
+
+/// @brief Dessine une image de l'animation de mise en marche ou d'arrêt d'un périphérique : un interrupteur dont le bouton se déplace.
+/// @param position La position horizontale du bouton de l'interrupteur.
+/// @param on `true` pour dessiner le bouton plein (mise en marche).
+void Display::drawDeviceState(int position, bool on)
+{
+    m_display.clearDisplay();
+    m_display.drawRoundRect(41, 14, 46, 24, 12, WHITE);
+    m_display.drawRoundRect(40, 13, 48, 26, 13, WHITE);
+    m_display.drawCircle(position, 26, 8, WHITE);
+    m_display.drawCircle(position, 26, 7, WHITE);
+
+    if (on)
+        m_display.fillCircle(position, 26, 4, WHITE);
+}
+
+/// @brief Dessine une image de l'animation du plateau.
+/// @param lines Le nombre de lignes du plateau à afficher (de `0` à `DISPLAY_TRAY_ANIMATION_STEPS`).
+void Display::drawTray(unsigned int lines)
+{
+    m_display.clearDisplay();
+    m_display.fillRoundRect(5, -10, 118, 20, 5, WHITE);
+
+    if (lines > 0)
+        m_display.fillRect(28, 11, 73, lines, WHITE);
 }
\ No newline at end of file
@@ -29,7 +29,304 @@ enum MenuIcons
 };
 
 struct Music;
-class Television;
+
+// Découpage de l'écran pour les mises à jour partielles : 8 pages de 8 lignes, découpées en blocs de 16 colonnes.
+#define SSD1306_PAGES_NUMBER 8
+#define SSD1306_BLOCK_WIDTH 16
+#define SSD1306_BLOCKS_NUMBER 8
+#define SSD1306_MAXIMUM_WIDTH 128
+
+// Durée maximale (en µs) consacrée à l'envoi de l'écran à chaque passage dans la boucle.
+#define DISPLAY_FLUSH_BUDGET 500
+
+// Durée maximale d'une étape d'une transaction I2C avec l'écran (en µs), au-delà de laquelle le bus est considéré comme bloqué.
+#define SSD1306_TRANSFER_TIMEOUT 25000
+
+// Nombre de lignes de l'animation du plateau.
+#define DISPLAY_TRAY_ANIMATION_STEPS 40
+
+// Durée (en ms) de l'animation de mise en marche ou d'arrêt d'un périphérique.
+#define DISPLAY_DEVICE_STATE_ANIMATION_DURATION 250
+
+// Période minimale entre deux images d'une animation (en ms, soit 25 images par seconde) et durée de dessin allouée à chaque période (en µs).
+#define DISPLAY_ANIMATION_FRAME_PERIOD 40
+#define DISPLAY_ANIMATION_RENDER_BUDGET 4000
+
+// Avancement d'une animation terminée.
+#define DISPLAY_ANIMATION_FULL_PROGRESS 1000
+
+// Durées minimales d'affichage (en ms) des écrans prioritaires : pendant ce temps, les écrans de priorité inférieure ou égale sont mis en attente (ou ignorés pour les menus, que le clavier redessine ensuite).
+#define DISPLAY_NOTIFICATION_DURATION 3000
+#define DISPLAY_DOORBELL_DURATION 5000
+#define DISPLAY_ALARM_DURATION 10000
+
+// Nombre d'écrans pouvant être mis en attente.
+#define DISPLAY_QUEUE_SIZE 4
+
+// Défilement des messages trop longs : ordonnée du texte sous le titre, ordonnée maximale d'une ligne entièrement visible et délai (en ms) entre deux lignes.
+#define DISPLAY_MESSAGE_FIRST_LINE 10
+#define DISPLAY_MESSAGE_LAST_LINE 56
+#define DISPLAY_MARQUEE_PERIOD 1000
+
+/// @brief Étapes de l'envoi d'une transaction I2C à l'écran.
+enum SSD1306TransferState
+{
+    TRANSFER_IDLE,
+    TRANSFER_BEGIN,
+    TRANSFER_ADDRESS,
+    TRANSFER_DATA,
+    TRANSFER_STOP,
+};
+
+/// @brief Écran SSD1306 qui n'envoie que les blocs modifiés depuis le dernier affichage, en arrière-plan : les blocs touchés par un dessin sont marqués, comparés à l'aide d'une somme de contrôle au contenu déjà envoyé, puis transmis par petites étapes depuis la boucle.
+class SSD1306PartialDisplay : public Adafruit_SSD1306
+{
+public:
+    SSD1306PartialDisplay(uint8_t width, uint8_t height, TwoWire *twi, int8_t resetPin);
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void clearDisplay();
+    void drawCompressedBitmap(const uint8_t *bitmap, uint16_t color);
+    void invertDisplay(bool inverted);
+    void dim(bool dimmed);
+    void display();
+    void displayNow();
+    bool update(unsigned int budget);
+    bool isFlushPending() const;
+    void waitForFlush();
+    void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+    void scrollPage();
+    unsigned long getTransferredBytes() const;
+    unsigned long getDroppedDrawings() const;
+
+protected:
+    bool startRegion();
+    bool isBlockChanged(uint8_t page, uint8_t block);
+    void stepTransfer();
+    void abortTransfer();
+    void checkTransferTimeout();
+    uint16_t getBlockChecksum(uint8_t page, uint8_t block) const;
+
+    uint8_t m_dirtyBlocks[SSD1306_PAGES_NUMBER];
+    uint8_t m_contentBlocks[SSD1306_PAGES_NUMBER];
+    uint16_t m_blockChecksums[SSD1306_PAGES_NUMBER][SSD1306_BLOCKS_NUMBER];
+    bool m_fullRefresh;
+    unsigned long m_transferredBytes;
+    bool m_flushPending;
+    bool m_flushRequested;
+    bool m_transferError;
+    uint8_t m_flushPage;
+    uint8_t m_flushBlock;
+    SSD1306TransferState m_transferState;
+    uint8_t m_transaction;
+    uint8_t m_position;
+    uint8_t m_regionCommands[7];
+    uint8_t m_regionData[SSD1306_MAXIMUM_WIDTH + 1];
+    uint8_t m_regionDataLength;
+    uint8_t m_startPage;
+    unsigned long m_stateTime;
+};
+
+// Capacité de la liste de commandes de l'affichage page par page : nombre de commandes et de caractères mémorisés pour l'écran en cours.
+#define SSD1306_PAGE_COMMANDS_NUMBER 24
+#define SSD1306_PAGE_TEXT_SIZE 168
+
+// Taille des paquets de données envoyés par la bibliothèque Wire (sa mémoire tampon contient 32 octets, dont l'octet de contrôle).
+#define SSD1306_PAGE_I2C_CHUNK_SIZE 31
+
+/// @brief Types de commandes de dessin mémorisées par l'affichage page par page.
+enum SSD1306PageCommandType
+{
+    PAGE_COMMAND_FILL_RECT,
+    PAGE_COMMAND_RECT,
+    PAGE_COMMAND_LINE,
+    PAGE_COMMAND_CIRCLE,
+    PAGE_COMMAND_FILL_CIRCLE,
+    PAGE_COMMAND_ROUND_RECT,
+    PAGE_COMMAND_FILL_ROUND_RECT,
+    PAGE_COMMAND_TEXT,
+    PAGE_COMMAND_BITMAP,
+};
+
+/// @brief Commande de dessin mémorisée par l'affichage page par page. Pour une ligne, `width` et `height` contiennent les coordonnées de la seconde extrémité ; pour un cercle ou un rectangle arrondi, `size` contient le rayon ; pour un texte, `data` pointe vers ses glyphes, `width` contient leur nombre et `size` la taille du texte.
+struct SSD1306PageCommand
+{
+    uint8_t type;
+    uint8_t color;
+    uint8_t size;
+    int16_t x;
+    int16_t y;
+    int16_t width;
+    int16_t height;
+    const uint8_t *data;
+};
+
+/// @brief Écran SSD1306 sans mémoire tampon complète : les dessins sont mémorisés dans une courte liste de commandes, puis rejoués pour chacune des 8 pages de l'écran dans une mémoire tampon de 128 octets au moment de l'affichage. Seuls les blocs modifiés sont envoyés, de manière bloquante.
+class SSD1306PageDisplay : public Adafruit_GFX
+{
+public:
+    SSD1306PageDisplay(uint8_t width, uint8_t height, TwoWire *twi, int8_t resetPin);
+    bool begin(uint8_t vccState, uint8_t address);
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) override;
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawCircle(int16_t x, int16_t y, int16_t r, uint16_t color);
+    void fillCircle(int16_t x, int16_t y, int16_t r, uint16_t color);
+    void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+    void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+    size_t write(uint8_t c) override;
+    using Print::write;
+    void drawCompressedBitmap(const uint8_t *bitmap, uint16_t color);
+    void clearDisplay();
+    void invertDisplay(bool inverted);
+    void dim(bool dimmed);
+    void display();
+    void displayNow();
+    bool update(unsigned int budget);
+    bool isFlushPending() const;
+    void waitForFlush();
+    void scrollPage();
+    unsigned long getTransferredBytes() const;
+    unsigned long getDroppedDrawings() const;
+
+protected:
+    SSD1306PageCommand *addCommand(SSD1306PageCommandType type, int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color, uint8_t size = 0);
+    bool isCommandOnPage(const SSD1306PageCommand &command, uint8_t page) const;
+    void renderPage(uint8_t page);
+    void renderCommand(const SSD1306PageCommand &command);
+    void renderBitmap(const uint8_t *bitmap, uint16_t color);
+    void renderRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void sendCommands(const uint8_t *commands, uint8_t length);
+    void sendRegion(uint8_t page, uint8_t firstColumn, uint8_t lastColumn);
+    uint16_t getBlockChecksum(uint8_t block) const;
+
+    TwoWire *m_wire;
+    uint8_t m_address;
+    uint8_t m_vccState;
+    SSD1306PageCommand m_commands[SSD1306_PAGE_COMMANDS_NUMBER];
+    uint8_t m_commandsNumber;
+    uint8_t m_text[SSD1306_PAGE_TEXT_SIZE];
+    uint8_t m_textLength;
+    uint8_t m_page[SSD1306_MAXIMUM_WIDTH];
+    uint8_t m_renderedPage;
+    bool m_rendering;
+    uint16_t m_blockChecksums[SSD1306_PAGES_NUMBER][SSD1306_BLOCKS_NUMBER];
+    bool m_fullRefresh;
+    unsigned long m_transferredBytes;
+    unsigned long m_droppedDrawings;
+    uint8_t m_startPage;
+};
+
+// Affichage utilisé par l'écran : `SSD1306PartialDisplay` par défaut, ou `SSD1306PageDisplay` pour libérer la mémoire tampon complète de la SRAM (option de compilation `-D DISPLAY_PAGE_MODE=1`).
+// Mémoire occupée (tailles des types sur AVR) : `SSD1306PartialDisplay` utilise 300 octets de variables en plus de celles d'`Adafruit_SSD1306`, et alloue au démarrage 1024 octets sur le tas pour la mémoire tampon ; `SSD1306PageDisplay` utilise 754 octets de variables et n'alloue rien.
+// Le rapport de `pio run` ne compte que les variables (environnements `megaatmega2560` et `megaatmega2560_page`) : la mémoire tampon n'apparaît que dans la RAM disponible affichée par le menu des paramètres.
+#ifndef DISPLAY_PAGE_MODE
+#define DISPLAY_PAGE_MODE 0
+#endif
+
+#if DISPLAY_PAGE_MODE
+typedef SSD1306PageDisplay DisplayBackend;
+#else
+typedef SSD1306PartialDisplay DisplayBackend;
+#endif
+
+// Premier point de code de la table de correspondance Latin-1 → page de code 437 (les points de code inférieurs à 0x80 sont identiques).
+#define UTF8_LATIN1_FIRST_CODE_POINT 0xA0
+
+// Glyphe affiché pour les caractères sans équivalent dans la police de l'écran.
+#define UTF8_UNKNOWN_GLYPH '?'
+
+// Nombre maximal de glyphes d'un texte centré (une ligne complète avec la plus petite taille de texte).
+#define DISPLAY_CENTERED_TEXT_SIZE 21
+
+/// @brief Décodeur UTF-8 progressif : les octets d'un texte sont fournis un par un, et chaque caractère complet est converti en glyphe de la police de l'écran (page de code 437).
+class UTF8Decoder
+{
+public:
+    UTF8Decoder();
+    bool decode(uint8_t byte, uint8_t &glyph);
+    static uint8_t getGlyph(unsigned long codePoint);
+
+protected:
+    unsigned long m_codePoint;
+    uint8_t m_remainingBytes;
+};
+
+/// @brief Priorités des écrans : un écran ne peut remplacer, pendant sa durée minimale d'affichage, qu'un écran de priorité inférieure.
+enum DisplayPriority
+{
+    PRIORITY_MENU,
+    PRIORITY_NOTIFICATION,
+    PRIORITY_DOORBELL,
+    PRIORITY_ALARM,
+};
+
+/// @brief Écrans pouvant être affichés, utilisés pour identifier leur contenu.
+enum DisplayScreen
+{
+    SCREEN_NONE,
+    SCREEN_MESSAGE,
+    SCREEN_BELL,
+    SCREEN_ALARM_TRIGGERED,
+    SCREEN_VOLUME,
+    SCREEN_AIR_VALUES,
+    SCREEN_ANALOG_SENSOR,
+    SCREEN_BINARY_SENSOR,
+    SCREEN_LED_STATE,
+    SCREEN_KEYPAD_MENU,
+    SCREEN_LIGHT_COLOR_TEMPERATURE,
+    SCREEN_LUMINOSITY,
+    SCREEN_PERCENTAGE,
+    SCREEN_SELECTED_MUSIC,
+};
+
+/// @brief Structure stockant un écran mis en attente (message, sonnette ou alarme) en attendant la fin de l'écran prioritaire affiché.
+struct DisplayRequest
+{
+    DisplayScreen screen;
+    DisplayPriority priority;
+    unsigned int duration;
+    uint16_t signature;
+    bool colorsInverted;
+    String message;
+    String title;
+};
+
+/// @brief Animations pouvant être jouées par l'écran.
+enum DisplayAnimationType
+{
+    ANIMATION_NONE,
+    ANIMATION_DEVICE_ON,
+    ANIMATION_DEVICE_OFF,
+    ANIMATION_TRAY_OPENING,
+    ANIMATION_TRAY_CLOSING,
+};
+
+/// @brief Moteur d'animation de l'écran : l'avancement est calculé à partir du temps écoulé (les images en retard sont sautées), le nombre d'images par seconde est limité, et les images trop longues à dessiner espacent les suivantes.
+class DisplayAnimation
+{
+public:
+    DisplayAnimation();
+    void start(DisplayAnimationType type, unsigned int duration);
+    void stop();
+    bool isRunning() const;
+    DisplayAnimationType getType() const;
+    bool nextFrame(unsigned int &progress);
+    void endFrame(unsigned long renderTime);
+    static int tween(int from, int to, unsigned int progress);
+
+protected:
+    DisplayAnimationType m_type;
+    unsigned long m_startTime;
+    unsigned int m_duration;
+    unsigned long m_lastFrameTime;
+    unsigned long m_framePeriod;
+};
 
 // Classe regroupant les méthodes de contrôle de l'écran.
 class Display : public Device
@@ -49,26 +346,61 @@ public:
     virtual void displayDeviceState(bool on);
     virtual void displayKeypadMenu(MenuIcons menuIcon, const __FlashStringHelper *menuName);
     virtual void displayKeypadMenuHelp(const __FlashStringHelper **menuHelpList, const __FlashStringHelper *menuName);
-    virtual void displayTray(bool on, bool shareInformation = false);
+    virtual void displayTray(bool opening, unsigned int duration);
     virtual void displayLightColorTemperature(int minimum, int maximum, int temperature);
     virtual void displayLuminosity(int luminosity);
     virtual void displayPercentage(String name, int value);
-    virtual void displaySelectedMusic(Television &television, unsigned int musicIndex);
+    virtual void displaySelectedMusic(const Music *const *musicList, unsigned int musicsNumber, unsigned int musicIndex);
     virtual void loop() override;
     virtual void shutdown() override;
+    virtual unsigned long getRenderTime() const;
+    virtual unsigned long getTransferredBytes() const;
+    virtual unsigned long getDroppedDrawings() const;
+    virtual bool isRedrawPending() const;
 
 protected:
+    virtual void printAccents(const char *text, bool flash = false);
+    virtual void printAccents(const __FlashStringHelper *text);
     virtual void printAccents(const String &string);
+    virtual void printCenteredAccents(const char *text, int textSize, int y, bool flash = false);
+    virtual void printCenteredAccents(const __FlashStringHelper *text, int textSize, int y);
     virtual void printCenteredAccents(const String &string, int textSize, int y);
     virtual void resetDisplay(bool resetHelpMenu = true);
     virtual void display();
+    virtual bool acquireScreen(DisplayPriority priority, unsigned int duration, uint16_t signature);
+    virtual void enqueueRequest(const DisplayRequest &request);
+    virtual void processQueue();
+    virtual void drawMessage(const String &message, const String &title);
+    virtual int16_t renderMessage(const String &message, const String &title, uint8_t line);
+    virtual void updateMarquee();
+    virtual void stopMarquee();
+    virtual void drawBell();
+    virtual void drawAlarmTriggered(bool colorsInverted);
+    static uint16_t getSignature(uint16_t seed, const void *data, unsigned int length);
+    virtual void updateAnimation();
+    virtual void drawAnimationFrame(DisplayAnimationType type, unsigned int progress);
+    virtual void drawDeviceState(int position, bool on);
+    virtual void drawTray(unsigned int lines);
 
-    Adafruit_SSD1306 m_display;
+    DisplayBackend m_display;
     unsigned long m_lastTime;
     const __FlashStringHelper **m_menuHelpList;
     int m_menuHelpMenu;
-    bool m_deviceStateAnimationType;
-    int m_deviceStateAnimationStep;
+    DisplayAnimation m_animation;
+    DisplayPriority m_screenPriority;
+    unsigned long m_screenTime;
+    unsigned int m_screenDuration;
+    uint16_t m_screenSignature;
+    bool m_redrawPending;
+    DisplayRequest m_queue[DISPLAY_QUEUE_SIZE];
+    uint8_t m_queueLength;
+    unsigned long m_renderStart;
+    unsigned long m_renderTime;
+    String m_marqueeMessage;
+    String m_marqueeTitle;
+    uint8_t m_marqueeLine;
+    uint8_t m_marqueeLines;
+    unsigned long m_marqueeTime;
 };
 
 #endif
\ No newline at end of file
@@ -61,7 +61,7 @@ Keypad::Keypad(const __FlashStringHelper *friendlyName, unsigned int ID, Display
 /// @param airSensorsNumber Le nombre de capteurs d'air.
 /// @param wardrobeDoorSensorList La liste des capteurs de portes d'armoire.
 /// @param wardrobeDoorSensorsNumber Le nombre de capteurs de portes d'armoire.
-void Keypad::setDevices(Output *deviceList[], int &devicesNumber, Output *lightList[], int &lightsNumber, RGBLEDStrip *RGBLEDStripList[], ColorMode *colorModeList[], RainbowMode *rainbowModeList[], SoundreactMode *soundreactModeList[], AlarmMode *alarmModeList[], int &RGBLEDStripsNumber, ConnectedTemperatureVariableLight *connectedTemperatureVariableLightList[], int &connectedTemperatureVariableLightsNumber, ConnectedColorVariableLight *connectedColorVariableLightList[], int &connectedColorVariableLightsNumber, Television *televisionList[], int &televisionsNumber, Alarm *alarmList[], int &alarmsNumber, BinaryInput *binaryInputList[], int &binaryInputsNumber, AnalogInput *analogInputList[], int &analogInputsNumber, AirSensor *airSensorList[], int &airSensorsNumber, WardrobeDoorSensor *wardrobeDoorSensorList[], int &wardrobeDoorSensorsNumber)
+void Keypad::setDevices(Output *deviceList[], int &devicesNumber, Output *lightList[], int &lightsNumber, RGBLEDStrip *RGBLEDStripList[], ColorMode *colorModeList[], RainbowMode *rainbowModeList[], SoundreactMode *soundreactModeList[], AlarmMode *alarmModeList[], SpectrumMode *spectrumModeList[], int &RGBLEDStripsNumber, ConnectedTemperatureVariableLight *connectedTemperatureVariableLightList[], int &connectedTemperatureVariableLightsNumber, ConnectedColorVariableLight *connectedColorVariableLightList[], int &connectedColorVariableLightsNumber, Television *televisionList[], int &televisionsNumber, Alarm *alarmList[], int &alarmsNumber, BinaryInput *binaryInputList[], int &binaryInputsNumber, AnalogInput *analogInputList[], int &analogInputsNumber, AirSensor *airSensorList[], int &airSensorsNumber, WardrobeDoorSensor *wardrobeDoorSensorList[], int &wardrobeDoorSensorsNumber)
 {
     KeypadMenu *previousMenu = nullptr;
 
@@ -136,7 +136,7 @@ void Keypad::setDevices(Output *deviceList[], int &devicesNumber, Output *lightL
                 RGBLEDStrip *strip = RGBLEDStripList[index];
 
                 KeypadMenuRGBLEDStripControl *menu = new KeypadMenuRGBLEDStripControl(strip->getFriendlyName(), *this);
-                menu->setStrip(strip, colorModeList[index], rainbowModeList[index], soundreactModeList[index], alarmModeList[index]);
+                menu->setStrip(strip, colorModeList[index], rainbowModeList[index], soundreactModeList[index], alarmModeList[index], spectrumModeList[index]);
                 menu->setParentMenu(lightsMenu);
 
                 lightsInCurrentMenu[j] = strip;
@@ -356,6 +356,10 @@ void Keypad::loop()
     if (!(m_currentMenu == m_mainMenu) && ((m_lastInteraction + 600000) <= millis()))
         setMenu(m_mainMenu);
 
+    // Le menu ignoré pendant l'affichage d'une notification est redessiné à sa fin.
+    if (m_display.isRedrawPending())
+        m_currentMenu->displayMenu();
+
     // Si une action est détectée.
     while (m_keypad.available())
     {
@@ -590,9 +594,9 @@ void KeypadMenuLightList::displayMenu()
     m_keypad.getDisplay().displayKeypadMenu(LIGHTS, m_friendlyName);
 }
 
-KeypadMenuRGBLEDStripControl::KeypadMenuRGBLEDStripControl(const __FlashStringHelper *friendlyName, Keypad &keypad) : KeypadMenu(friendlyName, keypad), m_strip(nullptr), m_colorMode(nullptr), m_rainbowMode(nullptr), m_soundreactMode(nullptr), m_alarmMode(nullptr) {}
+KeypadMenuRGBLEDStripControl::KeypadMenuRGBLEDStripControl(const __FlashStringHelper *friendlyName, Keypad &keypad) : KeypadMenu(friendlyName, keypad), m_strip(nullptr), m_colorMode(nullptr), m_rainbowMode(nullptr), m_soundreactMode(nullptr), m_alarmMode(nullptr), m_spectrumMode(nullptr) {}
 
-void KeypadMenuRGBLEDStripControl::setStrip(RGBLEDStrip *strip, ColorMode *colorMode, RainbowMode *rainbowMode, SoundreactMode *soundreactMode, AlarmMode *alarmMode)
+void KeypadMenuRGBLEDStripControl::setStrip(RGBLEDStrip *strip, ColorMode *colorMode, RainbowMode *rainbowMode, SoundreactMode *soundreactMode, AlarmMode *alarmMode, SpectrumMode *spectrumMode)
 {
     m_strip = strip;
 
@@ -604,15 +608,19 @@ void KeypadMenuRGBLEDStripControl::setStrip(RGBLEDStrip *strip, ColorMode *color
     m_soundreactMode->setParentMenu(this);
     m_alarmMode = new KeypadMenuRGBLEDStripAlarmModeControl(alarmMode->getFriendlyName(), m_keypad, *alarmMode);
     m_alarmMode->setParentMenu(this);
+    m_spectrumMode = new KeypadMenuRGBLEDStripSpectrumModeControl(spectrumMode->getFriendlyName(), m_keypad, *spectrumMode);
+    m_spectrumMode->setParentMenu(this);
 
     m_colorMode->setNextMenu(m_rainbowMode);
-    m_colorMode->setPreviousMenu(m_alarmMode);
+    m_colorMode->setPreviousMenu(m_spectrumMode);
     m_rainbowMode->setNextMenu(m_soundreactMode);
     m_rainbowMode->setPreviousMenu(m_colorMode);
     m_soundreactMode->setNextMenu(m_alarmMode);
     m_soundreactMode->setPreviousMenu(m_rainbowMode);
-    m_alarmMode->setNextMenu(m_colorMode);
+    m_alarmMode->setNextMenu(m_spectrumMode);
     m_alarmMode->setPreviousMenu(m_soundreactMode);
+    m_spectrumMode->setNextMenu(m_colorMode);
+    m_spectrumMode->setPreviousMenu(m_alarmMode);
 }
 
 void KeypadMenuRGBLEDStripControl::keyReleased(char key, bool longClick)
@@ -661,6 +669,15 @@ void KeypadMenuRGBLEDStripControl::keyReleased(char key, bool longClick)
             m_keypad.setMenu(m_alarmMode, true);
 
         break;
+
+    case '6':
+        if (!longClick)
+            m_strip->setMode(&m_spectrumMode->getSpectrumMode(), true);
+
+        else
+            m_keypad.setMenu(m_spectrumMode, true);
+
+        break;
     }
 }
 
@@ -673,6 +690,7 @@ void KeypadMenuRGBLEDStripControl::displayHelp()
     help[2] = F("Arc-en-ciel");
     help[3] = F("Son-réaction");
     help[4] = F("Alarme");
+    help[5] = F("Spectre");
 
     m_keypad.getDisplay().displayKeypadMenuHelp(help, m_friendlyName);
 }
@@ -939,6 +957,29 @@ void KeypadMenuRGBLEDStripAlarmModeControl::displayMenu()
     m_keypad.getDisplay().displayKeypadMenu(CONTROLS, m_friendlyName);
 }
 
+KeypadMenuRGBLEDStripSpectrumModeControl::KeypadMenuRGBLEDStripSpectrumModeControl(const __FlashStringHelper *friendlyName, Keypad &keypad, SpectrumMode &spectrumMode) : KeypadMenu(friendlyName, keypad), m_spectrumMode(spectrumMode) {}
+
+SpectrumMode &KeypadMenuRGBLEDStripSpectrumModeControl::getSpectrumMode()
+{
+    return m_spectrumMode;
+}
+
+void KeypadMenuRGBLEDStripSpectrumModeControl::keyReleased(char key, bool longClick)
+{
+    // Rien...
+}
+
+void KeypadMenuRGBLEDStripSpectrumModeControl::displayHelp()
+{
+    const __FlashStringHelper *help[10] = {nullptr};
+    m_keypad.getDisplay().displayKeypadMenuHelp(help, m_friendlyName);
+}
+
+void KeypadMenuRGBLEDStripSpectrumModeControl::displayMenu()
+{
+    m_keypad.getDisplay().displayKeypadMenu(CONTROLS, m_friendlyName);
+}
+
 KeypadMenuConnectedTemperatureVariableLightControl::KeypadMenuConnectedTemperatureVariableLightControl(const __FlashStringHelper *friendlyName, Keypad &keypad) : KeypadMenu(friendlyName, keypad), m_temperatureMenu(nullptr), m_luminosityMenu(nullptr) {}
 
 void KeypadMenuConnectedTemperatureVariableLightControl::setLight(ConnectedTemperatureVariableLight &light)
@@ -1367,7 +1408,7 @@ void KeypadMenuTelevisionMusicSelector::keyReleased(char key, bool longClick)
             break;
 
         m_index--;
-        m_keypad.getDisplay().displaySelectedMusic(*m_television, m_index);
+        m_keypad.getDisplay().displaySelectedMusic(m_television->getMusicsList(), m_television->getMusicNumber(), m_index);
         break;
 
     case '5':
@@ -1379,7 +1420,7 @@ void KeypadMenuTelevisionMusicSelector::keyReleased(char key, bool longClick)
             break;
 
         m_index++;
-        m_keypad.getDisplay().displaySelectedMusic(*m_television, m_index);
+        m_keypad.getDisplay().displaySelectedMusic(m_television->getMusicsList(), m_television->getMusicNumber(), m_index);
         break;
     }
 }
@@ -1708,6 +1749,10 @@ void KeypadMenuSettings::keyReleased(char key, bool longClick)
     case '5':
         m_keypad.getDisplay().displayMessage("Actuel : " + String(TPS), "TPS");
         break;
+
+    case '6':
+        m_keypad.getDisplay().displayMessage("Ignorés : " + String(m_keypad.getDisplay().getDroppedDrawings()), "Dessins");
+        break;
     }
 }
 
@@ -1720,6 +1765,7 @@ void KeypadMenuSettings::displayHelp()
     help[2] = F("Redémarrer le système");
     help[3] = F("RAM disponible");
     help[4] = F("TPS actuel");
+    help[5] = F("Dessins ignorés");
 
     m_keypad.getDisplay().displayKeypadMenuHelp(help, m_friendlyName);
 }
@@ -28,7 +28,7 @@ public:
     virtual void setDevices(
         Output *deviceList[], int &devicesNumber,
         Output *lightList[], int &lightsNumber,
-        RGBLEDStrip *RGBLEDStripList[], ColorMode *colorModeList[], RainbowMode *rainbowModeList[], SoundreactMode *soundreactModeList[], AlarmMode *alarmModeList[], int &RGBLEDStripsNumber,
+        RGBLEDStrip *RGBLEDStripList[], ColorMode *colorModeList[], RainbowMode *rainbowModeList[], SoundreactMode *soundreactModeList[], AlarmMode *alarmModeList[], SpectrumMode *spectrumModeList[], int &RGBLEDStripsNumber,
         ConnectedTemperatureVariableLight *connectedTemperatureVariableLightList[], int &connectedTemperatureVariableLightsNumber,
         ConnectedColorVariableLight *connectedColorVariableLightList[], int &connectedColorVariableLightsNumber,
         Television *televisionList[], int &televisionsNumber,
@@ -173,12 +173,27 @@ protected:
     AlarmMode &m_alarmMode;
 };
 
+class KeypadMenuRGBLEDStripSpectrumModeControl : public KeypadMenu
+{
+public:
+    KeypadMenuRGBLEDStripSpectrumModeControl(const __FlashStringHelper *friendlyName, Keypad &keypad, SpectrumMode &spectrumMode);
+
+    virtual SpectrumMode &getSpectrumMode();
+
+    virtual void keyReleased(char key, bool longClick) override;
+    virtual void displayHelp() override;
+    virtual void displayMenu() override;
+
+protected:
+    SpectrumMode &m_spectrumMode;
+};
+
 class KeypadMenuRGBLEDStripControl : public KeypadMenu
 {
 public:
     KeypadMenuRGBLEDStripControl(const __FlashStringHelper *friendlyName, Keypad &keypad);
 
-    virtual void setStrip(RGBLEDStrip *strip, ColorMode *colorMode, RainbowMode *rainbowMode, SoundreactMode *soundreactMode, AlarmMode *alarmMode);
+    virtual void setStrip(RGBLEDStrip *strip, ColorMode *colorMode, RainbowMode *rainbowMode, SoundreactMode *soundreactMode, AlarmMode *alarmMode, SpectrumMode *spectrumMode);
 
     virtual void keyReleased(char key, bool longClick) override;
     virtual void displayHelp() override;
@@ -191,6 +206,7 @@ protected:
     KeypadMenuRGBLEDStripRainbowModeControl *m_rainbowMode;
     KeypadMenuRGBLEDStripSoundreactModeControl *m_soundreactMode;
     KeypadMenuRGBLEDStripAlarmModeControl *m_alarmMode;
+    KeypadMenuRGBLEDStripSpectrumModeControl *m_spectrumMode;
 };
 
 class KeypadMenuConnectedLightLuminosityControl : public KeypadMenu
@@ -17,6 +17,16 @@
 #include "device/interface/HomeAssistant.hpp"
 #include "utils/gammaCorrection.hpp"
 
+// Ruban de DEL dont le tramage temporel est cadencé par l'interruption du timer 3.
+static RGBLEDStrip *ditheredStrip = nullptr;
+
+// Le timer 3 gère les broches PWM 2, 3 et 5 de l'Arduino Méga : son débordement marque le début de chaque trame PWM (environ 490 Hz).
+ISR(TIMER3_OVF_vect)
+{
+    if (ditheredStrip != nullptr)
+        ditheredStrip->updateDithering();
+}
+
 /// @brief Constructeur de la classe.
 /// @param friendlyName Le nom formaté pour être présenté à l'utilisateur du périphérique.
 /// @param ID L'identifiant unique du périphérique utilisé pour communiquer avec Home Assistant.
@@ -25,7 +35,7 @@
 /// @param RPin La broche liée à l'alimentation du rouge des rubans de DEL.
 /// @param GPin La broche liée à l'alimentation du vert des rubans de DEL.
 /// @param BPin La broche liée à l'alimentation du bleu des rubans de DEL.
-RGBLEDStrip::RGBLEDStrip(const __FlashStringHelper *friendlyName, unsigned int ID, HomeAssistant &connection, Display &display, unsigned int RPin, unsigned int GPin, unsigned int BPin) : Output(friendlyName, ID, connection, display), m_RPin(RPin), m_GPin(GPin), m_BPin(BPin), m_RState(0), m_GState(0), m_BState(0), m_mode(nullptr) {}
+RGBLEDStrip::RGBLEDStrip(const __FlashStringHelper *friendlyName, unsigned int ID, HomeAssistant &connection, Display &display, unsigned int RPin, unsigned int GPin, unsigned int BPin) : Output(friendlyName, ID, connection, display), m_RPin(RPin), m_GPin(GPin), m_BPin(BPin), m_RState(0), m_GState(0), m_BState(0), m_RChannel(), m_GChannel(), m_BChannel(), m_mode(nullptr), m_outgoingMode(nullptr), m_outgoingFrame(), m_incomingFrame(), m_renderTarget(nullptr), m_transitionStart(0), m_transitionDuration(RGB_LED_STRIP_TRANSITION_DURATION) {}
 
 /// @brief Initialise l'objet.
 void RGBLEDStrip::setup()
@@ -39,6 +49,14 @@ void RGBLEDStrip::setup()
     pinMode(m_GPin, OUTPUT);
     pinMode(m_BPin, OUTPUT);
 
+    setupChannel(m_RChannel, m_RPin);
+    setupChannel(m_GChannel, m_GPin);
+    setupChannel(m_BChannel, m_BPin);
+
+    // Activation du tramage temporel, qui répartit la partie fractionnaire des intensités sur les trames PWM successives.
+    ditheredStrip = this;
+    TIMSK3 |= _BV(TOIE3);
+
     m_operational = true;
     m_connection.updateDeviceAvailability(m_ID, true);
 }
@@ -79,6 +97,9 @@ void RGBLEDStrip::turnOff(bool shareInformation)
     if (!m_operational || m_locked || !m_state)
         return;
 
+    if (m_outgoingMode != nullptr)
+        finishTransition();
+
     m_mode->desactivate();
     setColor(0, 0, 0);
     m_state = false;
@@ -93,6 +114,12 @@ void RGBLEDStrip::loop()
     if (!m_operational || !m_state)
         return;
 
+    if (m_outgoingMode != nullptr)
+    {
+        updateTransition();
+        return;
+    }
+
     m_mode->loop();
 }
 
@@ -104,11 +131,28 @@ void RGBLEDStrip::setMode(RGBLEDStripMode *mode, bool shareInformation)
     if (m_locked || mode == m_mode)
         return;
 
-    if (m_mode != nullptr && m_operational && m_state)
-        m_mode->desactivate();
+    // Une transition encore en cours est terminée immédiatement : le nouveau fondu part de la couleur affichée.
+    if (m_outgoingMode != nullptr)
+        finishTransition();
 
+    RGBLEDStripMode *previousMode = m_mode;
     m_mode = mode;
 
+    if (previousMode != nullptr && m_operational && m_state)
+    {
+        // L'ancien mode continue de s'exécuter dans une sortie virtuelle pendant le fondu, au lieu de passer par le noir.
+        if (m_mode != nullptr && m_transitionDuration > 0)
+        {
+            m_outgoingMode = previousMode;
+            m_outgoingFrame = {m_RChannel.value, m_GChannel.value, m_BChannel.value};
+            m_incomingFrame = {0, 0, 0};
+            m_transitionStart = millis();
+        }
+
+        else
+            previousMode->desactivate();
+    }
+
     if (m_mode == nullptr)
         return;
 
@@ -118,7 +162,7 @@ void RGBLEDStrip::setMode(RGBLEDStripMode *mode, bool shareInformation)
     if (m_operational && m_state)
     {
         m_mode->activate();
-        m_connection.updateRGBLEDStripMode(m_ID, m_mode->getID(), m_RState, m_GState, m_BState);
+        m_connection.updateRGBLEDStripMode(m_ID, m_mode->getID(), this->getR(), this->getG(), this->getB());
     }
 }
 
@@ -133,6 +177,10 @@ RGBLEDStripMode *RGBLEDStrip::getMode() const
 /// @return L'intensité actuelle du rouge du ruban de DEL RVB.
 unsigned int RGBLEDStrip::getR() const
 {
+    const RGBLEDStripFrame *target = this->getRenderTarget();
+    if (target != nullptr)
+        return target->r >> 8;
+
     return m_RState;
 }
 
@@ -140,6 +188,10 @@ unsigned int RGBLEDStrip::getR() const
 /// @return L'intensité actuelle du vert du ruban de DEL RVB.
 unsigned int RGBLEDStrip::getG() const
 {
+    const RGBLEDStripFrame *target = this->getRenderTarget();
+    if (target != nullptr)
+        return target->g >> 8;
+
     return m_GState;
 }
 
@@ -147,14 +199,256 @@ unsigned int RGBLEDStrip::getG() const
 /// @return L'intensité actuelle du bleu du ruban de DEL RVB.
 unsigned int RGBLEDStrip::getB() const
 {
+    const RGBLEDStripFrame *target = this->getRenderTarget();
+    if (target != nullptr)
+        return target->b >> 8;
+
     return m_BState;
 }
 
-void RGBLEDStrip::setColor(unsigned int r, unsigned int g, unsigned int b)
+/// @brief Définit la durée du fondu enchaîné lors d'un changement de mode.
+/// @param duration La durée du fondu en millisecondes (`0` pour un changement immédiat).
+void RGBLEDStrip::setTransitionDuration(unsigned int duration)
 {
-    if (!m_operational || !m_state)
+    m_transitionDuration = duration;
+}
+
+/// @brief Méthode renvoyant la durée du fondu enchaîné lors d'un changement de mode.
+/// @return La durée du fondu en millisecondes.
+unsigned int RGBLEDStrip::getTransitionDuration() const
+{
+    return m_transitionDuration;
+}
+
+/// @brief Méthode exécutée à chaque trame PWM depuis l'interruption du timer 3 : applique le tramage temporel aux trois couleurs.
+void RGBLEDStrip::updateDithering()
+{
+    writeChannel(m_RChannel, dither(m_RChannel));
+    writeChannel(m_GChannel, dither(m_GChannel));
+    writeChannel(m_BChannel, dither(m_BChannel));
+}
+
+/// @brief Résout une seule fois les registres du timer associé à une broche, afin d'éviter la recherche effectuée par `analogWrite` à chaque écriture.
+/// @param channel La couleur à initialiser.
+/// @param pin La broche PWM liée à la couleur.
+void RGBLEDStrip::setupChannel(RGBLEDStripChannel &channel, unsigned int pin)
+{
+    channel.timerControlRegister = nullptr;
+    channel.outputCompareMode = 0;
+    channel.fastPWM = false;
+    channel.connected = false;
+    channel.outputCompareRegister8 = nullptr;
+    channel.outputCompareRegister16 = nullptr;
+    channel.portRegister = portOutputRegister(digitalPinToPort(pin));
+    channel.pinMask = digitalPinToBitMask(pin);
+    channel.value = 0;
+    channel.intensity = 0;
+    channel.error = 0;
+    channel.duty = -1;
+
+    switch (digitalPinToTimer(pin))
+    {
+    case TIMER0A:
+        channel.timerControlRegister = &TCCR0A;
+        channel.outputCompareMode = _BV(COM0A1);
+        channel.outputCompareRegister8 = &OCR0A;
+        channel.fastPWM = true;
+        break;
+
+    case TIMER0B:
+        channel.timerControlRegister = &TCCR0A;
+        channel.outputCompareMode = _BV(COM0B1);
+        channel.outputCompareRegister8 = &OCR0B;
+        channel.fastPWM = true;
+        break;
+
+    case TIMER1A:
+        channel.timerControlRegister = &TCCR1A;
+        channel.outputCompareMode = _BV(COM1A1);
+        channel.outputCompareRegister16 = &OCR1A;
+        break;
+
+    case TIMER1B:
+        channel.timerControlRegister = &TCCR1A;
+        channel.outputCompareMode = _BV(COM1B1);
+        channel.outputCompareRegister16 = &OCR1B;
+        break;
+
+    case TIMER1C:
+        channel.timerControlRegister = &TCCR1A;
+        channel.outputCompareMode = _BV(COM1C1);
+        channel.outputCompareRegister16 = &OCR1C;
+        break;
+
+    case TIMER2A:
+        channel.timerControlRegister = &TCCR2A;
+        channel.outputCompareMode = _BV(COM2A1);
+        channel.outputCompareRegister8 = &OCR2A;
+        break;
+
+    case TIMER2B:
+        channel.timerControlRegister = &TCCR2A;
+        channel.outputCompareMode = _BV(COM2B1);
+        channel.outputCompareRegister8 = &OCR2B;
+        break;
+
+    case TIMER3A:
+        channel.timerControlRegister = &TCCR3A;
+        channel.outputCompareMode = _BV(COM3A1);
+        channel.outputCompareRegister16 = &OCR3A;
+        break;
+
+    case TIMER3B:
+        channel.timerControlRegister = &TCCR3A;
+        channel.outputCompareMode = _BV(COM3B1);
+        channel.outputCompareRegister16 = &OCR3B;
+        break;
+
+    case TIMER3C:
+        channel.timerControlRegister = &TCCR3A;
+        channel.outputCompareMode = _BV(COM3C1);
+        channel.outputCompareRegister16 = &OCR3C;
+        break;
+
+    case TIMER4A:
+        channel.timerControlRegister = &TCCR4A;
+        channel.outputCompareMode = _BV(COM4A1);
+        channel.outputCompareRegister16 = &OCR4A;
+        break;
+
+    case TIMER4B:
+        channel.timerControlRegister = &TCCR4A;
+        channel.outputCompareMode = _BV(COM4B1);
+        channel.outputCompareRegister16 = &OCR4B;
+        break;
+
+    case TIMER4C:
+        channel.timerControlRegister = &TCCR4A;
+        channel.outputCompareMode = _BV(COM4C1);
+        channel.outputCompareRegister16 = &OCR4C;
+        break;
+
+    case TIMER5A:
+        channel.timerControlRegister = &TCCR5A;
+        channel.outputCompareMode = _BV(COM5A1);
+        channel.outputCompareRegister16 = &OCR5A;
+        break;
+
+    case TIMER5B:
+        channel.timerControlRegister = &TCCR5A;
+        channel.outputCompareMode = _BV(COM5B1);
+        channel.outputCompareRegister16 = &OCR5B;
+        break;
+
+    case TIMER5C:
+        channel.timerControlRegister = &TCCR5A;
+        channel.outputCompareMode = _BV(COM5C1);
+        channel.outputCompareRegister16 = &OCR5C;
+        break;
+    }
+
+    // En PWM à phase correcte (tous les timers sauf le timer 0), un rapport cyclique nul maintient la sortie au niveau bas : la sortie PWM est connectée une fois pour toutes, hors de l'interruption.
+    if (channel.timerControlRegister != nullptr && !channel.fastPWM)
+    {
+        noInterrupts();
+
+        if (channel.outputCompareRegister8 != nullptr)
+            *channel.outputCompareRegister8 = 0;
+
+        else
+            *channel.outputCompareRegister16 = 0;
+
+        *channel.timerControlRegister |= channel.outputCompareMode;
+        channel.connected = true;
+        interrupts();
+    }
+}
+
+/// @brief Met à jour l'intensité d'une couleur uniquement si elle a changé : la correction gamma et la section atomique sont évitées sinon.
+/// @param channel La couleur à mettre à jour.
+/// @param value L'intensité perçue sur 16 bit.
+void RGBLEDStrip::updateChannel(RGBLEDStripChannel &channel, unsigned int value)
+{
+    if (value == channel.value)
+        return;
+
+    channel.value = value;
+    unsigned int intensity = gammaCorrection16(value);
+
+    // L'intensité est lue par l'interruption : elle doit être modifiée de manière atomique.
+    noInterrupts();
+    channel.intensity = intensity;
+    interrupts();
+}
+
+/// @brief Écrit un rapport cyclique directement dans le registre de comparaison de la couleur, uniquement s'il a changé depuis la dernière trame.
+/// Cette méthode est exécutée par l'interruption du timer 3. Le registre de contrôle du timer 0 (`TCCR0A`) n'y est modifié que lorsque le rapport cyclique d'une couleur du timer 0 passe par zéro : `analogWrite()` et `digitalWrite()` modifient ce registre sans bloquer les interruptions, et ne doivent donc être utilisés sur aucune autre broche du timer 0 (broche 13). Les registres de contrôle des autres timers ne sont jamais modifiés par l'interruption.
+/// @param channel La couleur à écrire.
+/// @param duty Le rapport cyclique, de `0` à `255`.
+void RGBLEDStrip::writeChannel(RGBLEDStripChannel &channel, unsigned int duty)
+{
+    if (int(duty) == channel.duty)
+        return;
+
+    channel.duty = duty;
+
+    // Broche sans PWM : comportement identique à celui d'`analogWrite`.
+    if (channel.timerControlRegister == nullptr)
+    {
+        if (duty < 128)
+            *channel.portRegister &= ~channel.pinMask;
+
+        else
+            *channel.portRegister |= channel.pinMask;
+
+        return;
+    }
+
+    // Un rapport cyclique nul laisserait une courte impulsion en PWM rapide : la sortie PWM est alors déconnectée.
+    if (duty == 0 && channel.fastPWM)
+    {
+        *channel.timerControlRegister &= ~channel.outputCompareMode;
+        *channel.portRegister &= ~channel.pinMask;
+        channel.connected = false;
         return;
+    }
+
+    if (channel.outputCompareRegister8 != nullptr)
+        *channel.outputCompareRegister8 = duty;
 
+    else
+        *channel.outputCompareRegister16 = duty;
+
+    if (!channel.connected)
+    {
+        *channel.timerControlRegister |= channel.outputCompareMode;
+        channel.connected = true;
+    }
+}
+
+/// @brief Calcule le rapport cyclique d'une trame par diffusion d'erreur : la fraction de l'intensité est accumulée d'une trame à l'autre, et chaque dépassement ajoute un pas PWM à la trame.
+/// Seuls les 4 bits de poids fort de la fraction sont tramés : le motif se répète au plus toutes les 16 trames (environ 30 Hz). Avec les 8 bits, une fraction de 1/256 n'ajouterait qu'un pas toutes les 256 trames, soit un scintillement visible deux fois par seconde.
+/// @param channel La couleur dont l'erreur accumulée est mise à jour.
+/// @return Le rapport cyclique de la trame, de `0` à `255`.
+unsigned int RGBLEDStrip::dither(RGBLEDStripChannel &channel)
+{
+    unsigned int intensity = channel.intensity;
+    unsigned int duty = intensity >> 8;
+    unsigned char sum = channel.error + ((intensity >> 4) & 0x0F);
+    channel.error = sum & 0x0F;
+
+    if (sum > 0x0F && duty < 255)
+        duty++;
+
+    return duty;
+}
+
+/// @brief Définit la couleur du ruban de DEL RVB.
+/// @param r L'intensité du rouge, de `0` à `255`.
+/// @param g L'intensité du vert, de `0` à `255`.
+/// @param b L'intensité du bleu, de `0` à `255`.
+void RGBLEDStrip::setColor(unsigned int r, unsigned int g, unsigned int b)
+{
     if (r > 255)
         r = 255;
 
@@ -164,13 +458,102 @@ void RGBLEDStrip::setColor(unsigned int r, unsigned int g, unsigned int b)
     if (b > 255)
         b = 255;
 
-    m_RState = r;
-    m_GState = g;
-    m_BState = b;
+    this->setColor16(r << 8, g << 8, b << 8);
+}
+
+/// @brief Définit la couleur du ruban de DEL RVB avec une précision de 16 bit. Les valeurs intermédiaires entre deux pas PWM sont rendues par tramage temporel.
+/// @param r L'intensité du rouge, de `0` à `65535`.
+/// @param g L'intensité du vert, de `0` à `65535`.
+/// @param b L'intensité du bleu, de `0` à `65535`.
+void RGBLEDStrip::setColor16(unsigned int r, unsigned int g, unsigned int b)
+{
+    // Pendant une transition, les modes écrivent dans leur sortie virtuelle : seul le mélange est envoyé au ruban.
+    RGBLEDStripFrame *target = (m_renderTarget != nullptr) ? m_renderTarget : ((m_outgoingMode != nullptr) ? &m_incomingFrame : nullptr);
+    if (target != nullptr)
+    {
+        *target = {r, g, b};
+        return;
+    }
+
+    this->writeColor16(r, g, b);
+}
+
+/// @brief Écrit une couleur avec une précision de 16 bit directement sur le ruban de DEL RVB.
+/// @param r L'intensité du rouge, de `0` à `65535`.
+/// @param g L'intensité du vert, de `0` à `65535`.
+/// @param b L'intensité du bleu, de `0` à `65535`.
+void RGBLEDStrip::writeColor16(unsigned int r, unsigned int g, unsigned int b)
+{
+    if (!m_operational || !m_state)
+        return;
+
+    m_RState = r >> 8;
+    m_GState = g >> 8;
+    m_BState = b >> 8;
+
+    updateChannel(m_RChannel, r);
+    updateChannel(m_GChannel, g);
+    updateChannel(m_BChannel, b);
+}
+
+/// @brief Méthode renvoyant la sortie virtuelle dans laquelle le mode en cours d'exécution doit écrire.
+/// @return La sortie virtuelle, ou `nullptr` si les couleurs sont écrites directement sur le ruban.
+const RGBLEDStripFrame *RGBLEDStrip::getRenderTarget() const
+{
+    if (m_renderTarget != nullptr)
+        return m_renderTarget;
+
+    if (m_outgoingMode != nullptr)
+        return &m_incomingFrame;
+
+    return nullptr;
+}
+
+/// @brief Exécute les deux modes d'une transition dans leurs sorties virtuelles et écrit leur mélange sur le ruban.
+void RGBLEDStrip::updateTransition()
+{
+    unsigned long elapsedTime = millis() - m_transitionStart;
+
+    if (elapsedTime >= m_transitionDuration)
+    {
+        finishTransition();
+        return;
+    }
+
+    m_renderTarget = &m_outgoingFrame;
+    m_outgoingMode->loop();
+    m_renderTarget = nullptr;
+
+    m_mode->loop();
+
+    unsigned int weight = elapsedTime * 256 / m_transitionDuration;
 
-    analogWrite(m_RPin, gammaCorrection(r));
-    analogWrite(m_GPin, gammaCorrection(g));
-    analogWrite(m_BPin, gammaCorrection(b));
+    this->writeColor16(blend(m_outgoingFrame.r, m_incomingFrame.r, weight),
+                       blend(m_outgoingFrame.g, m_incomingFrame.g, weight),
+                       blend(m_outgoingFrame.b, m_incomingFrame.b, weight));
+}
+
+/// @brief Termine la transition en cours : désactive l'ancien mode sans toucher au ruban et affiche la couleur du nouveau mode.
+void RGBLEDStrip::finishTransition()
+{
+    RGBLEDStripMode *outgoingMode = m_outgoingMode;
+
+    m_renderTarget = &m_outgoingFrame;
+    outgoingMode->desactivate();
+    m_renderTarget = nullptr;
+    m_outgoingMode = nullptr;
+
+    this->writeColor16(m_incomingFrame.r, m_incomingFrame.g, m_incomingFrame.b);
+}
+
+/// @brief Mélange deux intensités de 16 bit en virgule fixe.
+/// @param from L'intensité de départ.
+/// @param to L'intensité d'arrivée.
+/// @param weight Le poids de l'intensité d'arrivée, de `0` à `256`.
+/// @return L'intensité mélangée.
+unsigned int RGBLEDStrip::blend(unsigned int from, unsigned int to, unsigned int weight)
+{
+    return ((unsigned long)from * (256 - weight) + (unsigned long)to * weight) >> 8;
 }
 
 /// @brief Constructeur de la classe.
@@ -412,7 +795,7 @@ void RainbowMode::loop()
 /// @param strip Le ruban de DEL utilisé pour l'animation.
 /// @param microphone Le microphone utilisé pour l'animation.
 /// @param EEPROMSensitivity L'emplacement du stockage de la sensibilité de l'animation dans la mémoire EEPROM.
-SoundreactMode::SoundreactMode(const __FlashStringHelper *friendlyName, unsigned int ID, RGBLEDStrip &strip, AnalogInput &microphone, unsigned int EEPROMSensitivity) : RGBLEDStripMode(friendlyName, ID, strip), m_microphone(microphone), m_lastSave(0), m_sensitivityToSave(false), m_sensitivity(EEPROM.read(EEPROMSensitivity)), m_lastColorChange(0), m_lastTime(0), m_maxSound(0), m_EEPROMSensitivity(EEPROMSensitivity) {}
+SoundreactMode::SoundreactMode(const __FlashStringHelper *friendlyName, unsigned int ID, RGBLEDStrip &strip, Microphone &microphone, unsigned int EEPROMSensitivity) : RGBLEDStripMode(friendlyName, ID, strip), m_microphone(microphone), m_lastSave(0), m_sensitivityToSave(false), m_sensitivity(EEPROM.read(EEPROMSensitivity)), m_lastColorChange(0), m_lastTime(0), m_maxSound(0), m_EEPROMSensitivity(EEPROMSensitivity) {}
 
 /// @brief Méthode permettant de définir la sensibilité de l'animation son-réaction.
 /// @param sensitivity La sensibilité à définir, en pourcent (de `0` : peu sensible à `100` : très sensible).
@@ -435,17 +818,23 @@ unsigned int SoundreactMode::getSensitivity() const
     return m_sensitivity;
 }
 
-/// @brief Active le mode.
+/// @brief Active le mode et démarre l'échantillonnage du microphone.
 void SoundreactMode::activate()
 {
+    if (!m_activated)
+        m_microphone.startSampling();
+
     RGBLEDStripMode::activate();
     m_lastColorChange = millis();
     m_lastTime = millis();
 }
 
-/// @brief Désactive le mode
+/// @brief Désactive le mode et libère l'échantillonnage du microphone.
 void SoundreactMode::desactivate()
 {
+    if (m_activated)
+        m_microphone.stopSampling();
+
     RGBLEDStripMode::desactivate();
     EEPROM.update(m_EEPROMSensitivity, m_sensitivity);
     m_lastColorChange = 0;
@@ -462,14 +851,14 @@ void SoundreactMode::loop()
         EEPROM.update(m_EEPROMSensitivity, m_sensitivity);
     }
 
-    int baseSound = m_microphone.getValue();
-    baseSound -= 287;
-    unsigned int sound = abs(baseSound);
+    // L'enveloppe est calculée sur tous les échantillons enregistrés par l'interruption du microphone : elle ne dépend pas de la vitesse d'exécution de la boucle.
+    unsigned int envelope = m_microphone.getEnvelope();
+    unsigned int averageLevel = m_microphone.getAverageLevel();
 
     bool maxChanged = false;
-    if (sound > m_maxSound)
+    if (envelope > m_maxSound)
     {
-        m_maxSound = (m_maxSound + (4 * sound)) / 5;
+        m_maxSound = envelope;
         maxChanged = true;
     }
 
@@ -477,9 +866,12 @@ void SoundreactMode::loop()
 
     bool colorChanged = false;
 
+    // Un battement est détecté quand l'enveloppe dépasse le niveau moyen d'une marge qui diminue avec la sensibilité (de x3 à x1).
+    unsigned long beatThreshold = (unsigned long)averageLevel * (300 - (2 * m_sensitivity)) / 100;
+
     if ((time - m_lastColorChange) >= 200)
     {
-        if (sound >= ((1.0 - (double(m_sensitivity) / 100.0)) * m_maxSound))
+        if (envelope > 2 && envelope >= beatThreshold)
         {
             m_lastColorChange = time;
             colorChanged = true;
@@ -527,11 +919,11 @@ void SoundreactMode::loop()
     {
         m_lastTime = time;
 
-        if (!maxChanged)
+        if (!maxChanged && m_maxSound > 0)
             m_maxSound--;
 
         if ((time - m_lastColorChange) >= 1000)
-            m_maxSound -= 2;
+            m_maxSound = (m_maxSound > 2) ? (m_maxSound - 2) : 0;
 
         if (!colorChanged)
         {
@@ -553,6 +945,189 @@ void SoundreactMode::loop()
     }
 }
 
+// Table des cosinus de la transformée de Fourier (format Q15) : cos(2πk/64) pour k allant de 0 à 31.
+const static int PROGMEM SpectrumCosineTable[SPECTRUM_FFT_SIZE / 2] = {
+    32767, 32610, 32138, 31357, 30274, 28899, 27246, 25330,
+    23170, 20788, 18205, 15447, 12540, 9512, 6393, 3212,
+    0, -3212, -6393, -9512, -12540, -15447, -18205, -20788,
+    -23170, -25330, -27246, -28899, -30274, -31357, -32138, -32610};
+
+// Table des sinus de la transformée de Fourier (format Q15) : sin(2πk/64) pour k allant de 0 à 31.
+const static int PROGMEM SpectrumSineTable[SPECTRUM_FFT_SIZE / 2] = {
+    0, 3212, 6393, 9512, 12540, 15447, 18205, 20788,
+    23170, 25330, 27246, 28899, 30274, 31357, 32138, 32610,
+    32767, 32610, 32138, 31357, 30274, 28899, 27246, 25330,
+    23170, 20788, 18205, 15447, 12540, 9512, 6393, 3212};
+
+// Première moitié de la fenêtre de Hann (format Q15), symétrique sur les 64 échantillons.
+const static int PROGMEM SpectrumWindowTable[SPECTRUM_FFT_SIZE / 2] = {
+    0, 81, 325, 728, 1287, 1995, 2847, 3833,
+    4944, 6169, 7495, 8909, 10398, 11947, 13539, 15160,
+    16792, 18421, 20030, 21602, 23123, 24576, 25948, 27225,
+    28394, 29444, 30364, 31145, 31780, 32261, 32585, 32748};
+
+// Inversion des 6 bits de l'indice : les échantillons sont rangés directement dans l'ordre attendu par les papillons.
+const static uint8_t PROGMEM SpectrumBitReverseTable[SPECTRUM_FFT_SIZE] = {
+    0, 32, 16, 48, 8, 40, 24, 56, 4, 36, 20, 52, 12, 44, 28, 60,
+    2, 34, 18, 50, 10, 42, 26, 58, 6, 38, 22, 54, 14, 46, 30, 62,
+    1, 33, 17, 49, 9, 41, 25, 57, 5, 37, 21, 53, 13, 45, 29, 61,
+    3, 35, 19, 51, 11, 43, 27, 59, 7, 39, 23, 55, 15, 47, 31, 63};
+
+// Raies délimitant les bandes de fréquences (environ 150 Hz par raie à 9615 Hz) : graves de 150 à 300 Hz, médiums de 450 à 1950 Hz, aigus au-delà.
+const static unsigned int SpectrumBandLimits[4] = {1, 3, 14, SPECTRUM_FFT_SIZE / 2};
+
+// Crête minimale de chaque bande : évite d'amplifier le bruit de fond du microphone jusqu'à la pleine intensité.
+#define SPECTRUM_MINIMUM_PEAK 64
+
+/// @brief Constructeur de la classe.
+/// @param friendlyName Le nom formaté pour être présenté à l'utilisateur du périphérique.
+/// @param ID L'identifiant unique du mode.
+/// @param strip Le ruban de DEL utilisé pour l'animation.
+/// @param microphone Le microphone utilisé pour l'animation.
+SpectrumMode::SpectrumMode(const __FlashStringHelper *friendlyName, unsigned int ID, RGBLEDStrip &strip, Microphone &microphone) : RGBLEDStripMode(friendlyName, ID, strip), m_microphone(microphone), m_step(SPECTRUM_COLLECT), m_stage(0), m_samplesNumber(0), m_samplePosition(0), m_real(), m_imaginary(), m_bandPeak(), m_bandLevel() {}
+
+/// @brief Active le mode et démarre l'échantillonnage du microphone.
+void SpectrumMode::activate()
+{
+    if (!m_activated)
+        m_microphone.startSampling();
+
+    RGBLEDStripMode::activate();
+    m_step = SPECTRUM_COLLECT;
+    m_samplesNumber = 0;
+    m_samplePosition = m_microphone.getSamplePosition();
+
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        m_bandPeak[i] = SPECTRUM_MINIMUM_PEAK;
+        m_bandLevel[i] = 0;
+    }
+}
+
+/// @brief Désactive le mode et libère l'échantillonnage du microphone.
+void SpectrumMode::desactivate()
+{
+    if (m_activated)
+        m_microphone.stopSampling();
+
+    RGBLEDStripMode::desactivate();
+    m_step = SPECTRUM_COLLECT;
+    m_samplesNumber = 0;
+}
+
+/// @brief Méthode d'exécution des tâches périodiques liées au mode. Chaque passage n'exécute qu'une étape de la transformée pour ne pas bloquer la boucle.
+void SpectrumMode::loop()
+{
+    switch (m_step)
+    {
+    case SPECTRUM_COLLECT:
+    {
+        int samples[16];
+        unsigned int samplesNumber = m_microphone.readSamples(samples, min(16U, SPECTRUM_FFT_SIZE - m_samplesNumber), m_samplePosition);
+
+        for (unsigned int i = 0; i < samplesNumber; i++)
+        {
+            unsigned int index = m_samplesNumber + i;
+            int window = pgm_read_word(&SpectrumWindowTable[(index < (SPECTRUM_FFT_SIZE / 2)) ? index : (SPECTRUM_FFT_SIZE - 1 - index)]);
+            unsigned int reversedIndex = pgm_read_byte(&SpectrumBitReverseTable[index]);
+
+            // Les échantillons centrés (±512) sont ramenés à ±16384 pour garder de la précision au fil des étapes.
+            m_real[reversedIndex] = ((long)samples[i] * 32 * window) >> 15;
+            m_imaginary[reversedIndex] = 0;
+        }
+
+        m_samplesNumber += samplesNumber;
+
+        if (m_samplesNumber >= SPECTRUM_FFT_SIZE)
+        {
+            m_samplesNumber = 0;
+            m_stage = 0;
+            m_step = SPECTRUM_BUTTERFLIES;
+        }
+        break;
+    }
+
+    case SPECTRUM_BUTTERFLIES:
+        butterflies(m_stage);
+        m_stage++;
+
+        if (m_stage >= SPECTRUM_FFT_STAGES)
+            m_step = SPECTRUM_ANALYSE;
+        break;
+
+    case SPECTRUM_ANALYSE:
+        analyse();
+        m_step = SPECTRUM_COLLECT;
+        break;
+    }
+}
+
+/// @brief Calcule un étage de papillons de la transformée de Fourier rapide (radix 2, décimation temporelle).
+/// @param stage L'étage à calculer, de `0` à `SPECTRUM_FFT_STAGES - 1`.
+void SpectrumMode::butterflies(unsigned int stage)
+{
+    unsigned int half = 1 << stage;
+    unsigned int twiddleStep = (SPECTRUM_FFT_SIZE / 2) >> stage;
+
+    for (unsigned int j = 0; j < half; j++)
+    {
+        int16_t cosine = pgm_read_word(&SpectrumCosineTable[j * twiddleStep]);
+        int16_t sine = pgm_read_word(&SpectrumSineTable[j * twiddleStep]);
+
+        for (unsigned int a = j; a < SPECTRUM_FFT_SIZE; a += 2 * half)
+        {
+            unsigned int b = a + half;
+
+            // Produit par le facteur de rotation cos - i.sin, en format Q15 (multiplications de 16 bit par 16 bit).
+            int tReal = ((long)cosine * m_real[b] + (long)sine * m_imaginary[b]) >> 15;
+            int tImaginary = ((long)cosine * m_imaginary[b] - (long)sine * m_real[b]) >> 15;
+
+            // Chaque étage est divisé par deux : le résultat ne peut pas déborder sur 16 bits.
+            m_real[b] = (m_real[a] - tReal) >> 1;
+            m_imaginary[b] = (m_imaginary[a] - tImaginary) >> 1;
+            m_real[a] = (m_real[a] + tReal) >> 1;
+            m_imaginary[a] = (m_imaginary[a] + tImaginary) >> 1;
+        }
+    }
+}
+
+/// @brief Regroupe les raies du spectre en trois bandes et met à jour la couleur du ruban avec un gain automatique par bande.
+void SpectrumMode::analyse()
+{
+    unsigned int levels[3];
+
+    for (unsigned int band = 0; band < 3; band++)
+    {
+        unsigned long energy = 0;
+
+        // L'amplitude |re| + |im| évite une racine carrée et suffit pour comparer des intensités.
+        for (unsigned int i = SpectrumBandLimits[band]; i < SpectrumBandLimits[band + 1]; i++)
+            energy += abs(m_real[i]) + abs(m_imaginary[i]);
+
+        // La crête de chaque bande suit le maximum puis décroît lentement : une bande peu présente dans la musique reste visible.
+        m_bandPeak[band] -= m_bandPeak[band] >> 7;
+
+        if (energy > m_bandPeak[band])
+            m_bandPeak[band] = energy;
+
+        if (m_bandPeak[band] < SPECTRUM_MINIMUM_PEAK)
+            m_bandPeak[band] = SPECTRUM_MINIMUM_PEAK;
+
+        unsigned int level = energy * 255 / m_bandPeak[band];
+
+        // Montée immédiate, descente progressive.
+        if (level >= m_bandLevel[band])
+            m_bandLevel[band] = level;
+
+        else
+            m_bandLevel[band] -= (m_bandLevel[band] - level + 3) / 4;
+
+        levels[band] = m_bandLevel[band];
+    }
+
+    m_strip.setColor(levels[0], levels[1], levels[2]);
+}
+
 MusicsAnimationsMode::MusicsAnimationsMode(const __FlashStringHelper *friendlyName, unsigned int ID, RGBLEDStrip &strip) : RGBLEDStripMode(friendlyName, ID, strip), m_currentEffect(SINGLE_COLOR), m_smoothTransitionInitialR(0), m_smoothTransitionInitialG(0), m_smoothTransitionInitialB(0), m_smoothTransitionFinalR(0), m_smoothTransitionFinalG(0), m_smoothTransitionFinalB(0), m_smoothTransitionInitialMillis(0), m_smoothTransitionDuration(0), m_smoothTransitionType(LINEAR), m_strobeEffectR(0), m_strobeEffectG(0), m_strobeEffectB(0), m_strobeEffectSpeed(0), m_strobeEffectStep(false), m_strobeEffectLastMillis(0) {}
 
 /// @brief Met le ruban de DEL RVB sur une couleur unique.
@@ -700,11 +1275,12 @@ void MusicsAnimationsMode::loop()
         }
         }
 
-        int newR = m_smoothTransitionInitialR + int(progression * float(int(m_smoothTransitionFinalR) - int(m_smoothTransitionInitialR)));
-        int newG = m_smoothTransitionInitialG + int(progression * float(int(m_smoothTransitionFinalG) - int(m_smoothTransitionInitialG)));
-        int newB = m_smoothTransitionInitialB + int(progression * float(int(m_smoothTransitionFinalB) - int(m_smoothTransitionInitialB)));
+        // Le calcul est effectué sur 16 bit afin que le tramage temporel adoucisse les transitions dans les faibles intensités.
+        long newR = (long(m_smoothTransitionInitialR) << 8) + long(progression * float((long(m_smoothTransitionFinalR) - long(m_smoothTransitionInitialR)) << 8));
+        long newG = (long(m_smoothTransitionInitialG) << 8) + long(progression * float((long(m_smoothTransitionFinalG) - long(m_smoothTransitionInitialG)) << 8));
+        long newB = (long(m_smoothTransitionInitialB) << 8) + long(progression * float((long(m_smoothTransitionFinalB) - long(m_smoothTransitionInitialB)) << 8));
 
-        m_strip.setColor(newR, newG, newB);
+        m_strip.setColor16(newR, newG, newB);
 
         break;
     }
@@ -10,6 +10,34 @@
 #include "device/interface/HomeAssistant.hpp"
 #include "device/input/analogInput.hpp"
 
+/// @brief Structure regroupant l'état d'une couleur du ruban : registres PWM résolus à l'initialisation et valeurs utilisées par le tramage.
+/// Le registre de contrôle du timer est partagé avec les autres broches du même timer : seule une couleur du timer 0 (PWM rapide) y est connectée et déconnectée depuis l'interruption, les timers en PWM à phase correcte restant connectés.
+struct RGBLEDStripChannel
+{
+    volatile uint8_t *timerControlRegister;
+    uint8_t outputCompareMode;
+    bool fastPWM;
+    bool connected;
+    volatile uint8_t *outputCompareRegister8;
+    volatile uint16_t *outputCompareRegister16;
+    volatile uint8_t *portRegister;
+    uint8_t pinMask;
+    unsigned int value;
+    volatile unsigned int intensity;
+    unsigned char error;
+    int duty;
+};
+
+/// @brief Structure contenant une couleur du ruban avec une précision de 16 bit, utilisée comme sortie virtuelle pendant les transitions.
+struct RGBLEDStripFrame
+{
+    unsigned int r;
+    unsigned int g;
+    unsigned int b;
+};
+
+#define RGB_LED_STRIP_TRANSITION_DURATION 500
+
 /// @brief Classe gérant un ruban de DEL.
 class RGBLEDStrip : public Output
 {
@@ -25,24 +53,48 @@ public:
     virtual unsigned int getR() const;
     virtual unsigned int getG() const;
     virtual unsigned int getB() const;
+    virtual void setTransitionDuration(unsigned int duration);
+    virtual unsigned int getTransitionDuration() const;
+    void updateDithering();
 
 protected:
+    static void setupChannel(RGBLEDStripChannel &channel, unsigned int pin);
+    static void updateChannel(RGBLEDStripChannel &channel, unsigned int value);
+    static void writeChannel(RGBLEDStripChannel &channel, unsigned int duty);
+    static unsigned int dither(RGBLEDStripChannel &channel);
+    static unsigned int blend(unsigned int from, unsigned int to, unsigned int weight);
+
     const unsigned int m_RPin;
     const unsigned int m_GPin;
     const unsigned int m_BPin;
     unsigned int m_RState;
     unsigned int m_GState;
     unsigned int m_BState;
+    RGBLEDStripChannel m_RChannel;
+    RGBLEDStripChannel m_GChannel;
+    RGBLEDStripChannel m_BChannel;
     RGBLEDStripMode *m_mode;
+    RGBLEDStripMode *m_outgoingMode;
+    RGBLEDStripFrame m_outgoingFrame;
+    RGBLEDStripFrame m_incomingFrame;
+    RGBLEDStripFrame *m_renderTarget;
+    unsigned long m_transitionStart;
+    unsigned int m_transitionDuration;
 
 private:
     virtual void setColor(unsigned int r, unsigned int g, unsigned int b);
+    virtual void setColor16(unsigned int r, unsigned int g, unsigned int b);
+    virtual void writeColor16(unsigned int r, unsigned int g, unsigned int b);
+    virtual const RGBLEDStripFrame *getRenderTarget() const;
+    virtual void updateTransition();
+    virtual void finishTransition();
 
     friend class RGBLEDStripMode;
     friend class ColorMode;
     friend class AlarmMode;
     friend class RainbowMode;
     friend class SoundreactMode;
+    friend class SpectrumMode;
     friend class MusicsAnimationsMode;
 };
 
@@ -139,12 +191,12 @@ private:
 class SoundreactMode : public RGBLEDStripMode
 {
 public:
-    SoundreactMode(const __FlashStringHelper *friendlyName, unsigned int ID, RGBLEDStrip &strip, AnalogInput &microphone, unsigned int EEPROMSensitivity);
+    SoundreactMode(const __FlashStringHelper *friendlyName, unsigned int ID, RGBLEDStrip &strip, Microphone &microphone, unsigned int EEPROMSensitivity);
     virtual void setSensitivity(unsigned int sensitivity);
     virtual unsigned int getSensitivity() const;
 
 protected:
-    AnalogInput &m_microphone;
+    Microphone &m_microphone;
     unsigned long m_lastSave;
     bool m_sensitivityToSave;
     unsigned int m_sensitivity;
@@ -161,6 +213,44 @@ private:
     friend class RGBLEDStrip;
 };
 
+#define SPECTRUM_FFT_SIZE 64
+#define SPECTRUM_FFT_STAGES 6
+
+/// @brief Étapes du calcul incrémental de la transformée de Fourier du mode spectre.
+enum SpectrumStep
+{
+    SPECTRUM_COLLECT,
+    SPECTRUM_BUTTERFLIES,
+    SPECTRUM_ANALYSE,
+};
+
+/// @brief Classe du mode de couleur spectre : les graves, médiums et aigus du microphone pilotent respectivement le rouge, le vert et le bleu.
+class SpectrumMode : public RGBLEDStripMode
+{
+public:
+    SpectrumMode(const __FlashStringHelper *friendlyName, unsigned int ID, RGBLEDStrip &strip, Microphone &microphone);
+
+protected:
+    Microphone &m_microphone;
+    SpectrumStep m_step;
+    unsigned int m_stage;
+    unsigned int m_samplesNumber;
+    unsigned int m_samplePosition;
+    int m_real[SPECTRUM_FFT_SIZE];
+    int m_imaginary[SPECTRUM_FFT_SIZE];
+    unsigned long m_bandPeak[3];
+    unsigned int m_bandLevel[3];
+
+private:
+    virtual void activate() override;
+    virtual void desactivate() override;
+    virtual void loop() override;
+    void butterflies(unsigned int stage);
+    void analyse();
+
+    friend class RGBLEDStrip;
+};
+
 /// @brief Structure utilisée par le mode de couleur `MusicsAnimationsMode` pour enregistrer l'animation en cours d'exécution.
 enum MusicsAnimationsCurrentEffect
 {
@@ -20,7 +20,7 @@
 /// @param ID L'identifiant unique du périphérique utilisé pour communiquer avec Home Assistant.
 /// @param connection L'instance utilisée pour la communication avec Home Assistant.
 /// @param display L'écran à utiliser pour afficher des informations / animations.
-ConnectedOutput::ConnectedOutput(const __FlashStringHelper *friendlyName, unsigned int ID, HomeAssistant &connection, Display &display) : Output(friendlyName, ID, connection, display), m_noInformationShare(0), m_reportState(false) {}
+ConnectedOutput::ConnectedOutput(const __FlashStringHelper *friendlyName, unsigned int ID, HomeAssistant &connection, Display &display) : Output(friendlyName, ID, connection, display), m_noInformationShare(0), m_reportState(false), m_commandTime(0), m_measuringLatency(false), m_latency(0) {}
 
 /// @brief Initialise l'objet.
 void ConnectedOutput::setup()
@@ -59,6 +59,7 @@ void ConnectedOutput::turnOn(bool shareInformation)
         return;
 
     m_connection.turnOnConnectedDevice(m_ID);
+    this->startLatencyMeasurement();
 
     if (!shareInformation)
         m_noInformationShare = millis() + 500;
@@ -72,6 +73,7 @@ void ConnectedOutput::turnOff(bool shareInformation)
         return;
 
     m_connection.turnOffConnectedDevice(m_ID);
+    this->startLatencyMeasurement();
 
     if (!shareInformation)
         m_noInformationShare = millis() + 500;
@@ -81,6 +83,8 @@ void ConnectedOutput::turnOff(bool shareInformation)
 /// @param shareInformation Affiche ou non l'animation d'allumage sur l'écran.
 void ConnectedOutput::updateOn()
 {
+    this->endLatencyMeasurement();
+
     if (!m_operational || m_state)
         return;
 
@@ -93,6 +97,8 @@ void ConnectedOutput::updateOn()
 /// @param shareInformation Affiche ou non l'animation d'arrêt sur l'écran.
 void ConnectedOutput::updateOff()
 {
+    this->endLatencyMeasurement();
+
     if (!m_operational || !m_state)
         return;
 
@@ -101,6 +107,43 @@ void ConnectedOutput::updateOff()
         m_display.displayDeviceState(false);
 }
 
+/// @brief Méthode permettant de connaître le délai mesuré entre l'envoi d'une commande et la mise à jour de l'état du périphérique par Home Assistant.
+/// @return La latence moyenne en millisecondes.
+unsigned int ConnectedOutput::getActuationLatency() const
+{
+    return m_latency;
+}
+
+/// @brief Démarre la mesure de la latence à l'envoi d'une commande, si aucune mesure n'est déjà en cours.
+void ConnectedOutput::startLatencyMeasurement()
+{
+    if (m_measuringLatency && (millis() - m_commandTime) < CONNECTED_OUTPUT_LATENCY_TIMEOUT)
+        return;
+
+    m_commandTime = millis();
+    m_measuringLatency = true;
+}
+
+/// @brief Termine la mesure de la latence à la réception d'une mise à jour de l'état du périphérique, et l'intègre à la moyenne glissante.
+void ConnectedOutput::endLatencyMeasurement()
+{
+    if (!m_measuringLatency)
+        return;
+
+    m_measuringLatency = false;
+    unsigned long latency = millis() - m_commandTime;
+
+    // Une réponse trop tardive ne correspond probablement pas à la commande envoyée.
+    if (latency >= CONNECTED_OUTPUT_LATENCY_TIMEOUT)
+        return;
+
+    if (m_latency == 0)
+        m_latency = latency;
+
+    else
+        m_latency = ((m_latency * 3UL) + latency) / 4;
+}
+
 /// @brief Définis le périphérique comme opérationnel.
 void ConnectedOutput::setAvailable()
 {
@@ -137,6 +180,7 @@ void ConnectedTemperatureVariableLight::setColorTemperature(unsigned int tempera
         temperature = m_maximalColorTemperature;
 
     m_connection.setConnectedTemperatureVariableLightTemperature(m_ID, temperature);
+    this->startLatencyMeasurement();
 
     if (!shareInformation)
         m_noInformationShare = millis() + 500;
@@ -154,6 +198,7 @@ void ConnectedTemperatureVariableLight::setLuminosity(unsigned int luminosity, b
         luminosity = 255;
 
     m_connection.setConnectedTemperatureVariableLightLuminosity(m_ID, luminosity);
+    this->startLatencyMeasurement();
 
     if (!shareInformation)
         m_noInformationShare = millis() + 500;
@@ -178,6 +223,8 @@ unsigned int ConnectedTemperatureVariableLight::getLuminosity() const
 /// @param shareInformation Affiche ou non l'animation sur l'écran.
 void ConnectedTemperatureVariableLight::updateColorTemperature(unsigned int temperature)
 {
+    this->endLatencyMeasurement();
+
     if (!m_operational || !m_state || m_colorTemperature == temperature)
         return;
 
@@ -191,6 +238,8 @@ void ConnectedTemperatureVariableLight::updateColorTemperature(unsigned int temp
 /// @param shareInformation Affiche ou non l'animation sur l'écran.
 void ConnectedTemperatureVariableLight::updateLuminosity(unsigned int luminosity)
 {
+    this->endLatencyMeasurement();
+
     if (!m_operational || !m_state || m_luminosity == luminosity)
         return;
 
@@ -228,6 +277,7 @@ void ConnectedColorVariableLight::setColor(unsigned int r, unsigned int g, unsig
         b = 255;
 
     m_connection.setConnectedColorVariableLightColor(m_ID, r, g, b);
+    this->startLatencyMeasurement();
 
     if (!shareInformation)
         m_noInformationShare = millis() + 500;
@@ -248,6 +298,7 @@ void ConnectedColorVariableLight::setColorTemperature(unsigned int temperature,
         temperature = m_maximalColorTemperature;
 
     m_connection.setConnectedColorVariableLightTemperature(m_ID, temperature);
+    this->startLatencyMeasurement();
 
     if (!shareInformation)
         m_noInformationShare = millis() + 500;
@@ -265,6 +316,7 @@ void ConnectedColorVariableLight::setLuminosity(unsigned int luminosity, bool sh
         luminosity = 255;
 
     m_connection.setConnectedColorVariableLightLuminosity(m_ID, luminosity);
+    this->startLatencyMeasurement();
 
     if (!shareInformation)
         m_noInformationShare = millis() + 500;
@@ -298,6 +350,8 @@ unsigned int ConnectedColorVariableLight::getBLuminosity() const
 /// @param shareInformation Affiche ou non l'animation sur l'écran.
 void ConnectedColorVariableLight::updateColor(unsigned int r, unsigned int g, unsigned int b)
 {
+    this->endLatencyMeasurement();
+
     if (!m_operational || !m_state || (m_RColor == r && m_GColor == g && m_BColor == b))
         return;
 
@@ -9,6 +9,8 @@
 #include "device/interface/display.hpp"
 #include "device/interface/HomeAssistant.hpp"
 
+#define CONNECTED_OUTPUT_LATENCY_TIMEOUT 2000
+
 /// @brief Classe représentant un périphérique contrôlé depuis le réseau.
 class ConnectedOutput : public Output
 {
@@ -18,6 +20,7 @@ public:
     virtual void reportState() override;
     virtual void turnOn(bool shareInformation = false) override;
     virtual void turnOff(bool shareInformation = false) override;
+    virtual unsigned int getActuationLatency() const override;
 
 protected:
     virtual void updateOn();
@@ -26,8 +29,14 @@ protected:
     virtual void setAvailable();
     virtual void setUnavailable();
 
+    virtual void startLatencyMeasurement();
+    virtual void endLatencyMeasurement();
+
     unsigned long m_noInformationShare;
     bool m_reportState;
+    unsigned long m_commandTime;
+    bool m_measuringLatency;
+    unsigned int m_latency;
 
     friend class HomeAssistant;
 };
@@ -18,7 +18,7 @@
 /// @brief Constructeur de la classe.
 /// @param friendlyName Le nom formaté pour être présenté à l'utilisateur du périphérique.
 /// @param display L'écran à utiliser pour afficher des informations / animations.
-Output::Output(const __FlashStringHelper *friendlyName, unsigned int ID, HomeAssistant &connection, Display &display) : Device(friendlyName, ID), m_display(display), m_connection(connection), m_state(false), m_locked(false) {}
+Output::Output(const __FlashStringHelper *friendlyName, unsigned int ID, HomeAssistant &connection, Display &display) : Device(friendlyName, ID), m_display(display), m_connection(connection), m_state(false), m_locked(false), m_owner(nullptr) {}
 
 /// @brief Initialise l'objet.
 void Output::setup()
@@ -60,6 +60,9 @@ bool Output::getState() const
 /// @brief Bloque le périphérique.
 void Output::lock()
 {
+    if (m_owner != nullptr)
+        return;
+
     m_locked = true;
     m_connection.updateDeviceAvailability(m_ID, false);
 }
@@ -67,6 +70,9 @@ void Output::lock()
 /// @brief Débloque le périphérique.
 void Output::unLock()
 {
+    if (m_owner != nullptr)
+        return;
+
     m_locked = false;
     m_connection.updateDeviceAvailability(m_ID, true);
 }
@@ -75,7 +81,61 @@ void Output::unLock()
 /// @return L'état de blocage du périphérique.
 bool Output::isLocked() const
 {
-    return m_locked;
+    return m_locked || (m_owner != nullptr);
+}
+
+/// @brief Réserve le périphérique pour un autre périphérique (par exemple la télévision pendant une vidéo animée). Il est bloqué pour tous les autres, et son indisponibilité n'est signalée qu'une fois.
+/// @param owner Le périphérique propriétaire.
+/// @return `true` si le périphérique a pu être réservé.
+bool Output::acquire(const Device *owner)
+{
+    if (owner == nullptr || m_locked || m_owner != nullptr)
+        return false;
+
+    m_owner = owner;
+    m_locked = true;
+    m_connection.updateDeviceAvailability(m_ID, false);
+    return true;
+}
+
+/// @brief Libère le périphérique réservé et signale à nouveau sa disponibilité. Le blocage est toujours levé : `lock()` n'a aucun effet tant que le périphérique est réservé, il ne peut donc pas avoir été bloqué par un autre entre-temps.
+/// @param owner Le périphérique propriétaire.
+void Output::release(const Device *owner)
+{
+    if (owner == nullptr || m_owner != owner)
+        return;
+
+    m_owner = nullptr;
+    m_locked = false;
+    m_connection.updateDeviceAvailability(m_ID, true);
+}
+
+/// @brief Ouvre ou referme l'accès du propriétaire au périphérique réservé, sans modifier l'état de blocage public ni envoyer de message.
+/// @param owner Le périphérique propriétaire.
+/// @param access `true` pour autoriser les commandes du propriétaire, `false` pour les bloquer à nouveau.
+/// @return `true` si le périphérique appartient bien à `owner`.
+bool Output::grantAccess(const Device *owner, bool access)
+{
+    if (owner == nullptr || m_owner != owner)
+        return false;
+
+    m_locked = !access;
+    return true;
+}
+
+/// @brief Méthode permettant de savoir si le périphérique est réservé par un autre périphérique.
+/// @param owner Le périphérique propriétaire supposé.
+/// @return `true` si le périphérique appartient à `owner`.
+bool Output::isOwnedBy(const Device *owner) const
+{
+    return (owner != nullptr) && (m_owner == owner);
+}
+
+/// @brief Méthode permettant de connaître le délai entre une commande et son effet réel. Les périphériques locaux réagissent immédiatement.
+/// @return La latence en millisecondes.
+unsigned int Output::getActuationLatency() const
+{
+    return 0;
 }
 
 /// @brief Méthode arrêtant le périphérique avant l'arrêt du système.
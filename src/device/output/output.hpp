@@ -23,6 +23,11 @@ public:
     virtual void lock();
     virtual void unLock();
     virtual bool isLocked() const;
+    virtual bool acquire(const Device *owner);
+    virtual void release(const Device *owner);
+    virtual bool grantAccess(const Device *owner, bool access);
+    virtual bool isOwnedBy(const Device *owner) const;
+    virtual unsigned int getActuationLatency() const;
     virtual void shutdown() override;
 
 protected:
@@ -30,6 +35,7 @@ protected:
     HomeAssistant &m_connection;
     bool m_state;
     bool m_locked;
+    const Device *m_owner;
 };
 
 #endif
\ No newline at end of file
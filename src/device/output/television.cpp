@@ -18,6 +18,63 @@
 #include "device/interface/HomeAssistant.hpp"
 #include "EEPROM.hpp"
 
+// Le son clé est analysé par blocs de 96 échantillons (10 ms à 9615 Hz) : les fréquences recherchées tombent exactement sur les raies 10, 15 et 20.
+#define TRIGGER_SOUND_BLOCK_SIZE 96
+#define TRIGGER_SOUND_DETECTIONS 5
+#define TRIGGER_SOUND_MINIMUM_ENERGY 19200UL
+
+static const unsigned int TriggerSoundFrequencies[3] = {1000, 1500, 2000};
+
+// Coefficients 2.cos(2πk/96) des filtres de Goertzel, au format Q14.
+static const long TriggerSoundCoefficients[3] = {25997, 18205, 8481};
+
+// Durées du protocole infrarouge NEC, en microsecondes.
+#define IR_NEC_UNIT 560UL
+#define IR_NEC_HEADER_MARK (16 * IR_NEC_UNIT)
+#define IR_NEC_HEADER_SPACE (8 * IR_NEC_UNIT)
+#define IR_NEC_REPEAT_SPACE (4 * IR_NEC_UNIT)
+#define IR_NEC_ONE_SPACE (3 * IR_NEC_UNIT)
+#define IR_NEC_REPEAT_PERIOD 110000UL
+#define IR_NEC_COMMAND_GAP 40000UL
+#define IR_NEC_FRAME_PULSES 68
+#define IR_NEC_REPEAT_FRAME_PULSES 4
+#define IR_CARRIER_FREQUENCY 38000UL
+
+// Durée maximale programmée en une fois dans le timer 5, qui déborde toutes les 32,7 ms avec des pas de 0,5 µs.
+#define IR_MAXIMUM_STEP 30000UL
+
+// Position de repos du servomoteur de l'écran et profil par défaut de l'appui sur son bouton.
+#define DISPLAY_SERVO_REST_ANGLE 80
+#define DISPLAY_SERVO_PRESSED_ANGLE 130
+#define DISPLAY_SERVO_SPEED 220
+#define DISPLAY_SERVO_DWELL 370
+#define DISPLAY_SERVO_SETTLING 100
+
+// Émetteur infrarouge et servomoteur dont les impulsions sont cadencées par les interruptions du timer 5.
+static IRTransmitter *activeTransmitter = nullptr;
+static ServoOutput *activeServo = nullptr;
+
+// Le timer 5 compte en continu : son registre de comparaison A marque la fin de chaque impulsion infrarouge.
+ISR(TIMER5_COMPA_vect)
+{
+    if (activeTransmitter != nullptr)
+        activeTransmitter->updateTransmission();
+}
+
+// Le registre de comparaison B du timer 5 marque les fronts des impulsions du servomoteur.
+ISR(TIMER5_COMPB_vect)
+{
+    if (activeServo != nullptr)
+        activeServo->updatePulse();
+}
+
+/// @brief Configure le timer 5 en comptage libre avec un pas de 0,5 µs, partagé par l'émetteur infrarouge et le servomoteur.
+static void setupSchedulingTimer()
+{
+    TCCR5A = 0;
+    TCCR5B = _BV(CS51);
+}
+
 /// @brief Constructeur de la classe.
 /// @param friendlyName Le nom formaté pour être présenté à l'utilisateur du périphérique.
 /// @param ID L'identifiant unique du périphérique utilisé pour communiquer avec Home Assistant.
@@ -27,7 +84,7 @@
 /// @param IRLEDPin La broche associée à celle de la DEL infrarouge.
 /// @param volume Le volume récupéré de l'EEPROM.
 /// @param mode Le mode utilisé lors de vidéos animées pour contrôler le ruban de DEL RVB.
-Television::Television(const __FlashStringHelper *friendlyName, unsigned int ID, HomeAssistant &connection, Display &display, int servomotorPin, int IRLEDPin, int volume, MusicsAnimationsMode &mode) : Output(friendlyName, ID, connection, display), m_servomotorPin(servomotorPin), m_IRLEDPin(IRLEDPin), m_IRSender(), m_volume(volume), m_volumeMuted(false), m_lastTime(0), m_waitingForTriggerSound(false), m_microphone(nullptr), m_musicStartTime(0), m_lastActionIndex(0), m_musicList(nullptr), m_currentMusicIndex(-1), m_musicsNumber(0), m_deviceList(nullptr), m_devicesNumber(0), m_mode(mode), m_detectionStartTime(0) {}
+Television::Television(const __FlashStringHelper *friendlyName, unsigned int ID, HomeAssistant &connection, Display &display, int servomotorPin, int IRLEDPin, int volume, MusicsAnimationsMode &mode) : Output(friendlyName, ID, connection, display), m_servomotorPin(servomotorPin), m_IRLEDPin(IRLEDPin), m_IRTransmitter(), m_displayServo(), m_displayServoPressedAngle(DISPLAY_SERVO_PRESSED_ANGLE), m_displayServoSpeed(DISPLAY_SERVO_SPEED), m_displayServoDwell(DISPLAY_SERVO_DWELL), m_syncVolumeDecreases(0), m_syncVolumeIncreases(0), m_syncVolumeShareInformation(false), m_volume(volume), m_volumeMuted(false), m_lastTime(0), m_microphone(nullptr), m_samplePosition(0), m_triggerSoundFilters(), m_triggerSoundSamplesNumber(0), m_triggerSoundEnergy(0), m_triggerSoundDetectionTime(0), m_showStage(SHOW_IDLE), m_showStageStartTime(0), m_showStageDurations(), m_showStepTime(0), m_showStepDelay(0), m_musicStartTime(0), m_lastActionIndex(0), m_nextActionTime(0), m_currentMusic(), m_nextAction(), m_nextActionLoaded(false), m_remoteActionIndex(0), m_remoteActionTime(0), m_remoteAction(), m_remoteActionLoaded(false), m_musicStream(connection, ID), m_deviceLatencies(), m_musicList(nullptr), m_currentMusicIndex(-1), m_musicsNumber(0), m_deviceList(nullptr), m_devicesNumber(0), m_mode(mode) {}
 
 /// @brief Cette méthode permet d'enregistrer les périphériques du système qui pourront être contrôlés automatiquement lors de la lecture d'une vidéo.
 /// @param deviceList La liste de périphériques à utiliser.
@@ -52,7 +109,7 @@ void Television::setMusicsList(const Music *const *musicList, unsigned int music
 
 /// @brief Méthode permettant de définir le microphone utilisé par la télévision pour détecter le son clé du lancement d'une vidéo.
 /// @param microphone L'objet du microphone.
-void Television::setMicrophone(AnalogInput &microphone)
+void Television::setMicrophone(Microphone &microphone)
 {
     m_microphone = &microphone;
 }
@@ -63,9 +120,10 @@ void Television::setup()
     if (m_operational || m_microphone == nullptr || m_musicsNumber == 0 || m_devicesNumber == 0)
         return;
 
+    if (!m_IRTransmitter.setup(m_IRLEDPin) || !m_displayServo.setup(m_servomotorPin, DISPLAY_SERVO_REST_ANGLE))
+        return;
+
     Output::setup();
-    pinMode(m_servomotorPin, OUTPUT);
-    m_IRSender.begin(m_IRLEDPin);
     m_lastTime = millis();
     m_operational = true;
     m_connection.updateDeviceAvailability(m_ID, true);
@@ -92,35 +150,44 @@ void Television::loop()
         m_lastTime = millis();
     }
 
-    if (m_waitingForTriggerSound)
+    // La calibration du volume alimente la file d'émission au fur et à mesure qu'elle se vide, en y laissant la place d'un changement de volume de l'utilisateur.
+    while ((m_syncVolumeDecreases > 0 || m_syncVolumeIncreases > 0) && m_IRTransmitter.getQueueDepth() < (IR_TRANSMITTER_QUEUE_SIZE - 3))
     {
-        int frequency = detectTriggerSound();
-        if (frequency != 0)
+        if (m_syncVolumeDecreases > 0)
         {
-            m_waitingForTriggerSound = false;
+            m_IRTransmitter.send(0x44C1, 0xC7, 3);
+            m_syncVolumeDecreases--;
 
-            if (frequency == 1000)
-                m_musicStartTime = millis() - 1120;
-            
-            else if(frequency == 1500)
-                m_musicStartTime = millis() - 1320;
-            
-            else if(frequency == 2000)
-                m_musicStartTime = millis() - 1520;
-            
-
-            m_display.displayMessage("C'est parti !");
+            // La montée est calculée à la fin de la descente, avec le volume choisi entre-temps par l'utilisateur.
+            if (m_syncVolumeDecreases == 0)
+                m_syncVolumeIncreases = m_volume * 2;
         }
 
-        if ((millis() - m_detectionStartTime) >= 40000)
+        else
         {
-            stopMusic();
-            m_display.displayMessage("Musique non détectée", "Erreur");
+            m_IRTransmitter.send(0x44C1, 0x47, 3);
+            m_syncVolumeIncreases--;
         }
     }
 
-    if (m_musicStartTime != 0)
-        scheduleMusic();
+    if (m_syncVolumeShareInformation && m_syncVolumeDecreases == 0 && m_syncVolumeIncreases == 0 && m_IRTransmitter.isIdle())
+    {
+        m_syncVolumeShareInformation = false;
+        m_display.displayMessage("Calibration terminée !");
+    }
+
+    m_musicStream.loop();
+
+    // Une musique diffusée dont l'ESP ne répond plus (ancien programme, liaison coupée) est arrêtée et ses périphériques libérés.
+    if (m_musicStream.isFailed())
+    {
+        m_musicStream.close();
+        this->stopMusic();
+        m_display.displayMessage("L'ESP ne répond pas.", "Erreur");
+    }
+
+    if (m_showStage != SHOW_IDLE)
+        advanceShow();
 }
 
 /// @brief Met en marche la télévision.
@@ -132,7 +199,7 @@ void Television::turnOn(bool shareInformation)
 
     m_connection.updateOutputDeviceState(m_ID, true);
     switchDisplay();
-    m_IRSender.sendNEC(0x44C1, 0x87, 3);
+    m_IRTransmitter.send(0x44C1, 0x87, 3);
     m_state = true;
     if (shareInformation)
         m_display.displayDeviceState(true);
@@ -148,7 +215,7 @@ void Television::turnOff(bool shareInformation)
     m_connection.updateOutputDeviceState(m_ID, false);
     stopMusic();
     switchDisplay();
-    m_IRSender.sendNEC(0x44C1, 0x87, 3);
+    m_IRTransmitter.send(0x44C1, 0x87, 3);
     m_state = false;
     if (shareInformation)
         m_display.displayDeviceState(false);
@@ -166,36 +233,20 @@ void Television::syncVolume(bool shareInformation)
         return;
     }
 
-    unsigned int savedVolume = m_volume;
-
     if (shareInformation)
         m_display.displayMessage("Calibration du son...");
 
-    for (int i = 0; i < 25; i++)
-    {
-        for (int i = 0; i < 2; i++)
-            m_IRSender.sendNEC(0x44C1, 0xC7, 3);
-
-        delay(50);
-    }
-
-    for (unsigned int i = 0; i < savedVolume; i++)
-    {
-        for (int i = 0; i < 2; i++)
-            m_IRSender.sendNEC(0x44C1, 0x47, 3);
-
-        delay(50);
-    }
-
-    if (shareInformation)
-        m_display.displayMessage("Calibration terminée !");
+    // Le volume est ramené à zéro puis remonté au volume enregistré : les commandes sont émises en arrière-plan depuis la boucle.
+    m_syncVolumeDecreases = 25 * 2;
+    m_syncVolumeIncreases = 0;
+    m_syncVolumeShareInformation = shareInformation;
 }
 
 /// @brief Augmente le volume de la télévision.
 /// @param shareInformation Affiche ou non l'animation sur l'écran.
 void Television::increaseVolume(bool shareInformation)
 {
-    if (!m_state || m_locked || m_volumeMuted || !m_operational || (m_volume == 25))
+    if (!m_state || m_locked || m_volumeMuted || !m_operational || (m_volume == 25) || (m_syncVolumeDecreases == 0 && m_syncVolumeIncreases == 0 && m_IRTransmitter.getQueueDepth() > (IR_TRANSMITTER_QUEUE_SIZE - 3)))
     {
         if (shareInformation)
             m_display.displayMessage("Impossible d'effectuer cette action.", "Erreur");
@@ -203,8 +254,15 @@ void Television::increaseVolume(bool shareInformation)
         return;
     }
 
-    for (int i = 0; i < 2; i++)
-        m_IRSender.sendNEC(0x44C1, 0x47, 3);
+    // Pendant une calibration, seule la montée encore à émettre change : elle est calculée avec le nouveau volume à la fin de la descente, ou allongée pendant la montée. Sinon, une baisse de volume encore en attente est annulée plutôt qu'émise puis compensée.
+    if (m_syncVolumeIncreases > 0)
+        m_syncVolumeIncreases += 2;
+
+    else if (m_syncVolumeDecreases == 0)
+    {
+        for (int i = 0; i < 2; i++)
+            m_IRTransmitter.send(0x44C1, 0x47, 3, 0xC7);
+    }
 
     m_volume++;
     m_connection.updateTelevisionVolume(m_ID, 0, m_volume);
@@ -217,7 +275,7 @@ void Television::increaseVolume(bool shareInformation)
 /// @param shareInformation Affiche ou non l'animation sur l'écran.
 void Television::decreaseVolume(bool shareInformation)
 {
-    if (!m_state || m_locked || m_volumeMuted || !m_operational || (m_volume == 0))
+    if (!m_state || m_locked || m_volumeMuted || !m_operational || (m_volume == 0) || (m_syncVolumeDecreases == 0 && m_syncVolumeIncreases == 0 && m_IRTransmitter.getQueueDepth() > (IR_TRANSMITTER_QUEUE_SIZE - 3)))
     {
         if (shareInformation)
             m_display.displayMessage("Impossible d'effectuer cette action.", "Erreur");
@@ -225,8 +283,15 @@ void Television::decreaseVolume(bool shareInformation)
         return;
     }
 
-    for (int i = 0; i < 2; i++)
-        m_IRSender.sendNEC(0x44C1, 0xC7, 3);
+    // Pendant la montée d'une calibration, les hausses pas encore ajoutées à la file sont retirées : une baisse émise à leur suite pourrait arriver alors que la télévision est encore à zéro.
+    if (m_syncVolumeDecreases == 0)
+    {
+        unsigned int cancelledIncreases = min(m_syncVolumeIncreases, 2U);
+        m_syncVolumeIncreases -= cancelledIncreases;
+
+        for (unsigned int i = cancelledIncreases; i < 2; i++)
+            m_IRTransmitter.send(0x44C1, 0xC7, 3, 0x47);
+    }
 
     m_volume--;
     m_connection.updateTelevisionVolume(m_ID, 0, m_volume);
@@ -254,7 +319,7 @@ void Television::mute(bool shareInformation)
         return;
     }
 
-    m_IRSender.sendNEC(0x44C1, 0x77, 3);
+    m_IRTransmitter.send(0x44C1, 0x77, 3);
     m_volumeMuted = true;
     m_connection.updateTelevisionVolume(m_ID, 1);
 
@@ -274,7 +339,7 @@ void Television::unMute(bool shareInformation)
         return;
     }
 
-    m_IRSender.sendNEC(0x44C1, 0x77, 3);
+    m_IRTransmitter.send(0x44C1, 0x77, 3);
     m_volumeMuted = false;
     m_connection.updateTelevisionVolume(m_ID, 2);
 
@@ -331,7 +396,7 @@ Music Television::getMusicFromIndex(unsigned int index)
 void Television::playMusic(unsigned int musicIndex)
 {
     // Étape 1 : vérification que toutes les conditions sont remplies pour démarrer la vidéo.
-    if (m_locked || !m_operational || musicIndex > m_musicsNumber)
+    if (m_locked || !m_operational || musicIndex >= m_musicsNumber || m_showStage != SHOW_IDLE)
     {
         m_display.displayMessage("Impossible d'effectuer cette action.", "Erreur");
 
@@ -352,37 +417,18 @@ void Television::playMusic(unsigned int musicIndex)
 
     m_display.displayMessage("Initialisation...");
 
-    // Étape 2 : préparation du terrain pour la vidéo.
-    for (unsigned int i = 0; i < m_devicesNumber; i++)
-    {
-        m_deviceList[i]->turnOff();
-        m_deviceList[i]->lock();
-    }
-
-    if (!m_state)
-    {
-        this->turnOn();
-        delay(1000);
-    }
-
-    if (m_volumeMuted)
-        this->unMute();
-
-    delay(1000);
-
-    while (this->getVolume() < 15)
-    {
-        this->increaseVolume();
-        delay(500);
-    }
+    // La musique est chargée une seule fois pour toute la vidéo.
+    m_currentMusic = getMusicFromIndex(musicIndex);
+    m_lastActionIndex = 0;
 
-    delay(2000);
+    // Une musique diffusée commence à remplir sa mémoire tampon pendant le lancement de la vidéo.
+    if (m_currentMusic.actionList == nullptr)
+        m_musicStream.open(m_currentMusic.streamNumber);
 
-    m_connection.playVideo(readProgmemString(getMusicFromIndex(musicIndex).videoURL));
-    m_waitingForTriggerSound = true;
+    // Les étapes suivantes sont exécutées depuis la boucle de la télévision pour ne pas bloquer le reste du système.
     m_currentMusicIndex = musicIndex;
-    m_detectionStartTime = millis();
-    m_display.displayMessage("En attente de la vidéo.");
+    m_showStageStartTime = millis();
+    this->setShowStage(SHOW_PREPARE_DEVICES);
 }
 
 /// @brief Méthode permettant de stopper la lecture de la vidéo en cours proprement.
@@ -391,19 +437,52 @@ void Television::stopMusic()
     if (m_locked || !m_operational || m_currentMusicIndex == -1)
         return;
 
+    if (m_showStage == SHOW_WAIT_TRIGGER)
+        m_microphone->stopSampling();
+
+    this->setShowStage(SHOW_IDLE);
     m_currentMusicIndex = -1;
     m_lastActionIndex = 0;
+    m_nextActionTime = 0;
     m_musicStartTime = 0;
-    m_detectionStartTime = 0;
-    m_waitingForTriggerSound = false;
+    m_musicStream.close();
 
+    // Les périphériques sont éteints par la télévision, puis libérés : leur disponibilité n'est signalée qu'une fois.
     for (unsigned int i = 0; i < m_devicesNumber; i++)
     {
-        m_deviceList[i]->unLock();
-        m_deviceList[i]->turnOff();
+        if (m_deviceList[i]->grantAccess(this, true))
+        {
+            m_deviceList[i]->turnOff();
+            m_deviceList[i]->release(this);
+        }
     }
 }
 
+/// @brief Méthode permettant de connaître l'étape en cours du lancement d'une vidéo.
+/// @return L'étape en cours.
+ShowStage Television::getShowStage() const
+{
+    return m_showStage;
+}
+
+/// @brief Méthode permettant de connaître la durée de la dernière exécution d'une étape du lancement d'une vidéo.
+/// @param stage L'étape voulue.
+/// @return La durée de l'étape en millisecondes.
+unsigned long Television::getShowStageDuration(ShowStage stage) const
+{
+    if (stage >= SHOW_STAGES_NUMBER)
+        return 0;
+
+    return m_showStageDurations[stage];
+}
+
+/// @brief Méthode permettant de connaître le nombre de commandes infrarouges en attente d'émission.
+/// @return Le nombre de commandes en attente.
+unsigned int Television::getIRQueueDepth() const
+{
+    return m_IRTransmitter.getQueueDepth();
+}
+
 /// @brief Méthode arrêtant le périphérique avant l'arrêt du système.
 void Television::shutdown()
 {
@@ -412,270 +491,472 @@ void Television::shutdown()
     Output::shutdown();
 }
 
-/// @brief Envoie une impulsion pour contrôler le servomoteur.
-/// @param angle L'angle sélectionné en degré.
-void Television::moveDisplayServo(unsigned int angle)
+/// @brief Modifie le mouvement utilisé pour appuyer sur le bouton de l'écran.
+/// @param pressedAngle L'angle du servomoteur lorsque le bouton est enfoncé, en degré.
+/// @param speed La vitesse du servomoteur, en degrés par seconde.
+/// @param dwell Le temps pendant lequel le bouton reste enfoncé, en millisecondes.
+void Television::setDisplaySwitchProfile(unsigned int pressedAngle, unsigned int speed, unsigned int dwell)
 {
-    int pulseWidth = map(angle, 0, 180, 600, 2400);
-    digitalWrite(m_servomotorPin, HIGH);
-    delayMicroseconds(pulseWidth);
-    digitalWrite(m_servomotorPin, LOW);
-    delay(2);
+    if (pressedAngle > 180 || speed == 0)
+        return;
+
+    m_displayServoPressedAngle = pressedAngle;
+    m_displayServoSpeed = speed;
+    m_displayServoDwell = dwell;
 }
 
-/// @brief Effectue un clic sur le bouton de l'écran à l'aide d'un servomoteur.
+/// @brief Effectue un clic sur le bouton de l'écran à l'aide d'un servomoteur. Le mouvement est exécuté en arrière-plan.
 void Television::switchDisplay()
 {
-    for (int pos = 80; pos <= 130; pos++)
-    {
-        this->moveDisplayServo(pos);
-        delay(1);
-    }
-
-    for (int i = 0; i < 100; i++)
-        this->moveDisplayServo(130);
-
-    for (int pos = 130; pos >= 80; pos--)
-    {
-        this->moveDisplayServo(pos);
-        delay(1);
-    }
+    m_displayServo.moveTo(m_displayServoPressedAngle, m_displayServoSpeed, m_displayServoDwell);
+    m_displayServo.moveTo(DISPLAY_SERVO_REST_ANGLE, m_displayServoSpeed, DISPLAY_SERVO_SETTLING);
 }
 
-/// @brief Méthode permettant de détecter un son à une fréquence particulière.
-/// @return Le résultat de l'analyse.
-int Television::detectTriggerSound()
+/// @brief Exécute l'étape en cours du lancement de la vidéo, sans jamais attendre : chaque étape vérifie seulement si son délai est écoulé.
+void Television::advanceShow()
 {
-    unsigned long startTime = millis();
-    unsigned long previousPeakTime = millis();
-    int previousValue = 0;
-    int maxValue = 0;
-    int kHz1Counter = 0;
-    int kHz1_5Counter = 0;
-    int kHz2Counter = 0;
-    while ((millis() - startTime) <= 500)
+    if ((millis() - m_showStepTime) < m_showStepDelay)
+        return;
+
+    switch (m_showStage)
     {
-        int currentValue = m_microphone->getValue() - 287;
+    // Étape 2 : préparation du terrain pour la vidéo.
+    case SHOW_PREPARE_DEVICES:
+        // Un périphérique bloqué depuis le lancement (par l'alarme...) annule la vidéo : les périphériques déjà réservés sont libérés sans avoir été modifiés.
+        for (unsigned int i = 0; i < m_devicesNumber; i++)
+        {
+            if (!m_deviceList[i]->acquire(this))
+            {
+                for (unsigned int j = 0; j < i; j++)
+                    m_deviceList[j]->release(this);
 
-        if (currentValue > maxValue)
-            maxValue = currentValue;
+                this->stopMusic();
+                m_display.displayMessage("Un appareil n'est plus disponible.", "Erreur");
+                return;
+            }
+        }
 
-        if (currentValue < previousValue)
+        for (unsigned int i = 0; i < m_devicesNumber; i++)
         {
-            if (previousValue >= (maxValue * 0.75))
-            {
-                unsigned long frequency = uint64_t(1.0 / double(double(millis() - previousPeakTime) / 1000.0));
+            m_deviceList[i]->grantAccess(this, true);
+            m_deviceList[i]->turnOff();
+            m_deviceList[i]->grantAccess(this, false);
+        }
 
-                if (abs(int(frequency) - 1000) < 50)
-                {
-                    if (kHz1Counter == 5)
-                        return 1000;
+        if (!m_state)
+        {
+            this->turnOn();
+            this->setShowStage(SHOW_POWER_TELEVISION, 1000);
+        }
 
-                    kHz1Counter++;
-                }
-                
-                else if (abs(int(frequency) - 1500) < 50)
-                {
-                    if (kHz1_5Counter == 5)
-                        return 1500;
+        else
+            this->setShowStage(SHOW_POWER_TELEVISION);
 
-                    kHz1_5Counter++;
-                }
+        break;
 
-                else if (abs(int(frequency) - 2000) < 50)
-                {
-                    if (kHz2Counter == 5)
-                        return 2000;
+    case SHOW_POWER_TELEVISION:
+        if (m_volumeMuted)
+            this->unMute();
 
-                    kHz2Counter++;
-                }
+        this->setShowStage(SHOW_UNMUTE, 1000);
+        break;
 
-                previousPeakTime = millis();
-            }
+    case SHOW_UNMUTE:
+        // Les crans de volume sont mis en file d'émission, la montée s'arrête si la télévision refuse la commande.
+        while (this->getVolume() < 15)
+        {
+            unsigned int volume = this->getVolume();
+            this->increaseVolume();
+
+            if (this->getVolume() == volume)
+                break;
+        }
+
+        this->setShowStage(SHOW_RAMP_VOLUME);
+        break;
+
+    case SHOW_RAMP_VOLUME:
+        if (m_IRTransmitter.isIdle())
+            this->setShowStage(SHOW_LAUNCH_VIDEO, 2000);
+
+        break;
+
+    case SHOW_LAUNCH_VIDEO:
+        m_connection.playVideo(readProgmemString(m_currentMusic.videoURL));
+        resetTriggerSoundDetection();
+        m_display.displayMessage("En attente de la vidéo.");
+        this->setShowStage(SHOW_WAIT_TRIGGER);
+        break;
+
+    case SHOW_WAIT_TRIGGER:
+    {
+        int frequency = detectTriggerSound();
+        if (frequency != 0)
+        {
+            m_microphone->stopSampling();
+
+            if (frequency == 1000)
+                m_musicStartTime = m_triggerSoundDetectionTime - 1120;
+
+            else if (frequency == 1500)
+                m_musicStartTime = m_triggerSoundDetectionTime - 1320;
+
+            else if (frequency == 2000)
+                m_musicStartTime = m_triggerSoundDetectionTime - 1520;
+
+            m_nextActionTime = m_musicStartTime;
+            m_nextActionLoaded = false;
+
+            // Les latences mesurées sont figées pour toute la vidéo : chaque action est ainsi exécutée par un seul des deux curseurs.
+            for (unsigned int i = 0; i < m_devicesNumber && i < MUSIC_MAXIMUM_DEVICES; i++)
+                m_deviceLatencies[i] = min(m_deviceList[i]->getActuationLatency(), (unsigned int)MUSIC_LOOKAHEAD);
+
+            m_remoteActionIndex = 0;
+            m_remoteActionTime = m_musicStartTime;
+            m_remoteActionLoaded = false;
+            m_display.displayMessage("C'est parti !");
+            this->setShowStage(SHOW_PLAYING);
+        }
+
+        else if ((millis() - m_showStageStartTime) >= 40000)
+        {
+            stopMusic();
+            m_display.displayMessage("Musique non détectée", "Erreur");
         }
 
-        previousValue = currentValue;
+        break;
     }
 
-    return 0;
+    case SHOW_PLAYING:
+        scheduleMusic();
+        break;
+
+    default:
+        break;
+    }
 }
 
-/// @brief Méthode d'exécution des tâches périodiques liées au mode musique animée.
-void Television::scheduleMusic()
+/// @brief Passe à une autre étape du lancement de la vidéo, en enregistrant la durée de l'étape terminée.
+/// @param stage La nouvelle étape.
+/// @param waitingTime Le délai à attendre avant d'exécuter la nouvelle étape, en millisecondes.
+void Television::setShowStage(ShowStage stage, unsigned int waitingTime)
 {
-    Music currentMusic = getMusicFromIndex(m_currentMusicIndex);
-    Action currentAction = getAction(currentMusic, m_lastActionIndex);
+    unsigned long time = millis();
 
-    while (currentAction.timecode <= (millis() - m_musicStartTime))
-    {
-        String action = currentAction.action;
+    m_showStageDurations[m_showStage] = time - m_showStageStartTime;
+    m_showStage = stage;
+    m_showStageStartTime = time;
+    m_showStepTime = time;
+    m_showStepDelay = waitingTime;
+}
 
-        // Récupération du périphérique de sortie à partir de son ID.
-        Output *output = this->getDeviceFromID(this->getIntFromString(action, 0, 2));
+/// @brief Démarre l'échantillonnage du microphone et réinitialise la détection du son clé : les échantillons déjà enregistrés par le microphone sont ignorés. L'échantillonnage est libéré à la détection du son ou à l'arrêt de la vidéo.
+void Television::resetTriggerSoundDetection()
+{
+    m_microphone->startSampling();
+    m_samplePosition = m_microphone->getSamplePosition();
 
-        if (output == nullptr)
-            continue;
+    for (unsigned int i = 0; i < 3; i++)
+        m_triggerSoundFilters[i] = {0, 0, 0, 0};
 
-        output->unLock();
+    m_triggerSoundSamplesNumber = 0;
+    m_triggerSoundEnergy = 0;
+    m_triggerSoundDetectionTime = 0;
+}
 
-        switch (getIntFromString(action, 2, 2))
-        {
-        // Gestion de l'alimentation.
-        case 0:
+/// @brief Méthode permettant de détecter un son à une fréquence particulière. Traite uniquement les échantillons enregistrés par l'interruption du microphone depuis le dernier appel.
+/// @return La fréquence détectée, ou `0` si aucun son clé n'a été reconnu.
+int Television::detectTriggerSound()
+{
+    int samples[32];
+    unsigned int samplesNumber;
+
+    while ((samplesNumber = m_microphone->readSamples(samples, 32, m_samplePosition)) > 0)
+    {
+        for (unsigned int i = 0; i < samplesNumber; i++)
         {
-            switch (getIntFromString(action, 4, 1))
+            long sample = samples[i];
+            m_triggerSoundEnergy += sample * sample;
+
+            for (unsigned int j = 0; j < 3; j++)
             {
-            case 0:
-                output->turnOff();
-                break;
+                GoertzelFilter &filter = m_triggerSoundFilters[j];
+                long s = sample + ((TriggerSoundCoefficients[j] * filter.s1) >> 14) - filter.s2;
+                filter.s2 = filter.s1;
+                filter.s1 = s;
+            }
 
-            case 1:
-                output->turnOn();
-                break;
+            m_triggerSoundSamplesNumber++;
 
-            case 2:
-                output->toggle();
-                break;
+            if (m_triggerSoundSamplesNumber >= TRIGGER_SOUND_BLOCK_SIZE)
+            {
+                int frequency = evaluateTriggerSoundBlock(m_samplePosition - samplesNumber + i);
+                if (frequency != 0)
+                    return frequency;
             }
-
-            break;
         }
+    }
 
-        // Gestion des rubans de DEL.
-        case 1:
-        {
-            RGBLEDStrip *strip = static_cast<RGBLEDStrip *>(output);
-            strip->setMode(&m_mode);
+    return 0;
+}
 
-            strip->turnOn();
+/// @brief Évalue les filtres de Goertzel à la fin d'un bloc d'échantillons puis les réinitialise.
+/// @param endPosition La position du dernier échantillon du bloc dans le microphone : l'instant de détection est celui de son enregistrement, quel que soit le retard de la boucle.
+/// @return La fréquence détectée sur suffisamment de blocs consécutifs, ou `0`.
+int Television::evaluateTriggerSoundBlock(unsigned int endPosition)
+{
+    int frequency = 0;
 
-            switch (getIntFromString(action, 4, 1))
-            {
-            case 0:
-                m_mode.singleColor(this->getIntFromString(action, 5, 3), this->getIntFromString(action, 8, 3), this->getIntFromString(action, 11, 3));
-                break;
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        GoertzelFilter &filter = m_triggerSoundFilters[i];
 
-            case 1:
+        // Les états sont réduits avant le calcul de la puissance pour rester sur 32 bit.
+        long s1 = filter.s1 >> 2;
+        long s2 = filter.s2 >> 2;
+        long power = (s1 * s1) + (s2 * s2) - (((TriggerSoundCoefficients[i] * s1) >> 14) * s2);
+
+        // Un son pur concentre la moitié de l'énergie du bloc multipliée par sa taille dans sa raie : le son est reconnu au-delà de la moitié de ce maximum.
+        bool detected = (m_triggerSoundEnergy >= TRIGGER_SOUND_MINIMUM_ENERGY) && ((unsigned long)max(power, 0L) * 2 > m_triggerSoundEnergy * 3);
+
+        if (detected)
+        {
+            if (filter.detections == 0)
+                filter.firstDetectionTime = m_microphone->getSampleTime(endPosition);
+
+            filter.detections++;
+
+            if (filter.detections >= TRIGGER_SOUND_DETECTIONS)
             {
-                MusicsAnimationsEasing type;
+                frequency = TriggerSoundFrequencies[i];
+                m_triggerSoundDetectionTime = filter.firstDetectionTime;
+            }
+        }
 
-                switch (this->getIntFromString(action, 28, 1))
-                {
-                case 0:
-                    type = LINEAR;
-                    break;
+        else
+            filter.detections = 0;
 
-                case 1:
-                    type = IN_CUBIC;
-                    break;
+        filter.s1 = 0;
+        filter.s2 = 0;
+    }
 
-                case 2:
-                    type = OUT_CUBIC;
-                    break;
+    m_triggerSoundSamplesNumber = 0;
+    m_triggerSoundEnergy = 0;
 
-                case 3:
-                    type = IN_OUT_CUBIC;
-                    break;
-                }
+    return frequency;
+}
 
-                m_mode.smoothTransition(this->getIntFromString(action, 5, 3), this->getIntFromString(action, 8, 3), this->getIntFromString(action, 11, 3), this->getIntFromString(action, 14, 3), this->getIntFromString(action, 17, 3), this->getIntFromString(action, 20, 3), this->getIntFromString(action, 23, 5), type);
+/// @brief Méthode d'exécution des tâches périodiques liées au mode musique animée.
+void Television::scheduleMusic()
+{
+    unsigned long currentTime = millis();
 
+    // Les actions des périphériques distants (ampoules connectées) sont envoyées en avance de leur latence mesurée, par un second curseur qui parcourt la liste jusqu'à `MUSIC_LOOKAHEAD` ms en avance.
+    // Il s'arrête sur la première action distante qui n'est pas encore due, pour conserver l'ordre des actions.
+    while (!isMusicFinished(m_remoteActionIndex))
+    {
+        // Une action pas encore reçue de l'ESP sera chargée lors d'une prochaine boucle.
+        if (!m_remoteActionLoaded)
+        {
+            if (!loadAction(m_remoteActionIndex, m_remoteAction))
                 break;
-            }
 
-            case 2:
-                m_mode.strobeEffect(this->getIntFromString(action, 5, 3), this->getIntFromString(action, 8, 3), this->getIntFromString(action, 11, 3), this->getIntFromString(action, 14, 4));
-                break;
-            }
+            m_remoteActionTime += m_remoteAction.delay;
+            m_remoteActionLoaded = true;
+        }
 
+        if ((long)(currentTime + MUSIC_LOOKAHEAD - m_remoteActionTime) < 0)
             break;
-        }
 
-        // Gestion des ampoules connectées à température variable.
-        case 2:
+        uint8_t deviceIndex = this->getDeviceIndex(m_remoteAction.deviceID);
+
+        if (deviceIndex != MUSIC_NO_DEVICE && m_deviceLatencies[deviceIndex] > 0)
         {
-            ConnectedTemperatureVariableLight *light = static_cast<ConnectedTemperatureVariableLight *>(output);
+            if ((long)(currentTime + m_deviceLatencies[deviceIndex] - m_remoteActionTime) < 0)
+                break;
 
-            if (!light->getState())
-                light->turnOn();
+            this->executeAction(m_deviceList[deviceIndex], m_remoteAction);
+        }
 
-            switch (getIntFromString(action, 4, 1))
-            {
-            case 0:
-                light->setColorTemperature(getIntFromString(action, 5, 4));
-                break;
+        m_remoteActionIndex++;
+        m_remoteActionLoaded = false;
+    }
 
-            case 1:
-                light->setLuminosity(getIntFromString(action, 5, 3));
-                break;
+    while (true)
+    {
+        // Préchargement de l'action suivante, dont le délai est relatif à l'action précédente.
+        if (!m_nextActionLoaded)
+        {
+            if (isMusicFinished(m_lastActionIndex))
+            {
+                stopMusic();
+                return;
             }
 
-            break;
+            if (!loadAction(m_lastActionIndex, m_nextAction))
+                return;
+
+            m_nextActionTime += m_nextAction.delay;
+            m_nextActionLoaded = true;
         }
 
-        // Gestion des ampoules connectées à couleur variable.
-        case 3:
-        {
-            ConnectedColorVariableLight *light = static_cast<ConnectedColorVariableLight *>(output);
+        // Tant que la prochaine action n'est pas due, une seule comparaison est effectuée.
+        if ((long)(currentTime - m_nextActionTime) < 0)
+            return;
 
-            if (!light->getState())
-                light->turnOn();
+        // Les actions visant un périphérique absent de la liste ou distant (déjà exécutées par le second curseur) sont ignorées.
+        uint8_t deviceIndex = this->getDeviceIndex(m_nextAction.deviceID);
 
-            switch (getIntFromString(action, 4, 1))
-            {
-            case 0:
-                light->setColor(getIntFromString(action, 5, 3), getIntFromString(action, 8, 3), getIntFromString(action, 11, 3));
-                break;
+        if (deviceIndex != MUSIC_NO_DEVICE && m_deviceLatencies[deviceIndex] == 0)
+            this->executeAction(m_deviceList[deviceIndex], m_nextAction);
 
-            case 1:
-                light->setColorTemperature(getIntFromString(action, 5, 4));
-                break;
+        m_lastActionIndex++;
+        m_nextActionLoaded = false;
 
-            case 2:
-                light->setLuminosity(getIntFromString(action, 5, 3));
-                break;
-            }
+        // Les actions déjà exécutées par les deux curseurs libèrent leur place dans la mémoire tampon d'une musique diffusée.
+        m_musicStream.release(min(m_lastActionIndex, m_remoteActionIndex));
+    }
+}
+
+/// @brief Cherche un périphérique dans la liste des périphériques de la musique (16 au plus, un simple parcours suffit).
+/// @param ID L'identifiant du périphérique.
+/// @return La position du périphérique dans la liste, ou `MUSIC_NO_DEVICE` s'il n'y est pas.
+uint8_t Television::getDeviceIndex(unsigned int ID) const
+{
+    for (unsigned int i = 0; i < m_devicesNumber && i < MUSIC_MAXIMUM_DEVICES; i++)
+    {
+        if (m_deviceList[i]->getID() == ID)
+            return i;
+    }
+
+    return MUSIC_NO_DEVICE;
+}
+
+/// @brief Exécute une action d'une musique sur un périphérique.
+/// @param output Le périphérique visé par l'action.
+/// @param action L'action à exécuter.
+void Television::executeAction(Output *output, const Action &action)
+{
+    // La télévision agit sur les périphériques qu'elle a réservés sans les débloquer publiquement.
+    if (!output->grantAccess(this, true))
+        return;
 
+    switch (action.opcode)
+    {
+    // Gestion de l'alimentation.
+    case ACTION_TURN_OFF:
+        output->turnOff();
+        break;
+
+    case ACTION_TURN_ON:
+        output->turnOn();
+        break;
+
+    case ACTION_TOGGLE:
+        output->toggle();
+        break;
+
+    // Gestion des rubans de DEL.
+    case ACTION_STRIP_SINGLE_COLOR:
+    case ACTION_STRIP_SMOOTH_TRANSITION:
+    case ACTION_STRIP_STROBE_EFFECT:
+    {
+        RGBLEDStrip *strip = static_cast<RGBLEDStrip *>(output);
+        strip->setMode(&m_mode);
+
+        strip->turnOn();
+
+        switch (action.opcode)
+        {
+        case ACTION_STRIP_SINGLE_COLOR:
+            m_mode.singleColor(action.colors[0], action.colors[1], action.colors[2]);
+            break;
+
+        case ACTION_STRIP_SMOOTH_TRANSITION:
+            m_mode.smoothTransition(action.colors[0], action.colors[1], action.colors[2], action.colors[3], action.colors[4], action.colors[5], action.value, MusicsAnimationsEasing(action.easing));
+            break;
+
+        case ACTION_STRIP_STROBE_EFFECT:
+            m_mode.strobeEffect(action.colors[0], action.colors[1], action.colors[2], action.value);
             break;
-        }
         }
 
-        output->lock();
+        break;
+    }
 
-        m_lastActionIndex++;
+    // Gestion des ampoules connectées (l'ampoule à couleur variable hérite de l'ampoule à température variable).
+    case ACTION_LIGHT_COLOR:
+    case ACTION_LIGHT_COLOR_TEMPERATURE:
+    case ACTION_LIGHT_LUMINOSITY:
+    {
+        ConnectedTemperatureVariableLight *light = static_cast<ConnectedTemperatureVariableLight *>(output);
 
-        if (m_lastActionIndex >= currentMusic.actionsNumber)
+        if (!light->getState())
+            light->turnOn();
+
+        switch (action.opcode)
         {
-            stopMusic();
+        case ACTION_LIGHT_COLOR:
+            static_cast<ConnectedColorVariableLight *>(light)->setColor(action.colors[0], action.colors[1], action.colors[2]);
+            break;
+
+        case ACTION_LIGHT_COLOR_TEMPERATURE:
+            light->setColorTemperature(action.value);
+            break;
+
+        case ACTION_LIGHT_LUMINOSITY:
+            light->setLuminosity(action.value);
             break;
         }
 
-        currentAction = getAction(currentMusic, m_lastActionIndex);
+        break;
+    }
     }
+
+    output->grantAccess(this, false);
 }
 
-/// @brief Méthode permettant d'obtenir un objet à partir de son identifiant unique.
-/// @param ID L'identifiant unique du périphérique cherché.
-/// @return Un pointeur vers l'objet cherche (renvoie `nullptr` s'il na pas été trouvé).
-Output *Television::getDeviceFromID(unsigned int ID)
+/// @brief Charge une action de la musique en cours, depuis la mémoire flash ou depuis la mémoire tampon d'une musique diffusée.
+/// @param index La position de l'action.
+/// @param action L'action chargée.
+/// @return `false` si l'action n'est pas (encore) disponible.
+bool Television::loadAction(unsigned int index, Action &action)
 {
-    for (unsigned int i = 0; i < m_devicesNumber; i++)
-    {
-        if (m_deviceList[i]->getID() == ID)
-            return m_deviceList[i];
-    }
+    if (m_currentMusic.actionList == nullptr)
+        return m_musicStream.getAction(index, action);
+
+    if (index >= m_currentMusic.actionsNumber)
+        return false;
 
-    return nullptr;
+    memcpy_P(&action, &m_currentMusic.actionList[index], sizeof(Action));
+    return true;
 }
 
-Action Television::getAction(Music music, unsigned int actionIndex)
+/// @brief Méthode permettant de savoir si toutes les actions de la musique en cours ont été parcourues.
+/// @param index La position de l'action suivante.
+/// @return `true` si la musique ne contient pas d'action à cette position.
+bool Television::isMusicFinished(unsigned int index)
 {
-    if (actionIndex >= music.actionsNumber)
-        return Action();
+    if (m_currentMusic.actionList == nullptr)
+        return m_musicStream.isEnd(index);
 
-    Action action;
-    memcpy_P(&action, &music.actionList[actionIndex], sizeof(Action));
-    return action;
+    return index >= m_currentMusic.actionsNumber;
+}
+
+/// @brief Méthode appelée à la réception d'une action d'une musique diffusée par l'ESP.
+/// @param index La position de l'action dans la musique.
+/// @param timecode Le moment de l'action, en millisecondes depuis le début de la musique.
+/// @param action L'action au format texte utilisé dans `musics.hpp`.
+void Television::receiveMusicAction(unsigned int index, unsigned long timecode, const char *action)
+{
+    m_musicStream.receiveAction(index, timecode, action);
+}
+
+/// @brief Méthode appelée à la réception de la fin d'une musique diffusée par l'ESP.
+/// @param actionsNumber Le nombre total d'actions de la musique.
+void Television::receiveMusicEnd(unsigned int actionsNumber)
+{
+    m_musicStream.receiveEnd(actionsNumber);
 }
 
 /// @brief Méthode permettant de convertir un entier en un `String` complété de zéros pour avoir une longueur fixée.
@@ -691,24 +972,467 @@ String Television::addZeros(unsigned int number, unsigned int length)
     return result;
 }
 
-/// @brief Méthode permettant d'extraire un entier à partir d'un `String`.
-/// @param string La chaîne de caractères en entrée.
-/// @param position La position de l'entier dans la chaîne de caractères.
-/// @param lenght La longueur de l'entier.
-/// @return L'entier voulu.
-unsigned int Television::getIntFromString(String &string, unsigned int position, unsigned int lenght)
+/// @brief Constructeur de la classe.
+IRTransmitter::IRTransmitter() : m_queue(), m_head(0), m_tail(0), m_transmitting(false), m_command(), m_frame(0), m_pulse(0xFF), m_repeatsLeft(0), m_repeatFrame(false), m_frameDuration(0), m_remainingTime(0) {}
+
+/// @brief Initialise les timers utilisés pour l'émission.
+/// @param pin La broche de la DEL infrarouge, qui doit être la sortie A du timer 4 (broche 6 de l'Arduino Méga).
+/// @return `true` si l'émetteur a pu être initialisé.
+bool IRTransmitter::setup(unsigned int pin)
 {
-    int result = 0;
+    if (digitalPinToTimer(pin) != TIMER4A)
+        return false;
+
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+
+    // Timer 4 : PWM rapide avec ICR4 comme valeur maximale, pour une porteuse de 38 kHz avec un rapport cyclique d'un tiers.
+    TCCR4A = _BV(WGM41);
+    TCCR4B = _BV(WGM43) | _BV(WGM42) | _BV(CS40);
+    ICR4 = (F_CPU / IR_CARRIER_FREQUENCY) - 1;
+    OCR4A = ICR4 / 3;
 
-    for (unsigned int i = 0; i < lenght; i++)
+    setupSchedulingTimer();
+    activeTransmitter = this;
+    return true;
+}
+
+/// @brief Ajoute une commande NEC à la file d'émission et rend la main immédiatement.
+/// @param address L'adresse de l'appareil visé.
+/// @param command La commande à émettre.
+/// @param repeats Le nombre de trames de répétition à émettre après la trame principale.
+/// @param oppositeCommand La commande qui annule celle-ci (par exemple baisser le volume pour une hausse), ou `-1`. Une commande ajoutée sans commande opposée ne peut jamais être annulée.
+/// @return `false` si la file d'émission est pleine.
+bool IRTransmitter::send(uint16_t address, uint8_t command, uint8_t repeats, int oppositeCommand)
+{
+    noInterrupts();
+
+    // Une commande opposée encore en attente est retirée de la file : les deux s'annulent sans rien émettre. Les commandes ajoutées sans commande opposée (calibration du volume...) ne sont jamais retirées.
+    if (oppositeCommand >= 0 && m_head != m_tail)
+    {
+        uint8_t last = (m_tail + IR_TRANSMITTER_QUEUE_SIZE - 1) % IR_TRANSMITTER_QUEUE_SIZE;
+
+        if (m_queue[last].cancellable && m_queue[last].address == address && m_queue[last].command == oppositeCommand)
+        {
+            m_tail = last;
+            interrupts();
+            return true;
+        }
+    }
+
+    uint8_t next = (m_tail + 1) % IR_TRANSMITTER_QUEUE_SIZE;
+
+    if (next == m_head)
     {
-        int power = 1;
+        interrupts();
+        return false;
+    }
 
-        for (unsigned int j = 0; j < ((lenght - i) - 1); j++)
-            power *= 10;
+    m_queue[m_tail] = {address, command, repeats, oppositeCommand >= 0};
+    m_tail = next;
 
-        result += (string.charAt(position + i) - '0') * power;
+    // Démarrage de l'interruption si aucune émission n'est en cours.
+    if (!m_transmitting)
+    {
+        m_transmitting = true;
+        m_remainingTime = 0;
+        OCR5A = TCNT5 + 20;
+        TIFR5 = _BV(OCF5A);
+        TIMSK5 |= _BV(OCIE5A);
     }
 
-    return result;
+    interrupts();
+    return true;
+}
+
+/// @brief Méthode renvoyant le nombre de commandes en attente d'émission.
+/// @return Le nombre de commandes en attente (sans compter celle en cours d'émission).
+unsigned int IRTransmitter::getQueueDepth() const
+{
+    noInterrupts();
+    unsigned int depth = (m_tail + IR_TRANSMITTER_QUEUE_SIZE - m_head) % IR_TRANSMITTER_QUEUE_SIZE;
+    interrupts();
+
+    return depth;
+}
+
+/// @brief Méthode permettant de savoir si toutes les commandes ont été émises.
+/// @return `true` si aucune émission n'est en cours.
+bool IRTransmitter::isIdle() const
+{
+    return !m_transmitting;
+}
+
+/// @brief Méthode exécutée depuis l'interruption du timer 5 à la fin de chaque impulsion : programme l'impulsion suivante.
+void IRTransmitter::updateTransmission()
+{
+    if (m_remainingTime == 0 && !startPulse())
+    {
+        setCarrier(false);
+        TIMSK5 &= ~_BV(OCIE5A);
+        m_transmitting = false;
+        return;
+    }
+
+    // Les silences plus longs que la période du timer sont découpés en plusieurs étapes.
+    unsigned long step = min(m_remainingTime, IR_MAXIMUM_STEP);
+    m_remainingTime -= step;
+    OCR5A += step * 2;
+}
+
+/// @brief Démarre l'impulsion suivante de la trame en cours, ou la trame suivante.
+/// @return `false` si toutes les commandes ont été émises.
+bool IRTransmitter::startPulse()
+{
+    uint8_t pulsesNumber = m_repeatFrame ? IR_NEC_REPEAT_FRAME_PULSES : IR_NEC_FRAME_PULSES;
+
+    if (m_pulse >= pulsesNumber)
+    {
+        if (m_repeatsLeft > 0)
+        {
+            m_repeatsLeft--;
+            m_repeatFrame = true;
+        }
+
+        else
+        {
+            if (m_head == m_tail)
+                return false;
+
+            m_command = m_queue[m_head];
+            m_head = (m_head + 1) % IR_TRANSMITTER_QUEUE_SIZE;
+
+            // Adresse sur 16 bit (ou 8 bit suivis de leur inverse), puis commande et commande inversée, émises bit de poids faible en premier.
+            uint16_t address = m_command.address;
+            if ((address & 0xFF00) == 0)
+                address |= (uint16_t)((uint8_t)~address) << 8;
+
+            m_frame = address | ((uint32_t)m_command.command << 16) | ((uint32_t)(uint8_t)~m_command.command << 24);
+            m_repeatsLeft = m_command.repeats;
+            m_repeatFrame = false;
+        }
+
+        m_pulse = 0;
+        m_frameDuration = 0;
+        pulsesNumber = m_repeatFrame ? IR_NEC_REPEAT_FRAME_PULSES : IR_NEC_FRAME_PULSES;
+    }
+
+    bool mark = (m_pulse % 2) == 0;
+    unsigned long duration;
+
+    // Le dernier silence d'une trame complète la période de répétition, ou sépare deux commandes.
+    if (m_pulse == (pulsesNumber - 1))
+        duration = (m_repeatsLeft > 0) ? (IR_NEC_REPEAT_PERIOD - m_frameDuration) : IR_NEC_COMMAND_GAP;
+
+    else if (m_pulse == 0)
+        duration = IR_NEC_HEADER_MARK;
+
+    else if (m_pulse == 1)
+        duration = m_repeatFrame ? IR_NEC_REPEAT_SPACE : IR_NEC_HEADER_SPACE;
+
+    else if (mark)
+        duration = IR_NEC_UNIT;
+
+    else
+        duration = (m_frame & (1UL << ((m_pulse - 2) / 2))) ? IR_NEC_ONE_SPACE : IR_NEC_UNIT;
+
+    m_pulse++;
+    m_frameDuration += duration;
+    m_remainingTime = duration;
+    setCarrier(mark);
+
+    return true;
+}
+
+/// @brief Connecte ou déconnecte la porteuse de la broche de la DEL infrarouge.
+/// @param state `true` pour émettre la porteuse.
+void IRTransmitter::setCarrier(bool state)
+{
+    if (state)
+        TCCR4A |= _BV(COM4A1);
+
+    else
+        TCCR4A &= ~_BV(COM4A1);
+}
+
+/// @brief Constructeur de la classe.
+ServoOutput::ServoOutput() : m_moves(), m_head(0), m_tail(0), m_moving(false), m_portRegister(nullptr), m_pinMask(0), m_pulseHigh(false), m_pulseWidth(0), m_position(0) {}
+
+/// @brief Initialise la broche du servomoteur et le timer utilisé pour générer les impulsions.
+/// @param pin La broche de commande du servomoteur.
+/// @param angle L'angle de départ supposé du servomoteur, en degré.
+/// @return `true` si le servomoteur a pu être initialisé.
+bool ServoOutput::setup(unsigned int pin, unsigned int angle)
+{
+    if (digitalPinToPort(pin) == NOT_A_PIN || angle > 180)
+        return false;
+
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+    m_portRegister = portOutputRegister(digitalPinToPort(pin));
+    m_pinMask = digitalPinToBitMask(pin);
+    m_position = angle * 16;
+
+    setupSchedulingTimer();
+    activeServo = this;
+    return true;
+}
+
+/// @brief Ajoute un mouvement à la trajectoire du servomoteur et rend la main immédiatement.
+/// @param angle L'angle à atteindre, en degré.
+/// @param speed La vitesse du mouvement, en degrés par seconde.
+/// @param dwell Le temps de maintien à l'angle atteint avant le mouvement suivant, en millisecondes.
+/// @return `false` si le mouvement est invalide ou si la trajectoire est pleine.
+bool ServoOutput::moveTo(unsigned int angle, unsigned int speed, unsigned int dwell)
+{
+    if (m_portRegister == nullptr || angle > 180 || speed == 0)
+        return false;
+
+    noInterrupts();
+
+    uint8_t next = (m_tail + 1) % SERVO_QUEUE_SIZE;
+
+    if (next == m_head)
+    {
+        interrupts();
+        return false;
+    }
+
+    m_moves[m_tail] = {uint8_t(angle), speed, dwell};
+    m_tail = next;
+
+    // Démarrage des impulsions si le servomoteur est au repos.
+    if (!m_moving)
+    {
+        m_moving = true;
+        m_pulseHigh = false;
+        OCR5B = TCNT5 + 20;
+        TIFR5 = _BV(OCF5B);
+        TIMSK5 |= _BV(OCIE5B);
+    }
+
+    interrupts();
+    return true;
+}
+
+/// @brief Méthode permettant de savoir si le servomoteur est en mouvement.
+/// @return `true` si une trajectoire est en cours d'exécution.
+bool ServoOutput::isMoving() const
+{
+    return m_moving;
+}
+
+/// @brief Méthode renvoyant l'angle actuel du servomoteur.
+/// @return L'angle en degré.
+unsigned int ServoOutput::getAngle() const
+{
+    noInterrupts();
+    unsigned int position = m_position;
+    interrupts();
+
+    return (position + 8) / 16;
+}
+
+/// @brief Méthode exécutée depuis l'interruption du timer 5 à chaque front d'impulsion : une impulsion est émise toutes les 20 ms tant que la trajectoire n'est pas terminée.
+void ServoOutput::updatePulse()
+{
+    if (m_pulseHigh)
+    {
+        *m_portRegister &= ~m_pinMask;
+        m_pulseHigh = false;
+        OCR5B += (SERVO_PERIOD - m_pulseWidth) * 2;
+        return;
+    }
+
+    // Sans mouvement à exécuter, les impulsions s'arrêtent et le servomoteur n'est plus alimenté en consigne.
+    if (!updateTrajectory())
+    {
+        TIMSK5 &= ~_BV(OCIE5B);
+        m_moving = false;
+        return;
+    }
+
+    *m_portRegister |= m_pinMask;
+    m_pulseHigh = true;
+    m_pulseWidth = 600 + ((unsigned long)m_position * 1800 / (180 * 16));
+    OCR5B += m_pulseWidth * 2;
+}
+
+/// @brief Fait avancer la position du servomoteur d'une période le long de la trajectoire.
+/// @return `false` si tous les mouvements ont été exécutés.
+bool ServoOutput::updateTrajectory()
+{
+    while (m_head != m_tail)
+    {
+        ServoMove &move = m_moves[m_head];
+        unsigned int target = move.angle * 16;
+
+        // Déplacement vers l'angle visé, la position étant exprimée en seizièmes de degré.
+        if (m_position != target)
+        {
+            unsigned int step = max(1UL, (unsigned long)move.speed * 16 * (SERVO_PERIOD / 1000) / 1000);
+
+            if (m_position < target)
+                m_position = min(m_position + step, target);
+
+            else
+                m_position = (m_position > target + step) ? m_position - step : target;
+
+            return true;
+        }
+
+        // Maintien à l'angle atteint.
+        if (move.dwell > 0)
+        {
+            move.dwell = (move.dwell > (SERVO_PERIOD / 1000)) ? move.dwell - (SERVO_PERIOD / 1000) : 0;
+            return true;
+        }
+
+        m_head = (m_head + 1) % SERVO_QUEUE_SIZE;
+    }
+
+    return false;
+}
+
+/// @brief Constructeur de la classe.
+/// @param connection L'instance utilisée pour demander les actions à l'ESP.
+/// @param ID L'identifiant unique de la télévision.
+MusicStream::MusicStream(HomeAssistant &connection, unsigned int ID) : m_connection(connection), m_ID(ID), m_open(false), m_streamNumber(0), m_buffer(), m_firstIndex(0), m_bufferedActionsNumber(0), m_lastTimecode(0), m_requestedIndex(0), m_requestTime(0), m_renewalsNumber(0), m_failed(false), m_ended(false), m_actionsNumber(0) {}
+
+/// @brief Commence la réception d'une musique diffusée.
+/// @param streamNumber Le numéro de la musique sur l'ESP.
+void MusicStream::open(unsigned int streamNumber)
+{
+    m_open = true;
+    m_streamNumber = streamNumber;
+    m_firstIndex = 0;
+    m_bufferedActionsNumber = 0;
+    m_lastTimecode = 0;
+    m_requestedIndex = 0;
+    m_renewalsNumber = 0;
+    m_failed = false;
+    m_ended = false;
+    m_actionsNumber = 0;
+}
+
+/// @brief Arrête la réception de la musique diffusée. Les actions encore envoyées par l'ESP seront ignorées.
+void MusicStream::close()
+{
+    m_open = false;
+}
+
+/// @brief Méthode permettant de savoir si une musique est en cours de réception.
+/// @return `true` si une musique diffusée est ouverte.
+bool MusicStream::isOpen() const
+{
+    return m_open;
+}
+
+/// @brief Contrôle de flux : demande à l'ESP autant d'actions que la place libre dans la mémoire tampon, dès qu'elle est à moitié vide et que la demande précédente a été servie.
+void MusicStream::loop()
+{
+    unsigned int nextIndex = m_firstIndex + m_bufferedActionsNumber;
+    unsigned int freeSlots = MUSIC_STREAM_BUFFER_SIZE - m_bufferedActionsNumber;
+
+    if (!m_open || m_failed || (m_ended && nextIndex >= m_actionsNumber))
+        return;
+
+    // Une demande restée sans réponse complète est renouvelée à partir de la première action manquante.
+    bool renewal = m_requestedIndex > nextIndex;
+    if (renewal && (millis() - m_requestTime) < MUSIC_STREAM_REQUEST_TIMEOUT)
+        return;
+
+    if (freeSlots < (MUSIC_STREAM_BUFFER_SIZE / 2))
+        return;
+
+    // Après plusieurs demandes renouvelées sans qu'aucune action ne soit reçue, l'ESP est considéré comme injoignable.
+    if (renewal && ++m_renewalsNumber > MUSIC_STREAM_MAXIMUM_RENEWALS)
+    {
+        m_failed = true;
+        return;
+    }
+
+    m_requestedIndex = nextIndex + freeSlots;
+    m_requestTime = millis();
+    m_connection.requestMusicActions(m_ID, m_streamNumber, nextIndex, freeSlots);
+}
+
+/// @brief Ajoute une action reçue à la mémoire tampon. Les actions sont compilées comme celles de `musics.hpp`, après vérification : une action invalide n'est pas compilée, et seul son délai est conservé dans une action sans périphérique (`MUSIC_NO_DEVICE`) qui sera ignorée.
+/// @param index La position de l'action dans la musique, qui doit suivre la dernière action reçue.
+/// @param timecode Le moment de l'action, en millisecondes depuis le début de la musique.
+/// @param action L'action au format texte.
+void MusicStream::receiveAction(unsigned int index, unsigned long timecode, const char *action)
+{
+    if (!m_open || (m_ended && index >= m_actionsNumber) || index != (m_firstIndex + m_bufferedActionsNumber) || m_bufferedActionsNumber >= MUSIC_STREAM_BUFFER_SIZE)
+        return;
+
+    unsigned long previousTimecode = (index == 0) ? 0 : m_lastTimecode;
+
+    // Des actions non triées ou trop espacées terminent la musique à cette position.
+    if (timecode < previousTimecode || (timecode - previousTimecode) > 65535UL)
+    {
+        this->receiveEnd(index);
+        return;
+    }
+
+    if (isActionValid(action))
+        m_buffer[index % MUSIC_STREAM_BUFFER_SIZE] = compileAction(ActionSource{timecode, action}, previousTimecode);
+
+    else
+        m_buffer[index % MUSIC_STREAM_BUFFER_SIZE] = Action{uint16_t(timecode - previousTimecode), MUSIC_NO_DEVICE, ACTION_TURN_OFF, 0, {}, 0};
+
+    m_lastTimecode = timecode;
+    m_bufferedActionsNumber++;
+    m_renewalsNumber = 0;
+}
+
+/// @brief Enregistre la fin de la musique diffusée.
+/// @param actionsNumber Le nombre total d'actions de la musique.
+void MusicStream::receiveEnd(unsigned int actionsNumber)
+{
+    if (!m_open)
+        return;
+
+    m_ended = true;
+    m_actionsNumber = actionsNumber;
+    m_renewalsNumber = 0;
+}
+
+/// @brief Méthode permettant de savoir si l'ESP a cessé de répondre aux demandes d'actions.
+/// @return `true` si la musique ouverte ne peut plus être reçue.
+bool MusicStream::isFailed() const
+{
+    return m_open && m_failed;
+}
+
+/// @brief Lit une action de la mémoire tampon.
+/// @param index La position de l'action dans la musique.
+/// @param action L'action lue.
+/// @return `false` si l'action n'a pas encore été reçue ou a déjà été libérée.
+bool MusicStream::getAction(unsigned int index, Action &action) const
+{
+    if (!m_open || index < m_firstIndex || index >= (m_firstIndex + m_bufferedActionsNumber))
+        return false;
+
+    action = m_buffer[index % MUSIC_STREAM_BUFFER_SIZE];
+    return true;
+}
+
+/// @brief Méthode permettant de savoir si une position se trouve après la dernière action de la musique.
+/// @param index La position à tester.
+/// @return `true` si la fin de la musique a été reçue et que la position la dépasse.
+bool MusicStream::isEnd(unsigned int index) const
+{
+    return !m_open || (m_ended && index >= m_actionsNumber);
+}
+
+/// @brief Libère la place des actions déjà exécutées.
+/// @param index La position de la première action encore nécessaire.
+void MusicStream::release(unsigned int index)
+{
+    while (m_bufferedActionsNumber > 0 && m_firstIndex < index)
+    {
+        m_firstIndex++;
+        m_bufferedActionsNumber--;
+    }
 }
\ No newline at end of file
@@ -3,11 +3,10 @@
 
 // Ajout des bibliothèques au programme.
 #include <Arduino.h>
-#define USE_IRREMOTE_HPP_AS_PLAIN_INCLUDE
-#include <IRremote.hpp>
 
 // Autres fichiers du programme.
 #include "utils/readPROGMEMString.hpp"
+#include "utils/musicActions.hpp"
 #include "device/output/output.hpp"
 #include "device/interface/display.hpp"
 #include "device/interface/HomeAssistant.hpp"
@@ -15,22 +14,148 @@
 #include "device/output/connectedOutput.hpp"
 #include "device/input/analogInput.hpp"
 
-/// @brief Structure stockant une liste d'actions associées à un temps pour une musique.
-struct Action
+#define IR_TRANSMITTER_QUEUE_SIZE 40
+
+/// @brief Structure stockant une commande infrarouge NEC en attente d'émission, et si elle peut être annulée par sa commande opposée.
+struct IRCommand
+{
+    uint16_t address;
+    uint8_t command;
+    uint8_t repeats;
+    bool cancellable;
+};
+
+/// @brief Classe émettant des commandes infrarouges NEC en arrière-plan : la porteuse est générée par le timer 4 et les impulsions sont cadencées par l'interruption du timer 5.
+class IRTransmitter
+{
+public:
+    IRTransmitter();
+    bool setup(unsigned int pin);
+    bool send(uint16_t address, uint8_t command, uint8_t repeats, int oppositeCommand = -1);
+    unsigned int getQueueDepth() const;
+    bool isIdle() const;
+    void updateTransmission();
+
+protected:
+    bool startPulse();
+    void setCarrier(bool state);
+
+    IRCommand m_queue[IR_TRANSMITTER_QUEUE_SIZE];
+    volatile uint8_t m_head;
+    volatile uint8_t m_tail;
+    volatile bool m_transmitting;
+    IRCommand m_command;
+    uint32_t m_frame;
+    uint8_t m_pulse;
+    uint8_t m_repeatsLeft;
+    bool m_repeatFrame;
+    unsigned long m_frameDuration;
+    unsigned long m_remainingTime;
+};
+
+#define SERVO_QUEUE_SIZE 4
+#define SERVO_PERIOD 20000
+
+/// @brief Structure décrivant un mouvement du servomoteur : angle visé, vitesse en degrés par seconde et temps de maintien en millisecondes.
+struct ServoMove
 {
-    unsigned long timecode;
-    char action[32];
+    uint8_t angle;
+    unsigned int speed;
+    unsigned int dwell;
 };
 
-/// @brief Structure stockant une musique pour le système de musique animée.
-struct Music
+/// @brief Classe pilotant un servomoteur en arrière-plan : les impulsions sont générées par l'interruption du timer 5, qui fait avancer la trajectoire à chaque période.
+class ServoOutput
 {
-    const char *friendlyName;
-    const char *videoURL;
-    const Action *actionList;
-    unsigned int actionsNumber;
+public:
+    ServoOutput();
+    bool setup(unsigned int pin, unsigned int angle);
+    bool moveTo(unsigned int angle, unsigned int speed, unsigned int dwell = 0);
+    bool isMoving() const;
+    unsigned int getAngle() const;
+    void updatePulse();
+
+protected:
+    bool updateTrajectory();
+
+    ServoMove m_moves[SERVO_QUEUE_SIZE];
+    volatile uint8_t m_head;
+    volatile uint8_t m_tail;
+    volatile bool m_moving;
+    volatile uint8_t *m_portRegister;
+    uint8_t m_pinMask;
+    bool m_pulseHigh;
+    unsigned int m_pulseWidth;
+    volatile unsigned int m_position;
 };
 
+/// @brief Structure stockant l'état d'un filtre de Goertzel utilisé pour détecter le son de lancement d'une vidéo.
+struct GoertzelFilter
+{
+    long s1;
+    long s2;
+    unsigned int detections;
+    unsigned long firstDetectionTime;
+};
+
+/// @brief Étapes du lancement d'une vidéo, exécutées successivement depuis la boucle de la télévision.
+enum ShowStage
+{
+    SHOW_IDLE,
+    SHOW_PREPARE_DEVICES,
+    SHOW_POWER_TELEVISION,
+    SHOW_UNMUTE,
+    SHOW_RAMP_VOLUME,
+    SHOW_LAUNCH_VIDEO,
+    SHOW_WAIT_TRIGGER,
+    SHOW_PLAYING,
+    SHOW_STAGES_NUMBER,
+};
+
+#define MUSIC_STREAM_BUFFER_SIZE 16
+#define MUSIC_STREAM_REQUEST_TIMEOUT 1000
+#define MUSIC_STREAM_MAXIMUM_RENEWALS 5
+
+/// @brief Classe recevant depuis l'ESP les actions d'une musique diffusée (`actionList` à `nullptr`), dans une mémoire tampon circulaire remplie à l'avance.
+class MusicStream
+{
+public:
+    MusicStream(HomeAssistant &connection, unsigned int ID);
+    void open(unsigned int streamNumber);
+    void close();
+    bool isOpen() const;
+    void loop();
+    void receiveAction(unsigned int index, unsigned long timecode, const char *action);
+    void receiveEnd(unsigned int actionsNumber);
+    bool getAction(unsigned int index, Action &action) const;
+    bool isEnd(unsigned int index) const;
+    void release(unsigned int index);
+    bool isFailed() const;
+
+protected:
+    HomeAssistant &m_connection;
+    const unsigned int m_ID;
+    bool m_open;
+    unsigned int m_streamNumber;
+    Action m_buffer[MUSIC_STREAM_BUFFER_SIZE];
+    unsigned int m_firstIndex;
+    unsigned int m_bufferedActionsNumber;
+    unsigned long m_lastTimecode;
+    unsigned int m_requestedIndex;
+    unsigned long m_requestTime;
+    unsigned int m_renewalsNumber;
+    bool m_failed;
+    bool m_ended;
+    unsigned int m_actionsNumber;
+};
+
+// Nombre maximal de périphériques pilotables par une musique, et position renvoyée pour un périphérique absent de la liste.
+#define MUSIC_MAXIMUM_DEVICES 16
+#define MUSIC_NO_DEVICE 0xFF
+
+// Avance maximale avec laquelle les actions des périphériques distants sont envoyées, en millisecondes.
+#define MUSIC_LOOKAHEAD 1000
+
 /// @brief Classe représentant une télévision.
 class Television : public Output
 {
@@ -38,7 +163,7 @@ public:
     Television(const __FlashStringHelper *friendlyName, unsigned int ID, HomeAssistant &connection, Display &display, int servomotorPin, int IRLEDPin, int volume, MusicsAnimationsMode &mode);
     virtual void setMusicDevices(Output *deviceList[], unsigned int devicesNumber);
     virtual void setMusicsList(const Music *const *musicList, unsigned int musicsNumber);
-    virtual void setMicrophone(AnalogInput &microphone);
+    virtual void setMicrophone(Microphone &microphone);
     virtual void setup() override;
     virtual void reportState() override;
     virtual void loop() override;
@@ -57,36 +182,71 @@ public:
     virtual Music getMusicFromIndex(unsigned int index);
     virtual void playMusic(unsigned int musicIndex);
     virtual void stopMusic();
+    virtual void receiveMusicAction(unsigned int index, unsigned long timecode, const char *action);
+    virtual void receiveMusicEnd(unsigned int actionsNumber);
+    virtual unsigned int getIRQueueDepth() const;
+    virtual void setDisplaySwitchProfile(unsigned int pressedAngle, unsigned int speed, unsigned int dwell);
+    virtual ShowStage getShowStage() const;
+    virtual unsigned long getShowStageDuration(ShowStage stage) const;
     virtual void shutdown() override;
 
 protected:
-    virtual void moveDisplayServo(unsigned int angle);
     virtual void switchDisplay();
+    virtual void advanceShow();
+    virtual void setShowStage(ShowStage stage, unsigned int waitingTime = 0);
+    virtual void resetTriggerSoundDetection();
     virtual int detectTriggerSound();
+    virtual int evaluateTriggerSoundBlock(unsigned int endPosition);
     virtual void scheduleMusic();
-    virtual Output *getDeviceFromID(unsigned int ID);
-    virtual Action getAction(Music music, unsigned int actionIndex);
+    virtual bool loadAction(unsigned int index, Action &action);
+    virtual bool isMusicFinished(unsigned int index);
+    virtual uint8_t getDeviceIndex(unsigned int ID) const;
+    virtual void executeAction(Output *output, const Action &action);
 
     static String addZeros(unsigned int number, unsigned int length);
-    static unsigned int getIntFromString(String &string, unsigned int position, unsigned int lenght);
 
     const int m_servomotorPin;
     const int m_IRLEDPin;
-    IRsend m_IRSender;
+    IRTransmitter m_IRTransmitter;
+    ServoOutput m_displayServo;
+    unsigned int m_displayServoPressedAngle;
+    unsigned int m_displayServoSpeed;
+    unsigned int m_displayServoDwell;
+    unsigned int m_syncVolumeDecreases;
+    unsigned int m_syncVolumeIncreases;
+    bool m_syncVolumeShareInformation;
     unsigned int m_volume;
     bool m_volumeMuted;
     unsigned long m_lastTime;
-    bool m_waitingForTriggerSound;
-    AnalogInput *m_microphone;
+    Microphone *m_microphone;
+    unsigned int m_samplePosition;
+    GoertzelFilter m_triggerSoundFilters[3];
+    unsigned int m_triggerSoundSamplesNumber;
+    unsigned long m_triggerSoundEnergy;
+    unsigned long m_triggerSoundDetectionTime;
+    ShowStage m_showStage;
+    unsigned long m_showStageStartTime;
+    unsigned long m_showStageDurations[SHOW_STAGES_NUMBER];
+    unsigned long m_showStepTime;
+    unsigned int m_showStepDelay;
     unsigned long m_musicStartTime;
     unsigned int m_lastActionIndex;
+    unsigned long m_nextActionTime;
+    Music m_currentMusic;
+    Action m_nextAction;
+    bool m_nextActionLoaded;
+    unsigned int m_remoteActionIndex;
+    unsigned long m_remoteActionTime;
+    Action m_remoteAction;
+    bool m_remoteActionLoaded;
+    MusicStream m_musicStream;
+    unsigned int m_deviceLatencies[MUSIC_MAXIMUM_DEVICES];
     const Music *const *m_musicList;
     int m_currentMusicIndex;
     unsigned int m_musicsNumber;
     Output **m_deviceList;
     unsigned int m_devicesNumber;
     MusicsAnimationsMode &m_mode;
-    unsigned long m_detectionStartTime;
 };
 
 #endif
\ No newline at end of file
@@ -23,7 +23,7 @@
 /// @param motorPin1 La broche 1 liée au contrôleur du moteur.
 /// @param motorPin2 La broche 2 liée au contrôleur du moteur.
 /// @param speedPin La broche liée au contrôleur du moteur, gérant sa vitesse.
-Tray::Tray(const __FlashStringHelper* friendlyName, unsigned int ID, HomeAssistant &connection, Display &display, unsigned int motorPin1, unsigned int motorPin2, unsigned int speedPin) : Output(friendlyName, ID, connection, display), m_motorPin1(motorPin1), m_motorPin2(motorPin2), m_speedPin(speedPin) {}
+Tray::Tray(const __FlashStringHelper* friendlyName, unsigned int ID, HomeAssistant &connection, Display &display, unsigned int motorPin1, unsigned int motorPin2, unsigned int speedPin) : Output(friendlyName, ID, connection, display), m_motorPin1(motorPin1), m_motorPin2(motorPin2), m_speedPin(speedPin), m_motion(TRAY_STOPPED), m_opening(false), m_motionStart(0), m_rampDuration(TRAY_RAMP_DURATION), m_runDuration(TRAY_RUN_DURATION), m_brakeDuration(TRAY_BRAKE_DURATION) {}
 
 /// @brief Initialise l'objet.
 void Tray::setup()
@@ -38,46 +38,129 @@ void Tray::setup()
     m_connection.updateDeviceAvailability(m_ID, true);
 }
 
-/// @brief Ouvre le plateau
+/// @brief Ouvre le plateau. Le déplacement est exécuté en arrière-plan.
 /// @param shareInformation Affiche ou non l'animation d'ouverture sur l'écran.
 void Tray::turnOn(bool shareInformation)
 {
-    if (!m_operational || m_locked || m_state)
+    if (!m_operational || m_locked || m_state || m_motion != TRAY_STOPPED)
         return;
 
     m_connection.updateOutputDeviceState(m_ID, true);
-
-    analogWrite(m_speedPin, 120);
-    digitalWrite(m_motorPin1, LOW);
-    digitalWrite(m_motorPin2, HIGH);
-
-    m_display.displayTray(true, shareInformation);
-
-    digitalWrite(m_motorPin1, HIGH);
-    digitalWrite(m_motorPin2, HIGH);
-    analogWrite(m_speedPin, 120);
-
+    this->startMotion(true, shareInformation);
     m_state = true;
 }
 
-/// @brief Ferme le plateau
+/// @brief Ferme le plateau. Le déplacement est exécuté en arrière-plan.
 /// @param shareInformation Affiche ou non l'animation de fermeture sur l'écran.
 void Tray::turnOff(bool shareInformation)
 {
-    if (!m_operational || m_locked || !m_state)
+    if (!m_operational || m_locked || !m_state || m_motion != TRAY_STOPPED)
         return;
 
     m_connection.updateOutputDeviceState(m_ID, false);
+    this->startMotion(false, shareInformation);
+    m_state = false;
+}
 
-    analogWrite(m_speedPin, 140);
-    digitalWrite(m_motorPin1, HIGH);
-    digitalWrite(m_motorPin2, LOW);
+/// @brief Modifie les durées des étapes du déplacement du plateau.
+/// @param rampDuration La durée de l'accélération du moteur, en millisecondes.
+/// @param runDuration La durée du déplacement à vitesse constante, en millisecondes.
+/// @param brakeDuration La durée du freinage, pendant laquelle aucun nouveau déplacement n'est accepté, en millisecondes.
+void Tray::setMotionProfile(unsigned int rampDuration, unsigned int runDuration, unsigned int brakeDuration)
+{
+    if (m_motion != TRAY_STOPPED)
+        return;
+
+    m_rampDuration = rampDuration;
+    m_runDuration = runDuration;
+    m_brakeDuration = brakeDuration;
+}
+
+/// @brief Méthode permettant de savoir si le plateau est en mouvement.
+/// @return `true` si un déplacement (ou son freinage) est en cours.
+bool Tray::isMoving() const
+{
+    return m_motion != TRAY_STOPPED;
+}
+
+/// @brief Exécute les tâches liées au plateau : avancement du déplacement en cours.
+void Tray::loop()
+{
+    if (!m_operational)
+        return;
+
+    this->updateMotion();
+}
+
+/// @brief Arrête le plateau : le déplacement en cours est terminé puis le plateau est refermé, de manière bloquante puisque la boucle n'est plus exécutée.
+void Tray::shutdown()
+{
+    while (m_motion != TRAY_STOPPED)
+        this->updateMotion();
+
+    Output::shutdown();
+
+    while (m_motion != TRAY_STOPPED)
+        this->updateMotion();
+}
+
+/// @brief Démarre un déplacement du plateau et l'animation correspondante sur l'écran.
+/// @param opening Le sens du déplacement (`true` pour l'ouverture).
+/// @param shareInformation Affiche ou non l'animation sur l'écran.
+void Tray::startMotion(bool opening, bool shareInformation)
+{
+    m_opening = opening;
+    m_motion = TRAY_RAMP;
+    m_motionStart = millis();
 
-    m_display.displayTray(false, shareInformation);
+    analogWrite(m_speedPin, 0);
+    digitalWrite(m_motorPin1, opening ? LOW : HIGH);
+    digitalWrite(m_motorPin2, opening ? HIGH : LOW);
+
+    if (shareInformation)
+        m_display.displayTray(opening, m_rampDuration + m_runDuration);
+
+    this->updateMotion();
+}
+
+/// @brief Fait avancer le déplacement en cours en fonction du temps écoulé depuis son démarrage.
+void Tray::updateMotion()
+{
+    if (m_motion == TRAY_STOPPED)
+        return;
 
+    unsigned long elapsedTime = millis() - m_motionStart;
+    unsigned int speed = m_opening ? TRAY_OPENING_SPEED : TRAY_CLOSING_SPEED;
+
+    if (m_motion == TRAY_RAMP)
+    {
+        if (elapsedTime < m_rampDuration)
+        {
+            analogWrite(m_speedPin, (speed * elapsedTime) / m_rampDuration);
+            return;
+        }
+
+        analogWrite(m_speedPin, speed);
+        m_motion = TRAY_RUN;
+    }
+
+    if (m_motion == TRAY_RUN)
+    {
+        if (elapsedTime < (unsigned long)m_rampDuration + m_runDuration)
+            return;
+
+        this->brake();
+        m_motion = TRAY_BRAKE;
+    }
+
+    if (elapsedTime >= (unsigned long)m_rampDuration + m_runDuration + m_brakeDuration)
+        m_motion = TRAY_STOPPED;
+}
+
+/// @brief Freine le moteur en reliant ses deux bornes.
+void Tray::brake()
+{
     digitalWrite(m_motorPin1, HIGH);
     digitalWrite(m_motorPin2, HIGH);
-    analogWrite(m_speedPin, 140);
-
-    m_state = false;
-}
\ No newline at end of file
+    analogWrite(m_speedPin, m_opening ? TRAY_OPENING_SPEED : TRAY_CLOSING_SPEED);
+}
@@ -9,6 +9,24 @@
 #include "device/interface/display.hpp"
 #include "device/interface/HomeAssistant.hpp"
 
+// Vitesses du moteur (PWM) pour chaque sens de déplacement.
+#define TRAY_OPENING_SPEED 120
+#define TRAY_CLOSING_SPEED 140
+
+// Durées par défaut (en ms) des étapes du déplacement du plateau.
+#define TRAY_RAMP_DURATION 150
+#define TRAY_RUN_DURATION 1125
+#define TRAY_BRAKE_DURATION 100
+
+/// @brief Étapes du déplacement du plateau.
+enum TrayMotion
+{
+    TRAY_STOPPED,
+    TRAY_RAMP,
+    TRAY_RUN,
+    TRAY_BRAKE,
+};
+
 /// @brief Classe gérant un plateau.
 class Tray : public Output
 {
@@ -17,11 +35,25 @@ public:
     virtual void setup() override;
     virtual void turnOn(bool shareInformation = false) override;
     virtual void turnOff(bool shareInformation = false) override;
+    virtual void setMotionProfile(unsigned int rampDuration, unsigned int runDuration, unsigned int brakeDuration);
+    virtual bool isMoving() const;
+    virtual void loop() override;
+    virtual void shutdown() override;
 
 protected:
+    virtual void startMotion(bool opening, bool shareInformation);
+    virtual void updateMotion();
+    virtual void brake();
+
     const unsigned int m_motorPin1;
     const unsigned int m_motorPin2;
     const unsigned int m_speedPin;
+    TrayMotion m_motion;
+    bool m_opening;
+    unsigned long m_motionStart;
+    unsigned int m_rampDuration;
+    unsigned int m_runDuration;
+    unsigned int m_brakeDuration;
 };
 
 #endif
\ No newline at end of file
@@ -32,10 +32,28 @@
 #define ID_BED_LIGHT 98
 #define ID_CAMERA_LIGHT 99
 
+// Périphériques pilotables par les musiques : identifiant, type (voir `ActionDeviceType`, qui détermine les actions acceptées) et variable correspondante dans main.cpp. Cette table est l'unique source de la validation des actions (`actionDeviceType()`), de la liste passée à `Television::setMusicDevices` et de l'outil tools/showtool.py.
+#define MUSIC_DEVICES(DEVICE)                                         \
+    DEVICE(ID_TRAY, ACTION_DEVICE_OUTPUT, tray)                       \
+    DEVICE(ID_LED_CUBE, ACTION_DEVICE_OUTPUT, LEDCube)                \
+    DEVICE(ID_DISCO, ACTION_DEVICE_OUTPUT, disco)                     \
+    DEVICE(ID_BEACON, ACTION_DEVICE_OUTPUT, beacon)                   \
+    DEVICE(ID_WARDROBE_LIGHTS, ACTION_DEVICE_OUTPUT, wardrobeLights)  \
+    DEVICE(ID_STREET, ACTION_DEVICE_OUTPUT, street)                   \
+    DEVICE(ID_DESK_LIGHT, ACTION_DEVICE_OUTPUT, deskLight)            \
+    DEVICE(ID_DOOR_LED, ACTION_DEVICE_OUTPUT, doorLED)                \
+    DEVICE(ID_LED_STRIP, ACTION_DEVICE_STRIP, LEDStrip)               \
+    DEVICE(ID_ALARM, ACTION_DEVICE_OUTPUT, alarm)                     \
+    DEVICE(ID_MAIN_LIGHTS, ACTION_DEVICE_OUTPUT, mainLights)          \
+    DEVICE(ID_SOFA_LIGHT, ACTION_DEVICE_TEMPERATURE_LIGHT, sofaLight) \
+    DEVICE(ID_BED_LIGHT, ACTION_DEVICE_COLOR_LIGHT, bedLight)         \
+    DEVICE(ID_CAMERA_LIGHT, ACTION_DEVICE_OUTPUT, cameraLight)
+
 // Modes du ruban de DEL.
 #define ID_COLOR_MODE 0
 #define ID_RAINBOW_MODE 1
 #define ID_SOUND_REACT_MODE 2
 #define ID_ALARM_MODE 3
+#define ID_SPECTRUM_MODE 5
 
 #endif
\ No newline at end of file
@@ -32,6 +32,9 @@
 #include "device/input/IRSensor.hpp"
 #include "musics.hpp"
 
+// Adresse du périphérique d'une entrée de la table `MUSIC_DEVICES` (deviceID.hpp).
+#define MUSIC_DEVICE_OUTPUT(ID, type, device) &device,
+
 // Initialisation du système.
 void setup()
 {
@@ -84,7 +87,7 @@ void setup()
     BinaryInput presenceSensor(F("Présence"), ID_PRESENCE_SENSOR, HomeAssistantConnection, PIN_MOTION_SENSOR, false, false);
     Doorbell doorbell(F("Sonnette"), ID_DOORBELL, HomeAssistantConnection, PIN_DOORBELL_BUTTON, false, false, display, buzzer);
     AnalogInput lightSensor(F("Luminosité"), ID_LIGHT_SENSOR, HomeAssistantConnection, PIN_LIGHT_SENSOR, false);
-    AnalogInput microphone(F("Microphone"), ID_MICROPHONE, HomeAssistantConnection, PIN_MICROPHONE, false);
+    Microphone microphone(F("Microphone"), ID_MICROPHONE, HomeAssistantConnection, PIN_MICROPHONE, false);
     television.setMicrophone(microphone);
     AirSensor airSensor(F("Air"), ID_AIR_SENSOR, HomeAssistantConnection, PIN_AIR_SENSOR);
     IRSensor iRSensor(F("Capteur infrarouge"), ID_IR_SENSOR, HomeAssistantConnection, PIN_IR_SENSOR, television, remoteDeviceList, remoteDevicesNumber);
@@ -93,6 +96,7 @@ void setup()
     ColorMode colorMode(F("Mode couleur unique"), ID_COLOR_MODE, LEDStrip, HomeAssistantConnection);
     RainbowMode rainbowMode(F("Mode arc-en-ciel"), ID_RAINBOW_MODE, LEDStrip, EEPROM_RAINBOW_ANIMATION_SPEED);
     SoundreactMode soundreactMode(F("Mode son-réaction"), ID_SOUND_REACT_MODE, LEDStrip, microphone, EEPROM_SOUND_REACT_ANIMATION_SENSITIVITY);
+    SpectrumMode spectrumMode(F("Mode spectre"), ID_SPECTRUM_MODE, LEDStrip, microphone);
     LEDStrip.setMode(&colorMode);
 
     // Listes des modes des rubans de DEL.
@@ -100,6 +104,7 @@ void setup()
     RGBLEDStripMode *rainbowModeList[] = {&rainbowMode};
     RGBLEDStripMode *soundreactModeList[] = {&soundreactMode};
     RGBLEDStripMode *alarmModeList[] = {&alarmMode};
+    RGBLEDStripMode *spectrumModeList[] = {&spectrumMode};
     int RGBLEDStripNumber = 1;
 
     // Liste des musiques.
@@ -107,8 +112,8 @@ void setup()
     int musicsNumber = 3;
 
     // Création d'une liste contenant des références vers tous les actionneurs utilisés par le système de musique animée.
-    Output *outputList[] = {&tray, &LEDCube, &disco, &beacon, &wardrobeLights, &street, &deskLight, &doorLED, &LEDStrip, &alarm, &mainLights, &sofaLight, &bedLight, &cameraLight};
-    int outputsNumber = 14;
+    Output *outputList[] = {MUSIC_DEVICES(MUSIC_DEVICE_OUTPUT)};
+    int outputsNumber = sizeof(outputList) / sizeof(outputList[0]);
 
     // Création d'une liste contenant des références vers tous les capteurs.
     Input *inputList[] = {&wardrobeDoorSensor, &doorSensor, &presenceSensor, &doorbell, &lightSensor, &microphone, &airSensor, &iRSensor};
@@ -136,6 +141,7 @@ void setup()
     RainbowMode *keypadStripRainbowModeList[] = {&rainbowMode};
     SoundreactMode *keypadStripSoundreactModeList[] = {&soundreactMode};
     AlarmMode *keypadStripAlarmModeList[] = {&alarmMode};
+    SpectrumMode *keypadStripSpectrumModeList[] = {&spectrumMode};
     int keypadStripsNumber = 1;
     ConnectedTemperatureVariableLight *keypadConnectedTemperatureVariableLightList[] = {&sofaLight};
     int keypadConnectedTemperatureVariableLightsNumber = 1;
@@ -164,7 +170,7 @@ void setup()
     randomSeed(analogRead(PIN_RANDOM_SEED_GENERATOR));
 
     // Définition des périphériques utilisés dans la connextion à Home Assistant.
-    HomeAssistantConnection.setDevices(HADeviceList, HADevicesNumber, inputList, inputsNumber, HARemoteDeviceList, HARemoteDevicesNumber, colorModeList, rainbowModeList, soundreactModeList, alarmModeList, RGBLEDStripNumber);
+    HomeAssistantConnection.setDevices(HADeviceList, HADevicesNumber, inputList, inputsNumber, HARemoteDeviceList, HARemoteDevicesNumber, colorModeList, rainbowModeList, soundreactModeList, alarmModeList, spectrumModeList, RGBLEDStripNumber);
 
     // Définition des périphériques contrôlables depuis le clavier de contrôle.
     keypad.setDevices(keypadDeviceList,
@@ -176,6 +182,7 @@ void setup()
                       keypadStripRainbowModeList,
                       keypadStripSoundreactModeList,
                       keypadStripAlarmModeList,
+                      keypadStripSpectrumModeList,
                       keypadStripsNumber,
                       keypadConnectedTemperatureVariableLightList,
                       keypadConnectedTemperatureVariableLightsNumber,
@@ -5,7 +5,7 @@
 #include "device/output/television.hpp"
 
 // Musique : World Smallest Violin.
-const Action worldsSmallestViolinActions[] PROGMEM = {
+constexpr ActionSource worldsSmallestViolinActionSources[] = {
     {3900, "09011000000000255255255041002"},
     {8000, "09000"},
     {9000, "96001"},
@@ -13,7 +13,6 @@ const Action worldsSmallestViolinActions[] PROGMEM = {
     {11001, "97001"},
     {13000, "97000"},
     {13001, "98001"},
-    {11000, "96000"},
     {15000, "09011000050050255000000020003"},
     {17500, "09010200000000"},
     {19225, "09010125000000"},
@@ -32,16 +31,17 @@ const Action worldsSmallestViolinActions[] PROGMEM = {
     {58004, "09000"},
     {58005, "97000"},
 };
+constexpr ActionList<countActions(worldsSmallestViolinActionSources)> worldsSmallestViolinActions PROGMEM = compileActions(worldsSmallestViolinActionSources);
 const char worldsSmallestViolinName[] PROGMEM = "World's Smallest Violin";
 const char worldsSmallestViolinVideoURL[] PROGMEM = "https://files.catbox.moe/cq6ib0.mp4";
 const Music worldsSmallestViolinMusic PROGMEM = {
     worldsSmallestViolinName,
     worldsSmallestViolinVideoURL,
-    worldsSmallestViolinActions,
-    25};
+    worldsSmallestViolinActions.actions,
+    countActions(worldsSmallestViolinActionSources)};
 
 // Musique : Cruel Summer.
-const Action CruelSummerActions[] PROGMEM = {
+constexpr ActionSource CruelSummerActionSources[] = {
     {2280, "09010255000000"},
     {4360, "98030255000000"},
     {5800, "970206535"},
@@ -89,7 +89,7 @@ const Action CruelSummerActions[] PROGMEM = {
     {41885, "96000"},
     {41886, "97000"},
     {41887, "98000"},
-    {42520, "0901225522103301400"},
+    {42520, "090122552210330140"},
     {53200, "03000"},
     {53201, "09000"},
     {55920, "09010091066044"},
@@ -133,7 +133,7 @@ const Action CruelSummerActions[] PROGMEM = {
     {118240, "09000"},
     {118241, "98001"},
     {120880, "98000"},
-    {121000, "0901201407509400100"},
+    {121000, "090120140750940010"},
     {123960, "09000"},
     {126520, "09011000000000189255241010001"},
     {127520, "96001"},
@@ -167,30 +167,32 @@ const Action CruelSummerActions[] PROGMEM = {
     {173120, "03000"},
     {177600, "99000"},
 };
+constexpr ActionList<countActions(CruelSummerActionSources)> CruelSummerActions PROGMEM = compileActions(CruelSummerActionSources);
 const char CruelSummerName[] PROGMEM = "Cruel Summer";
 const char CruelSummerVideoURL[] PROGMEM = "https://files.catbox.moe/z0b1qk.mp4";
 const Music CruelSummerMusic PROGMEM = {
     CruelSummerName,
     CruelSummerVideoURL,
-    CruelSummerActions,
-    124};
+    CruelSummerActions.actions,
+    countActions(CruelSummerActionSources)};
 
 // Musique : Test.
-const Action testActions[] PROGMEM = {
+constexpr ActionSource testActionSources[] = {
     {2000, "05001"},
     {2480, "05000"},
     {2960, "05001"},
     {3440, "05000"},
     {3441, "96001"},
-    {3920, "96000 "},
+    {3920, "96000"},
     {4400, "09011255000255000255000050003"},
 };
+constexpr ActionList<countActions(testActionSources)> testActions PROGMEM = compileActions(testActionSources);
 const char testName[] PROGMEM = "Test";
 const char testVideoURL[] PROGMEM = "https://files.catbox.moe/zeq9bn.mp4";
 const Music testMusic PROGMEM = {
     testName,
     testVideoURL,
-    testActions,
-    7};
+    testActions.actions,
+    countActions(testActionSources)};
 
 #endif
\ No newline at end of file
@@ -13,6 +13,7 @@
 #define PIN_RANDOM_SEED_GENERATOR 56
 
 // Définition des broches des actionneurs.
+// Le ruban de DEL utilise les timers 0 (vert) et 3 (rouge et bleu) : l'interruption du timer 3 modifie `TCCR0A`, la broche 13 (timer 0) ne doit donc pas être pilotée par `analogWrite()` ou `digitalWrite()`. Le buzzer (timer 3) est piloté directement par son port.
 #define PIN_BUZZER 2
 #define PIN_RED_LED 3
 #define PIN_GREEN_LED 4
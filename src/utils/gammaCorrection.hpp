@@ -2,5 +2,6 @@
 #define GAMMA_CORRECTION_DEFINITIONS
 
 unsigned int gammaCorrection(unsigned int value);
+unsigned int gammaCorrection16(unsigned int value);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,288 @@
+#ifndef MUSIC_ACTIONS_DEFINITIONS
+#define MUSIC_ACTIONS_DEFINITIONS
+
+// Ajout des bibliothèques au programme.
+#include <Arduino.h>
+
+// Autres fichiers du programme.
+#include "deviceID.hpp"
+
+/// @brief Instructions pouvant être exécutées par le système de musique animée.
+enum ActionOpcode
+{
+    ACTION_TURN_OFF,
+    ACTION_TURN_ON,
+    ACTION_TOGGLE,
+    ACTION_STRIP_SINGLE_COLOR,
+    ACTION_STRIP_SMOOTH_TRANSITION,
+    ACTION_STRIP_STROBE_EFFECT,
+    ACTION_LIGHT_COLOR,
+    ACTION_LIGHT_COLOR_TEMPERATURE,
+    ACTION_LIGHT_LUMINOSITY,
+};
+
+/// @brief Types de périphériques pilotables par une musique, qui déterminent les instructions acceptées.
+enum ActionDeviceType
+{
+    ACTION_DEVICE_UNKNOWN,
+    ACTION_DEVICE_OUTPUT,
+    ACTION_DEVICE_STRIP,
+    ACTION_DEVICE_TEMPERATURE_LIGHT,
+    ACTION_DEVICE_COLOR_LIGHT,
+};
+
+/// @brief Structure stockant une action compilée d'une musique (12 octets au lieu de 36 pour la chaîne de caractères d'origine).
+struct Action
+{
+    uint16_t delay;
+    uint8_t deviceID;
+    uint8_t opcode : 5;
+    uint8_t easing : 3;
+    uint8_t colors[6];
+    uint16_t value;
+};
+
+/// @brief Structure décrivant une action sous sa forme lisible, compilée en `Action` au moment de la compilation du programme.
+struct ActionSource
+{
+    unsigned long timecode;
+    const char *action;
+};
+
+/// @brief Structure stockant une musique pour le système de musique animée. Une musique dont `actionList` vaut `nullptr` est diffusée par l'ESP sous le numéro `streamNumber`.
+struct Music
+{
+    const char *friendlyName;
+    const char *videoURL;
+    const Action *actionList;
+    unsigned int actionsNumber;
+    unsigned int streamNumber;
+};
+
+/// @brief Structure contenant la liste des actions compilées d'une musique.
+template <unsigned int N>
+struct ActionList
+{
+    Action actions[N];
+};
+
+// Fonction volontairement non `constexpr` : l'atteindre pendant la compilation d'une action provoque une erreur de compilation dont le message indique la raison.
+inline unsigned long invalidAction(const char *reason)
+{
+    return reason != nullptr ? 0 : 0;
+}
+
+/// @brief Calcule la longueur d'une chaîne d'action.
+constexpr unsigned int actionLength(const char *action, unsigned int index = 0)
+{
+    return (action[index] == '\0') ? index : actionLength(action, index + 1);
+}
+
+/// @brief Lit un chiffre d'une chaîne d'action.
+constexpr unsigned long actionDigit(const char *action, unsigned int position)
+{
+    return (action[position] >= '0' && action[position] <= '9') ? (unsigned long)(action[position] - '0') : invalidAction("Caractère non numérique dans l'action.");
+}
+
+/// @brief Lit un entier d'une chaîne d'action.
+constexpr unsigned long actionNumber(const char *action, unsigned int position, unsigned int length)
+{
+    return (length == 0) ? 0 : (actionNumber(action, position, length - 1) * 10) + actionDigit(action, position + length - 1);
+}
+
+/// @brief Lit un champ d'une chaîne d'action en vérifiant sa présence et sa valeur maximale.
+constexpr unsigned long actionField(const char *action, unsigned int position, unsigned int length, unsigned long maximum)
+{
+    return ((position + length) > actionLength(action))                 ? invalidAction("Action trop courte.")
+           : (actionNumber(action, position, length) > maximum) ? invalidAction("Valeur hors limites dans l'action.")
+                                                                 : actionNumber(action, position, length);
+}
+
+/// @brief Détermine l'instruction d'une chaîne d'action à partir de son type et de son sous-type.
+constexpr ActionOpcode actionOpcode(unsigned long type, unsigned long subtype)
+{
+    return (type == 0 && subtype <= 2)   ? ActionOpcode(ACTION_TURN_OFF + subtype)
+           : (type == 1 && subtype <= 2) ? ActionOpcode(ACTION_STRIP_SINGLE_COLOR + subtype)
+           : (type == 2 && subtype == 0) ? ACTION_LIGHT_COLOR_TEMPERATURE
+           : (type == 2 && subtype == 1) ? ACTION_LIGHT_LUMINOSITY
+           : (type == 3 && subtype <= 2) ? ActionOpcode(ACTION_LIGHT_COLOR + subtype)
+                                         : ActionOpcode(invalidAction("Type d'action inconnu."));
+}
+
+// Comparaison de l'identifiant à une entrée de la table `MUSIC_DEVICES` (deviceID.hpp).
+#define ACTION_DEVICE_TYPE(deviceID, type, device) (ID == deviceID) ? type:
+
+/// @brief Détermine le type d'un périphérique pilotable par une musique, à partir de la table `MUSIC_DEVICES` (deviceID.hpp).
+constexpr ActionDeviceType actionDeviceType(unsigned long ID)
+{
+    return MUSIC_DEVICES(ACTION_DEVICE_TYPE) ACTION_DEVICE_UNKNOWN;
+}
+
+/// @brief Renvoie la longueur exacte d'une chaîne d'action pour une instruction.
+constexpr unsigned int actionExpectedLength(ActionOpcode opcode)
+{
+    return (opcode <= ACTION_TOGGLE)                    ? 5
+           : (opcode == ACTION_STRIP_SINGLE_COLOR)      ? 14
+           : (opcode == ACTION_STRIP_SMOOTH_TRANSITION) ? 29
+           : (opcode == ACTION_STRIP_STROBE_EFFECT)     ? 18
+           : (opcode == ACTION_LIGHT_COLOR)             ? 14
+           : (opcode == ACTION_LIGHT_COLOR_TEMPERATURE) ? 9
+                                                        : 8;
+}
+
+/// @brief Vérifie que la longueur d'une chaîne d'action correspond exactement à son instruction (aucun caractère manquant ni superflu).
+constexpr ActionOpcode actionCheckedOpcode(const char *action, ActionOpcode opcode)
+{
+    return (actionLength(action) == actionExpectedLength(opcode)) ? opcode : ActionOpcode(invalidAction("Longueur de l'action incorrecte pour son type."));
+}
+
+/// @brief Vérifie qu'une instruction peut être exécutée par un type de périphérique.
+constexpr bool actionAccepted(ActionDeviceType type, ActionOpcode opcode)
+{
+    return (type != ACTION_DEVICE_UNKNOWN) &&
+           ((opcode <= ACTION_TOGGLE) ||
+            (opcode <= ACTION_STRIP_STROBE_EFFECT && type == ACTION_DEVICE_STRIP) ||
+            (opcode == ACTION_LIGHT_COLOR && type == ACTION_DEVICE_COLOR_LIGHT) ||
+            (opcode >= ACTION_LIGHT_COLOR_TEMPERATURE && (type == ACTION_DEVICE_TEMPERATURE_LIGHT || type == ACTION_DEVICE_COLOR_LIGHT)));
+}
+
+/// @brief Lit l'identifiant du périphérique d'une action en vérifiant qu'il existe et qu'il accepte l'instruction.
+constexpr uint8_t actionDeviceID(const char *action, ActionOpcode opcode)
+{
+    return actionAccepted(actionDeviceType(actionField(action, 0, 2, 99)), opcode) ? uint8_t(actionField(action, 0, 2, 99)) : uint8_t(invalidAction("Périphérique inconnu ou incompatible avec l'action."));
+}
+
+/// @brief Lit une composante de couleur d'une action (les trois premières pour la couleur de départ, les trois suivantes pour la couleur d'arrivée).
+constexpr uint8_t actionColor(const char *action, ActionOpcode opcode, unsigned int index)
+{
+    return ((index < 3 && (opcode == ACTION_STRIP_SINGLE_COLOR || opcode == ACTION_STRIP_SMOOTH_TRANSITION || opcode == ACTION_STRIP_STROBE_EFFECT || opcode == ACTION_LIGHT_COLOR)) || opcode == ACTION_STRIP_SMOOTH_TRANSITION)
+               ? uint8_t(actionField(action, 5 + (3 * index), 3, 255))
+               : 0;
+}
+
+/// @brief Lit la valeur numérique d'une action (durée, vitesse, température ou luminosité).
+constexpr uint16_t actionValue(const char *action, ActionOpcode opcode)
+{
+    return (opcode == ACTION_STRIP_SMOOTH_TRANSITION)   ? uint16_t(actionField(action, 23, 5, 65535))
+           : (opcode == ACTION_STRIP_STROBE_EFFECT)     ? uint16_t(actionField(action, 14, 4, 9999))
+           : (opcode == ACTION_LIGHT_COLOR_TEMPERATURE) ? uint16_t(actionField(action, 5, 4, 9999))
+           : (opcode == ACTION_LIGHT_LUMINOSITY)        ? uint16_t(actionField(action, 5, 3, 255))
+                                                        : 0;
+}
+
+/// @brief Calcule le délai d'une action par rapport à la précédente, en vérifiant que les actions sont triées.
+constexpr uint16_t actionDelay(unsigned long timecode, unsigned long previousTimecode)
+{
+    return (timecode < previousTimecode)                ? uint16_t(invalidAction("Actions non triées par ordre chronologique."))
+           : ((timecode - previousTimecode) > 65535UL) ? uint16_t(invalidAction("Délai trop long entre deux actions."))
+                                                        : uint16_t(timecode - previousTimecode);
+}
+
+/// @brief Assemble une action compilée à partir de son instruction.
+constexpr Action compileAction(const char *action, uint16_t delay, ActionOpcode opcode)
+{
+    return Action{delay,
+                  actionDeviceID(action, opcode),
+                  uint8_t(opcode),
+                  uint8_t((opcode == ACTION_STRIP_SMOOTH_TRANSITION) ? actionField(action, 28, 1, 3) : 0),
+                  {actionColor(action, opcode, 0), actionColor(action, opcode, 1), actionColor(action, opcode, 2), actionColor(action, opcode, 3), actionColor(action, opcode, 4), actionColor(action, opcode, 5)},
+                  actionValue(action, opcode)};
+}
+
+/// @brief Compile une action lisible en une action compilée.
+/// @param source L'action à compiler.
+/// @param previousTimecode Le moment de l'action précédente (`0` pour la première action).
+constexpr Action compileAction(const ActionSource &source, unsigned long previousTimecode)
+{
+    return compileAction(source.action, actionDelay(source.timecode, previousTimecode), actionCheckedOpcode(source.action, actionOpcode(actionField(source.action, 2, 2, 99), actionField(source.action, 4, 1, 9))));
+}
+
+// Séquence d'indices utilisée pour compiler chaque action d'une liste.
+template <unsigned int... Indexes>
+struct ActionIndexes
+{
+};
+
+template <unsigned int N, unsigned int... Indexes>
+struct ActionIndexesBuilder : ActionIndexesBuilder<N - 1, N - 1, Indexes...>
+{
+};
+
+template <unsigned int... Indexes>
+struct ActionIndexesBuilder<0, Indexes...>
+{
+    typedef ActionIndexes<Indexes...> Type;
+};
+
+/// @brief Renvoie le moment de l'action précédant celle d'indice `index`.
+template <unsigned int N>
+constexpr unsigned long previousActionTimecode(const ActionSource (&source)[N], unsigned int index)
+{
+    return (index == 0) ? 0 : source[index - 1].timecode;
+}
+
+template <unsigned int N, unsigned int... Indexes>
+constexpr ActionList<N> compileActions(const ActionSource (&source)[N], ActionIndexes<Indexes...>)
+{
+    return ActionList<N>{{compileAction(source[Indexes], previousActionTimecode(source, Indexes))...}};
+}
+
+/// @brief Compile une liste d'actions lisibles lors de la compilation du programme. Une action mal formée, non triée ou visant un périphérique inconnu provoque une erreur de compilation.
+/// @param source La liste d'actions à compiler.
+/// @return La liste des actions compilées, à stocker dans la mémoire flash.
+template <unsigned int N>
+constexpr ActionList<N> compileActions(const ActionSource (&source)[N])
+{
+    return compileActions(source, typename ActionIndexesBuilder<N>::Type());
+}
+
+/// @brief Vérifie une action reçue pendant l'exécution du programme (musique diffusée). Hors de la compilation du programme, `compileAction()` remplacerait simplement les champs invalides par `0` : l'action doit donc être vérifiée avant d'être compilée.
+/// @param action L'action au format texte.
+/// @return `true` si l'action a la longueur de son instruction, ne contient que des chiffres, respecte les limites de ses champs et vise un périphérique qui accepte l'instruction.
+inline bool isActionValid(const char *action)
+{
+    unsigned int length = 0;
+    while (action[length] != '\0')
+    {
+        if (action[length] < '0' || action[length] > '9')
+            return false;
+
+        length++;
+    }
+
+    if (length < 5)
+        return false;
+
+    unsigned long type = actionNumber(action, 2, 2);
+    unsigned long subtype = actionNumber(action, 4, 1);
+    if (!((type <= 1 && subtype <= 2) || (type == 2 && subtype <= 1) || (type == 3 && subtype <= 2)))
+        return false;
+
+    ActionOpcode opcode = actionOpcode(type, subtype);
+    if (length != actionExpectedLength(opcode) || !actionAccepted(actionDeviceType(actionNumber(action, 0, 2)), opcode))
+        return false;
+
+    unsigned int colorsNumber = (opcode == ACTION_STRIP_SMOOTH_TRANSITION) ? 6 : (opcode == ACTION_STRIP_SINGLE_COLOR || opcode == ACTION_STRIP_STROBE_EFFECT || opcode == ACTION_LIGHT_COLOR) ? 3 : 0;
+    for (unsigned int i = 0; i < colorsNumber; i++)
+    {
+        if (actionNumber(action, 5 + (3 * i), 3) > 255)
+            return false;
+    }
+
+    if (opcode == ACTION_STRIP_SMOOTH_TRANSITION)
+        return actionNumber(action, 23, 5) <= 65535 && actionNumber(action, 28, 1) <= 3;
+
+    if (opcode == ACTION_LIGHT_LUMINOSITY)
+        return actionNumber(action, 5, 3) <= 255;
+
+    return true;
+}
+
+/// @brief Renvoie le nombre d'actions d'une liste.
+template <unsigned int N>
+constexpr unsigned int countActions(const ActionSource (&)[N])
+{
+    return N;
+}
+
+#endif
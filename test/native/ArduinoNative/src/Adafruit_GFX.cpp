@@ -0,0 +1,754 @@
+/**
+ * @file Adafruit_GFX.cpp
+ * @brief Bibliothèque graphique reprenant les algorithmes d'Adafruit GFX, pour tester l'écran sur l'ordinateur.
+ */
+
+// Ajout des bibliothèques au programme.
+#include "Adafruit_GFX.h"
+
+unsigned long gfxPixelOperations = 0;
+
+// Police 5 × 8 de la page de code 437 (5 colonnes par caractère, le bit de poids faible en haut) : les caractères ASCII, les lettres accentuées (0x80 à 0xA5) et le signe degré (0xF8) reprennent la police par défaut d'Adafruit GFX ; les autres glyphes, inutilisés par le programme, sont remplacés par un rectangle.
+static const unsigned char font[] PROGMEM = {
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x5F, 0x00, 0x00,
+    0x00, 0x07, 0x00, 0x07, 0x00,
+    0x14, 0x7F, 0x14, 0x7F, 0x14,
+    0x24, 0x2A, 0x7F, 0x2A, 0x12,
+    0x23, 0x13, 0x08, 0x64, 0x62,
+    0x36, 0x49, 0x56, 0x20, 0x50,
+    0x00, 0x08, 0x07, 0x03, 0x00,
+    0x00, 0x1C, 0x22, 0x41, 0x00,
+    0x00, 0x41, 0x22, 0x1C, 0x00,
+    0x2A, 0x1C, 0x7F, 0x1C, 0x2A,
+    0x08, 0x08, 0x3E, 0x08, 0x08,
+    0x00, 0x80, 0x70, 0x30, 0x00,
+    0x08, 0x08, 0x08, 0x08, 0x08,
+    0x00, 0x00, 0x60, 0x60, 0x00,
+    0x20, 0x10, 0x08, 0x04, 0x02,
+    0x3E, 0x51, 0x49, 0x45, 0x3E,
+    0x00, 0x42, 0x7F, 0x40, 0x00,
+    0x72, 0x49, 0x49, 0x49, 0x46,
+    0x21, 0x41, 0x49, 0x4D, 0x33,
+    0x18, 0x14, 0x12, 0x7F, 0x10,
+    0x27, 0x45, 0x45, 0x45, 0x39,
+    0x3C, 0x4A, 0x49, 0x49, 0x31,
+    0x41, 0x21, 0x11, 0x09, 0x07,
+    0x36, 0x49, 0x49, 0x49, 0x36,
+    0x46, 0x49, 0x49, 0x29, 0x1E,
+    0x00, 0x00, 0x14, 0x00, 0x00,
+    0x00, 0x40, 0x34, 0x00, 0x00,
+    0x00, 0x08, 0x14, 0x22, 0x41,
+    0x14, 0x14, 0x14, 0x14, 0x14,
+    0x00, 0x41, 0x22, 0x14, 0x08,
+    0x02, 0x01, 0x59, 0x09, 0x06,
+    0x3E, 0x41, 0x5D, 0x59, 0x4E,
+    0x7C, 0x12, 0x11, 0x12, 0x7C,
+    0x7F, 0x49, 0x49, 0x49, 0x36,
+    0x3E, 0x41, 0x41, 0x41, 0x22,
+    0x7F, 0x41, 0x41, 0x41, 0x3E,
+    0x7F, 0x49, 0x49, 0x49, 0x41,
+    0x7F, 0x09, 0x09, 0x09, 0x01,
+    0x3E, 0x41, 0x41, 0x51, 0x73,
+    0x7F, 0x08, 0x08, 0x08, 0x7F,
+    0x00, 0x41, 0x7F, 0x41, 0x00,
+    0x20, 0x40, 0x41, 0x3F, 0x01,
+    0x7F, 0x08, 0x14, 0x22, 0x41,
+    0x7F, 0x40, 0x40, 0x40, 0x40,
+    0x7F, 0x02, 0x1C, 0x02, 0x7F,
+    0x7F, 0x04, 0x08, 0x10, 0x7F,
+    0x3E, 0x41, 0x41, 0x41, 0x3E,
+    0x7F, 0x09, 0x09, 0x09, 0x06,
+    0x3E, 0x41, 0x51, 0x21, 0x5E,
+    0x7F, 0x09, 0x19, 0x29, 0x46,
+    0x26, 0x49, 0x49, 0x49, 0x32,
+    0x03, 0x01, 0x7F, 0x01, 0x03,
+    0x3F, 0x40, 0x40, 0x40, 0x3F,
+    0x1F, 0x20, 0x40, 0x20, 0x1F,
+    0x3F, 0x40, 0x38, 0x40, 0x3F,
+    0x63, 0x14, 0x08, 0x14, 0x63,
+    0x03, 0x04, 0x78, 0x04, 0x03,
+    0x61, 0x59, 0x49, 0x4D, 0x43,
+    0x00, 0x7F, 0x41, 0x41, 0x41,
+    0x02, 0x04, 0x08, 0x10, 0x20,
+    0x00, 0x41, 0x41, 0x41, 0x7F,
+    0x04, 0x02, 0x01, 0x02, 0x04,
+    0x40, 0x40, 0x40, 0x40, 0x40,
+    0x00, 0x03, 0x07, 0x08, 0x00,
+    0x20, 0x54, 0x54, 0x78, 0x40,
+    0x7F, 0x28, 0x44, 0x44, 0x38,
+    0x38, 0x44, 0x44, 0x44, 0x28,
+    0x38, 0x44, 0x44, 0x28, 0x7F,
+    0x38, 0x54, 0x54, 0x54, 0x18,
+    0x00, 0x08, 0x7E, 0x09, 0x02,
+    0x18, 0xA4, 0xA4, 0x9C, 0x78,
+    0x7F, 0x08, 0x04, 0x04, 0x78,
+    0x00, 0x44, 0x7D, 0x40, 0x00,
+    0x20, 0x40, 0x40, 0x3D, 0x00,
+    0x7F, 0x10, 0x28, 0x44, 0x00,
+    0x00, 0x41, 0x7F, 0x40, 0x00,
+    0x7C, 0x04, 0x78, 0x04, 0x78,
+    0x7C, 0x08, 0x04, 0x04, 0x78,
+    0x38, 0x44, 0x44, 0x44, 0x38,
+    0xFC, 0x18, 0x24, 0x24, 0x18,
+    0x18, 0x24, 0x24, 0x18, 0xFC,
+    0x7C, 0x08, 0x04, 0x04, 0x08,
+    0x48, 0x54, 0x54, 0x54, 0x24,
+    0x04, 0x04, 0x3F, 0x44, 0x24,
+    0x3C, 0x40, 0x40, 0x20, 0x7C,
+    0x1C, 0x20, 0x40, 0x20, 0x1C,
+    0x3C, 0x40, 0x30, 0x40, 0x3C,
+    0x44, 0x28, 0x10, 0x28, 0x44,
+    0x4C, 0x90, 0x90, 0x90, 0x7C,
+    0x44, 0x64, 0x54, 0x4C, 0x44,
+    0x00, 0x08, 0x36, 0x41, 0x00,
+    0x00, 0x00, 0x77, 0x00, 0x00,
+    0x00, 0x41, 0x36, 0x08, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x02,
+    0x3C, 0x26, 0x23, 0x26, 0x3C,
+    0x1E, 0xA1, 0xA1, 0x61, 0x12,
+    0x3A, 0x40, 0x40, 0x20, 0x7A,
+    0x38, 0x54, 0x54, 0x55, 0x59,
+    0x21, 0x55, 0x55, 0x79, 0x41,
+    0x21, 0x54, 0x54, 0x78, 0x41,
+    0x21, 0x55, 0x54, 0x78, 0x40,
+    0x20, 0x54, 0x55, 0x79, 0x40,
+    0x0C, 0x1E, 0x52, 0x72, 0x12,
+    0x39, 0x55, 0x55, 0x55, 0x59,
+    0x39, 0x54, 0x54, 0x54, 0x59,
+    0x39, 0x55, 0x54, 0x54, 0x58,
+    0x00, 0x00, 0x45, 0x7C, 0x41,
+    0x00, 0x02, 0x45, 0x7D, 0x42,
+    0x00, 0x01, 0x45, 0x7C, 0x40,
+    0xF0, 0x29, 0x24, 0x29, 0xF0,
+    0xF0, 0x28, 0x25, 0x28, 0xF0,
+    0x7C, 0x54, 0x55, 0x45, 0x00,
+    0x20, 0x54, 0x54, 0x7C, 0x54,
+    0x7C, 0x0A, 0x09, 0x7F, 0x49,
+    0x32, 0x49, 0x49, 0x49, 0x32,
+    0x32, 0x48, 0x48, 0x48, 0x32,
+    0x32, 0x4A, 0x48, 0x48, 0x30,
+    0x3A, 0x41, 0x41, 0x21, 0x7A,
+    0x3A, 0x42, 0x40, 0x20, 0x78,
+    0x00, 0x9D, 0xA0, 0xA0, 0x7D,
+    0x39, 0x44, 0x44, 0x44, 0x39,
+    0x3D, 0x40, 0x40, 0x40, 0x3D,
+    0x3C, 0x24, 0xFF, 0x24, 0x24,
+    0x48, 0x7E, 0x49, 0x43, 0x66,
+    0x2B, 0x2F, 0xFC, 0x2F, 0x2B,
+    0xFF, 0x09, 0x29, 0xF6, 0x20,
+    0xC0, 0x88, 0x7E, 0x09, 0x03,
+    0x20, 0x54, 0x54, 0x79, 0x41,
+    0x00, 0x00, 0x44, 0x7D, 0x41,
+    0x30, 0x48, 0x48, 0x4A, 0x32,
+    0x38, 0x40, 0x40, 0x22, 0x7A,
+    0x00, 0x7A, 0x0A, 0x0A, 0x72,
+    0x7D, 0x0D, 0x19, 0x31, 0x7D,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x00, 0x06, 0x09, 0x09, 0x06,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F,
+    0x7F, 0x41, 0x41, 0x41, 0x7F
+};
+
+#define _swap_int16_t(a, b) \
+    {                       \
+        int16_t t = a;      \
+        a = b;              \
+        b = t;              \
+    }
+
+/// @brief Constructeur de la classe.
+/// @param w La largeur de l'écran.
+/// @param h La hauteur de l'écran.
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h), cursor_x(0), cursor_y(0), textcolor(0xFFFF), textbgcolor(0xFFFF), textsize_x(1), textsize_y(1), rotation(0), wrap(true), _cp437(false) {}
+
+/// @brief Début d'une suite de dessins (rien à préparer ici).
+void Adafruit_GFX::startWrite()
+{
+}
+
+/// @brief Dessine un pixel au sein d'une suite de dessins.
+void Adafruit_GFX::writePixel(int16_t x, int16_t y, uint16_t color)
+{
+    gfxPixelOperations++;
+    this->drawPixel(x, y, color);
+}
+
+/// @brief Dessine un rectangle plein au sein d'une suite de dessins.
+void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (w > 0 && h > 0)
+        gfxPixelOperations += long(w) * h;
+
+    this->fillRect(x, y, w, h, color);
+}
+
+/// @brief Dessine une ligne verticale au sein d'une suite de dessins.
+void Adafruit_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    if (h > 0)
+        gfxPixelOperations += h;
+
+    this->drawFastVLine(x, y, h, color);
+}
+
+/// @brief Dessine une ligne horizontale au sein d'une suite de dessins.
+void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    if (w > 0)
+        gfxPixelOperations += w;
+
+    this->drawFastHLine(x, y, w, color);
+}
+
+/// @brief Dessine une ligne quelconque pixel par pixel (algorithme de Bresenham).
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep)
+    {
+        _swap_int16_t(x0, y0);
+        _swap_int16_t(x1, y1);
+    }
+
+    if (x0 > x1)
+    {
+        _swap_int16_t(x0, x1);
+        _swap_int16_t(y0, y1);
+    }
+
+    int16_t dx = x1 - x0;
+    int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+
+    for (; x0 <= x1; x0++)
+    {
+        if (steep)
+            this->writePixel(y0, x0, color);
+
+        else
+            this->writePixel(x0, y0, color);
+
+        err -= dy;
+        if (err < 0)
+        {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+/// @brief Fin d'une suite de dessins.
+void Adafruit_GFX::endWrite()
+{
+}
+
+/// @brief Dessine une ligne verticale (version générique).
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    this->startWrite();
+    this->writeLine(x, y, x, y + h - 1, color);
+    this->endWrite();
+}
+
+/// @brief Dessine une ligne horizontale (version générique).
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    this->startWrite();
+    this->writeLine(x, y, x + w - 1, y, color);
+    this->endWrite();
+}
+
+/// @brief Dessine un rectangle plein, colonne par colonne.
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    this->startWrite();
+    for (int16_t i = x; i < x + w; i++)
+        this->writeFastVLine(i, y, h, color);
+
+    this->endWrite();
+}
+
+/// @brief Remplit l'écran d'une couleur.
+void Adafruit_GFX::fillScreen(uint16_t color)
+{
+    this->fillRect(0, 0, _width, _height, color);
+}
+
+/// @brief Dessine une ligne : les lignes verticales et horizontales utilisent les fonctions rapides.
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    if (x0 == x1)
+    {
+        if (y0 > y1)
+            _swap_int16_t(y0, y1);
+
+        this->drawFastVLine(x0, y0, y1 - y0 + 1, color);
+    }
+
+    else if (y0 == y1)
+    {
+        if (x0 > x1)
+            _swap_int16_t(x0, x1);
+
+        this->drawFastHLine(x0, y0, x1 - x0 + 1, color);
+    }
+
+    else
+    {
+        this->startWrite();
+        this->writeLine(x0, y0, x1, y1, color);
+        this->endWrite();
+    }
+}
+
+/// @brief Dessine le contour d'un rectangle (les coins ne sont dessinés qu'une fois).
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    this->startWrite();
+    this->writeFastHLine(x, y, w, color);
+    this->writeFastHLine(x, y + h - 1, w, color);
+    this->writeFastVLine(x, y + 1, h - 2, color);
+    this->writeFastVLine(x + w - 1, y + 1, h - 2, color);
+    this->endWrite();
+}
+
+/// @brief Dessine le contour d'un cercle (algorithme du point milieu).
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+
+    this->startWrite();
+    this->writePixel(x0, y0 + r, color);
+    this->writePixel(x0, y0 - r, color);
+    this->writePixel(x0 + r, y0, color);
+    this->writePixel(x0 - r, y0, color);
+
+    while (x < y)
+    {
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        this->writePixel(x0 + x, y0 + y, color);
+        this->writePixel(x0 - x, y0 + y, color);
+        this->writePixel(x0 + x, y0 - y, color);
+        this->writePixel(x0 - x, y0 - y, color);
+        this->writePixel(x0 + y, y0 + x, color);
+        this->writePixel(x0 - y, y0 + x, color);
+        this->writePixel(x0 + y, y0 - x, color);
+        this->writePixel(x0 - y, y0 - x, color);
+    }
+
+    this->endWrite();
+}
+
+/// @brief Dessine un ou plusieurs quarts de cercle (coins des rectangles arrondis).
+void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color)
+{
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+
+    while (x < y)
+    {
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        if (cornername & 0x4)
+        {
+            this->writePixel(x0 + x, y0 + y, color);
+            this->writePixel(x0 + y, y0 + x, color);
+        }
+
+        if (cornername & 0x2)
+        {
+            this->writePixel(x0 + x, y0 - y, color);
+            this->writePixel(x0 + y, y0 - x, color);
+        }
+
+        if (cornername & 0x8)
+        {
+            this->writePixel(x0 - y, y0 + x, color);
+            this->writePixel(x0 - x, y0 + y, color);
+        }
+
+        if (cornername & 0x1)
+        {
+            this->writePixel(x0 - y, y0 - x, color);
+            this->writePixel(x0 - x, y0 - y, color);
+        }
+    }
+}
+
+/// @brief Dessine un cercle plein.
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+    this->startWrite();
+    this->writeFastVLine(x0, y0 - r, 2 * r + 1, color);
+    this->fillCircleHelper(x0, y0, r, 3, 0, color);
+    this->endWrite();
+}
+
+/// @brief Remplit une ou deux moitiés de cercle, étirées verticalement de `delta` lignes (rectangles arrondis pleins).
+void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color)
+{
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t px = x;
+    int16_t py = y;
+
+    delta++;
+
+    while (x < y)
+    {
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        // Ces vérifications évitent de dessiner deux fois les mêmes lignes (important pour la couleur `INVERSE`).
+        if (x < (y + 1))
+        {
+            if (corners & 1)
+                this->writeFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+
+            if (corners & 2)
+                this->writeFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+        }
+
+        if (y != py)
+        {
+            if (corners & 1)
+                this->writeFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+
+            if (corners & 2)
+                this->writeFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+
+            py = y;
+        }
+
+        px = x;
+    }
+}
+
+/// @brief Dessine le contour d'un rectangle aux coins arrondis.
+void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color)
+{
+    int16_t max_radius = ((w < h) ? w : h) / 2;
+    if (r > max_radius)
+        r = max_radius;
+
+    this->startWrite();
+    this->writeFastHLine(x + r, y, w - 2 * r, color);
+    this->writeFastHLine(x + r, y + h - 1, w - 2 * r, color);
+    this->writeFastVLine(x, y + r, h - 2 * r, color);
+    this->writeFastVLine(x + w - 1, y + r, h - 2 * r, color);
+    this->drawCircleHelper(x + r, y + r, r, 1, color);
+    this->drawCircleHelper(x + w - r - 1, y + r, r, 2, color);
+    this->drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4, color);
+    this->drawCircleHelper(x + r, y + h - r - 1, r, 8, color);
+    this->endWrite();
+}
+
+/// @brief Dessine un rectangle plein aux coins arrondis.
+void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color)
+{
+    int16_t max_radius = ((w < h) ? w : h) / 2;
+    if (r > max_radius)
+        r = max_radius;
+
+    this->startWrite();
+    this->writeFillRect(x + r, y, w - 2 * r, h, color);
+    this->fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
+    this->fillCircleHelper(x + r, y + r, r, 2, h - 2 * r - 1, color);
+    this->endWrite();
+}
+
+/// @brief Dessine un caractère de la police par défaut.
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size)
+{
+    this->drawChar(x, y, c, color, bg, size, size);
+}
+
+/// @brief Dessine un caractère de la police par défaut, agrandi horizontalement et verticalement. Le fond n'est dessiné que si sa couleur diffère de celle du texte.
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y)
+{
+    if ((x >= _width) || (y >= _height) || ((x + 6 * size_x - 1) < 0) || ((y + 8 * size_y - 1) < 0))
+        return;
+
+    // Ancien placement de la police, décalé d'un glyphe à partir de 176 (voir `cp437()`).
+    if (!_cp437 && (c >= 176))
+        c++;
+
+    this->startWrite();
+    for (int8_t i = 0; i < 5; i++)
+    {
+        uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+        for (int8_t j = 0; j < 8; j++, line >>= 1)
+        {
+            if (line & 1)
+            {
+                if (size_x == 1 && size_y == 1)
+                    this->writePixel(x + i, y + j, color);
+
+                else
+                    this->writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, color);
+            }
+
+            else if (bg != color)
+            {
+                if (size_x == 1 && size_y == 1)
+                    this->writePixel(x + i, y + j, bg);
+
+                else
+                    this->writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+            }
+        }
+    }
+
+    if (bg != color)
+    {
+        if (size_x == 1 && size_y == 1)
+            this->writeFastVLine(x + 5, y, 8, bg);
+
+        else
+            this->writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+    }
+
+    this->endWrite();
+}
+
+void Adafruit_GFX::setCursor(int16_t x, int16_t y)
+{
+    cursor_x = x;
+    cursor_y = y;
+}
+
+/// @brief Choisit la couleur du texte, sans fond.
+void Adafruit_GFX::setTextColor(uint16_t c)
+{
+    textcolor = textbgcolor = c;
+}
+
+/// @brief Choisit la couleur du texte et de son fond.
+void Adafruit_GFX::setTextColor(uint16_t c, uint16_t bg)
+{
+    textcolor = c;
+    textbgcolor = bg;
+}
+
+void Adafruit_GFX::setTextSize(uint8_t s)
+{
+    this->setTextSize(s, s);
+}
+
+void Adafruit_GFX::setTextSize(uint8_t s_x, uint8_t s_y)
+{
+    textsize_x = (s_x > 0) ? s_x : 1;
+    textsize_y = (s_y > 0) ? s_y : 1;
+}
+
+void Adafruit_GFX::setTextWrap(bool w)
+{
+    wrap = w;
+}
+
+/// @brief Active le placement correct de la page de code 437 dans la police.
+void Adafruit_GFX::cp437(bool x)
+{
+    _cp437 = x;
+}
+
+/// @brief Affiche un caractère à la position du curseur, avec retour à la ligne automatique si activé.
+size_t Adafruit_GFX::write(uint8_t c)
+{
+    if (c == '\n')
+    {
+        cursor_x = 0;
+        cursor_y += textsize_y * 8;
+    }
+
+    else if (c != '\r')
+    {
+        if (wrap && ((cursor_x + textsize_x * 6) > _width))
+        {
+            cursor_x = 0;
+            cursor_y += textsize_y * 8;
+        }
+
+        this->drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+        cursor_x += textsize_x * 6;
+    }
+
+    return 1;
+}
+
+int16_t Adafruit_GFX::width() const
+{
+    return _width;
+}
+
+int16_t Adafruit_GFX::height() const
+{
+    return _height;
+}
+
+int16_t Adafruit_GFX::getCursorX() const
+{
+    return cursor_x;
+}
+
+int16_t Adafruit_GFX::getCursorY() const
+{
+    return cursor_y;
+}
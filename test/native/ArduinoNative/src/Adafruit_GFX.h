@@ -0,0 +1,67 @@
+#ifndef ARDUINO_NATIVE_ADAFRUIT_GFX_DEFINITIONS
+#define ARDUINO_NATIVE_ADAFRUIT_GFX_DEFINITIONS
+
+// Ajout des bibliothèques au programme.
+#include "Arduino.h"
+
+// Nombre de pixels écrits par les primitives de la bibliothèque depuis le démarrage (`writePixel()`, `writeFastHLine()`, `writeFastVLine()` et `writeFillRect()`), pour mesurer le coût des affichages. Les dessins effectués directement dans une mémoire tampon par l'écran (pictogrammes, rectangles pleins de l'affichage page par page) ne sont pas comptés.
+extern unsigned long gfxPixelOperations;
+
+/// @brief Bibliothèque graphique reprenant les algorithmes d'Adafruit GFX (version 1.11) pour la police par défaut, les lignes, rectangles et cercles, sans rotation ni polices supplémentaires.
+class Adafruit_GFX : public Print
+{
+public:
+    Adafruit_GFX(int16_t w, int16_t h);
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    virtual void startWrite();
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color);
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    virtual void endWrite();
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void fillScreen(uint16_t color);
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color);
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color);
+    void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+    void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y);
+    void setCursor(int16_t x, int16_t y);
+    void setTextColor(uint16_t c);
+    void setTextColor(uint16_t c, uint16_t bg);
+    void setTextSize(uint8_t s);
+    void setTextSize(uint8_t s_x, uint8_t s_y);
+    void setTextWrap(bool w);
+    void cp437(bool x = true);
+    size_t write(uint8_t c) override;
+    using Print::write;
+    int16_t width() const;
+    int16_t height() const;
+    int16_t getCursorX() const;
+    int16_t getCursorY() const;
+
+protected:
+    int16_t WIDTH;
+    int16_t HEIGHT;
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x;
+    int16_t cursor_y;
+    uint16_t textcolor;
+    uint16_t textbgcolor;
+    uint8_t textsize_x;
+    uint8_t textsize_y;
+    uint8_t rotation;
+    bool wrap;
+    bool _cp437;
+};
+
+#endif
@@ -0,0 +1,244 @@
+/**
+ * @file Adafruit_SSD1306.cpp
+ * @brief Écran SSD1306 en I2C reprenant le fonctionnement de la bibliothèque Adafruit SSD1306, pour tester l'écran sur l'ordinateur.
+ */
+
+// Ajout des bibliothèques au programme.
+#include "Adafruit_SSD1306.h"
+
+// Taille maximale d'une transaction Wire, octet de contrôle compris.
+#define WIRE_MAX BUFFER_LENGTH
+
+/// @brief Constructeur de la classe.
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi, int8_t rst_pin, uint32_t clkDuring, uint32_t clkAfter) : Adafruit_GFX(w, h), wire(twi), buffer(nullptr), i2caddr(0), vccstate(SSD1306_SWITCHCAPVCC), page_end(0), rstPin(rst_pin), wireClk(clkDuring), restoreClk(clkAfter), contrast(0x8F) {}
+
+/// @brief Destructeur de la classe.
+Adafruit_SSD1306::~Adafruit_SSD1306()
+{
+    free(buffer);
+}
+
+/// @brief Alloue la mémoire tampon et initialise l'écran (l'image de démarrage d'Adafruit n'est pas dessinée).
+/// @return `false` si la mémoire tampon n'a pas pu être allouée.
+bool Adafruit_SSD1306::begin(uint8_t switchvcc, uint8_t address, bool reset, bool periphBegin)
+{
+    if ((buffer == nullptr) && !(buffer = static_cast<uint8_t *>(malloc(WIDTH * ((HEIGHT + 7) / 8)))))
+        return false;
+
+    this->clearDisplay();
+
+    vccstate = switchvcc;
+    i2caddr = address ? address : ((HEIGHT == 32) ? 0x3C : 0x3D);
+    if (periphBegin)
+        wire->begin();
+
+    wire->setClock(wireClk);
+
+    static const uint8_t init1[] PROGMEM = {SSD1306_DISPLAYOFF, SSD1306_SETDISPLAYCLOCKDIV, 0x80, SSD1306_SETMULTIPLEX};
+    this->ssd1306_commandList(init1, sizeof(init1));
+    this->ssd1306_command1(HEIGHT - 1);
+
+    static const uint8_t init2[] PROGMEM = {SSD1306_SETDISPLAYOFFSET, 0x0, SSD1306_SETSTARTLINE | 0x0, SSD1306_CHARGEPUMP};
+    this->ssd1306_commandList(init2, sizeof(init2));
+    this->ssd1306_command1((vccstate == SSD1306_EXTERNALVCC) ? 0x10 : 0x14);
+
+    static const uint8_t init3[] PROGMEM = {SSD1306_MEMORYMODE, 0x00, SSD1306_SEGREMAP | 0x1, SSD1306_COMSCANDEC};
+    this->ssd1306_commandList(init3, sizeof(init3));
+
+    uint8_t comPins = 0x02;
+    contrast = 0x8F;
+    if ((WIDTH == 128) && (HEIGHT == 64))
+    {
+        comPins = 0x12;
+        contrast = (vccstate == SSD1306_EXTERNALVCC) ? 0x9F : 0xCF;
+    }
+
+    this->ssd1306_command1(SSD1306_SETCOMPINS);
+    this->ssd1306_command1(comPins);
+    this->ssd1306_command1(SSD1306_SETCONTRAST);
+    this->ssd1306_command1(contrast);
+    this->ssd1306_command1(SSD1306_SETPRECHARGE);
+    this->ssd1306_command1((vccstate == SSD1306_EXTERNALVCC) ? 0x22 : 0xF1);
+
+    static const uint8_t init5[] PROGMEM = {SSD1306_SETVCOMDETECT, 0x40, SSD1306_DISPLAYALLON_RESUME, SSD1306_NORMALDISPLAY, SSD1306_DEACTIVATE_SCROLL, SSD1306_DISPLAYON};
+    this->ssd1306_commandList(init5, sizeof(init5));
+
+    wire->setClock(restoreClk);
+    return true;
+}
+
+/// @brief Envoie toute la mémoire tampon à l'écran, par transactions de `WIRE_MAX` octets.
+void Adafruit_SSD1306::display()
+{
+    wire->setClock(wireClk);
+
+    static const uint8_t dlist1[] PROGMEM = {SSD1306_PAGEADDR, 0, 0xFF, SSD1306_COLUMNADDR, 0};
+    this->ssd1306_commandList(dlist1, sizeof(dlist1));
+    this->ssd1306_command1(WIDTH - 1);
+
+    uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
+    uint8_t *ptr = buffer;
+
+    wire->beginTransmission(i2caddr);
+    wire->write(uint8_t(0x40));
+    uint16_t bytesOut = 1;
+
+    while (count--)
+    {
+        if (bytesOut >= WIRE_MAX)
+        {
+            wire->endTransmission();
+            wire->beginTransmission(i2caddr);
+            wire->write(uint8_t(0x40));
+            bytesOut = 1;
+        }
+
+        wire->write(*ptr++);
+        bytesOut++;
+    }
+
+    wire->endTransmission();
+    wire->setClock(restoreClk);
+}
+
+/// @brief Efface la mémoire tampon (l'écran n'est modifié qu'au prochain `display()`).
+void Adafruit_SSD1306::clearDisplay()
+{
+    memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+}
+
+/// @brief Inverse les couleurs de l'écran (commande immédiate).
+void Adafruit_SSD1306::invertDisplay(bool i)
+{
+    wire->setClock(wireClk);
+    this->ssd1306_command1(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+    wire->setClock(restoreClk);
+}
+
+/// @brief Réduit la luminosité de l'écran (commande immédiate).
+void Adafruit_SSD1306::dim(bool dim)
+{
+    wire->setClock(wireClk);
+    this->ssd1306_command1(SSD1306_SETCONTRAST);
+    this->ssd1306_command1(dim ? 0 : contrast);
+    wire->setClock(restoreClk);
+}
+
+/// @brief Dessine un pixel dans la mémoire tampon.
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if ((x < 0) || (x >= width()) || (y < 0) || (y >= height()))
+        return;
+
+    uint8_t *pixel = &buffer[x + (y / 8) * WIDTH];
+    uint8_t mask = 1 << (y & 7);
+
+    switch (color)
+    {
+    case SSD1306_WHITE:
+        *pixel |= mask;
+        break;
+
+    case SSD1306_BLACK:
+        *pixel &= ~mask;
+        break;
+
+    case SSD1306_INVERSE:
+        *pixel ^= mask;
+        break;
+    }
+}
+
+/// @brief Dessine une ligne horizontale dans la mémoire tampon, découpée aux limites de l'écran.
+void Adafruit_SSD1306::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    if ((y < 0) || (y >= HEIGHT))
+        return;
+
+    if (x < 0)
+    {
+        w += x;
+        x = 0;
+    }
+
+    if ((x + w) > WIDTH)
+        w = WIDTH - x;
+
+    for (int16_t i = 0; i < w; i++)
+        this->drawPixel(x + i, y, color);
+}
+
+/// @brief Dessine une ligne verticale dans la mémoire tampon, découpée aux limites de l'écran.
+void Adafruit_SSD1306::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    if ((x < 0) || (x >= WIDTH))
+        return;
+
+    if (y < 0)
+    {
+        h += y;
+        y = 0;
+    }
+
+    if ((y + h) > HEIGHT)
+        h = HEIGHT - y;
+
+    for (int16_t i = 0; i < h; i++)
+        Adafruit_SSD1306::drawPixel(x, y + i, color);
+}
+
+/// @brief Envoie une commande à l'écran (transaction séparée).
+void Adafruit_SSD1306::ssd1306_command(uint8_t c)
+{
+    wire->setClock(wireClk);
+    this->ssd1306_command1(c);
+    wire->setClock(restoreClk);
+}
+
+/// @brief Lit un pixel de la mémoire tampon.
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y)
+{
+    if ((x < 0) || (x >= width()) || (y < 0) || (y >= height()))
+        return false;
+
+    return buffer[x + (y / 8) * WIDTH] & (1 << (y & 7));
+}
+
+/// @brief Renvoie la mémoire tampon (8 pages de 128 colonnes, le bit de poids faible en haut).
+uint8_t *Adafruit_SSD1306::getBuffer()
+{
+    return buffer;
+}
+
+/// @brief Envoie une commande d'un octet (octet de contrôle `0x00`, puis la commande).
+void Adafruit_SSD1306::ssd1306_command1(uint8_t c)
+{
+    wire->beginTransmission(i2caddr);
+    wire->write(uint8_t(0x00));
+    wire->write(c);
+    wire->endTransmission();
+}
+
+/// @brief Envoie une suite de commandes, découpée en transactions de `WIRE_MAX` octets.
+void Adafruit_SSD1306::ssd1306_commandList(const uint8_t *c, uint8_t n)
+{
+    wire->beginTransmission(i2caddr);
+    wire->write(uint8_t(0x00));
+    uint16_t bytesOut = 1;
+
+    while (n--)
+    {
+        if (bytesOut >= WIRE_MAX)
+        {
+            wire->endTransmission();
+            wire->beginTransmission(i2caddr);
+            wire->write(uint8_t(0x00));
+            bytesOut = 1;
+        }
+
+        wire->write(pgm_read_byte(c++));
+        bytesOut++;
+    }
+
+    wire->endTransmission();
+}
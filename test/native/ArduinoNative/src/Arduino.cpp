@@ -0,0 +1,641 @@
+/**
+ * @file Arduino.cpp
+ * @brief Remplaçant du cœur Arduino pour l'environnement `native` : temps simulé, chaînes de caractères et affichage de texte.
+ */
+
+// Ajout des bibliothèques au programme.
+#include <stdio.h>
+#include "Arduino.h"
+
+// Temps simulé, en microsecondes.
+static unsigned long simulatedMicros = 0;
+
+// Registres des timers et du convertisseur analogique-numérique.
+volatile uint8_t TCCR0A = 0;
+volatile uint8_t TCCR0B = 0;
+volatile uint8_t OCR0A = 0;
+volatile uint8_t OCR0B = 0;
+volatile uint8_t TCCR1A = 0;
+volatile uint16_t OCR1A = 0;
+volatile uint16_t OCR1B = 0;
+volatile uint16_t OCR1C = 0;
+volatile uint8_t TCCR2A = 0;
+volatile uint8_t OCR2A = 0;
+volatile uint8_t OCR2B = 0;
+volatile uint8_t TCCR3A = 0;
+volatile uint16_t OCR3A = 0;
+volatile uint16_t OCR3B = 0;
+volatile uint16_t OCR3C = 0;
+volatile uint8_t TIMSK3 = 0;
+volatile uint8_t TCCR4A = 0;
+volatile uint8_t TCCR4B = 0;
+volatile uint16_t OCR4A = 0;
+volatile uint16_t OCR4B = 0;
+volatile uint16_t OCR4C = 0;
+volatile uint16_t ICR4 = 0;
+volatile uint8_t TCCR5A = 0;
+volatile uint8_t TCCR5B = 0;
+volatile uint16_t TCNT5 = 0;
+volatile uint16_t OCR5A = 0;
+volatile uint16_t OCR5B = 0;
+volatile uint16_t OCR5C = 0;
+volatile uint8_t TIMSK5 = 0;
+volatile uint8_t TIFR5 = 0;
+volatile uint8_t ADCSRA = 0;
+volatile uint8_t ADCSRB = 0;
+volatile uint8_t ADMUX = 0;
+volatile uint16_t ADC = 0;
+
+// Ports de sortie simulés (A à L, le port I n'existe pas).
+static volatile uint8_t simulatedPorts[13] = {};
+
+// Port, bit et timer de chaque broche de l'Arduino Méga (`digital_pin_to_port_PGM`, `digital_pin_to_bit_mask_PGM` et `digital_pin_to_timer_PGM` de `pins_arduino.h`).
+#define PA 1
+#define PB 2
+#define PC 3
+#define PD 4
+#define PE 5
+#define PF 6
+#define PG 7
+#define PH 8
+#define PJ 10
+#define PK 11
+#define PL 12
+
+#define PINS_NUMBER 70
+
+static const uint8_t pinPorts[PINS_NUMBER] = {
+    PE, PE, PE, PE, PG, PE, PH, PH, PH, PH, PB, PB, PB, PB, PJ, PJ, PH, PH, PD, PD,
+    PD, PD, PA, PA, PA, PA, PA, PA, PA, PA, PC, PC, PC, PC, PC, PC, PC, PC, PD, PG,
+    PG, PG, PL, PL, PL, PL, PL, PL, PL, PL, PB, PB, PB, PB, PF, PF, PF, PF, PF, PF,
+    PF, PF, PK, PK, PK, PK, PK, PK, PK, PK};
+
+static const uint8_t pinBits[PINS_NUMBER] = {
+    0, 1, 4, 5, 5, 3, 3, 4, 5, 6, 4, 5, 6, 7, 1, 0, 1, 0, 3, 2,
+    1, 0, 0, 1, 2, 3, 4, 5, 6, 7, 7, 6, 5, 4, 3, 2, 1, 0, 7, 2,
+    1, 0, 7, 6, 5, 4, 3, 2, 1, 0, 3, 2, 1, 0, 0, 1, 2, 3, 4, 5,
+    6, 7, 0, 1, 2, 3, 4, 5, 6, 7};
+
+static const uint8_t pinTimers[PINS_NUMBER] = {
+    NOT_ON_TIMER, NOT_ON_TIMER, TIMER3B, TIMER3C, TIMER0B, TIMER3A, TIMER4A, TIMER4B, TIMER4C, TIMER2B,
+    TIMER2A, TIMER1A, TIMER1B, TIMER0A, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER,
+    NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER,
+    NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER,
+    NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER, TIMER5C, TIMER5B, TIMER5A, NOT_ON_TIMER, NOT_ON_TIMER, NOT_ON_TIMER};
+
+// Valeurs renvoyées par `analogRead()`, choisies par les tests.
+static int analogValues[16] = {};
+
+// État du générateur pseudo-aléatoire (même algorithme que `random()` d'avr-libc).
+static unsigned long randomState = 1;
+
+HardwareSerial Serial;
+
+/// @brief Convertit une valeur d'un intervalle à un autre, comme sur la carte.
+long map(long x, long inMinimum, long inMaximum, long outMinimum, long outMaximum)
+{
+    return (x - inMinimum) * (outMaximum - outMinimum) / (inMaximum - inMinimum) + outMinimum;
+}
+
+/// @brief Générateur pseudo-aléatoire de Park et Miller, comme `random()` d'avr-libc.
+static long nextRandom()
+{
+    long hi = randomState / 127773L;
+    long lo = randomState % 127773L;
+    long x = 16807L * lo - 2836L * hi;
+
+    if (x < 0)
+        x += 0x7FFFFFFFL;
+
+    randomState = x;
+    return x % (0x7FFFFFFFL + 1UL);
+}
+
+/// @brief Renvoie un nombre pseudo-aléatoire de `0` à `maximum - 1`.
+long random(long maximum)
+{
+    if (maximum == 0)
+        return 0;
+
+    return nextRandom() % maximum;
+}
+
+/// @brief Renvoie un nombre pseudo-aléatoire de `minimum` à `maximum - 1`.
+long random(long minimum, long maximum)
+{
+    if (minimum >= maximum)
+        return minimum;
+
+    return random(maximum - minimum) + minimum;
+}
+
+/// @brief Initialise le générateur pseudo-aléatoire.
+void randomSeed(unsigned long seed)
+{
+    if (seed != 0)
+        randomState = seed;
+}
+
+/// @brief Aucun registre de direction n'est simulé.
+void pinMode(uint8_t pin, uint8_t mode) {}
+
+/// @brief Écrit le bit de la broche dans son port simulé.
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    uint8_t port = digitalPinToPort(pin);
+    if (port == NOT_A_PIN)
+        return;
+
+    if (value == LOW)
+        simulatedPorts[port] &= ~digitalPinToBitMask(pin);
+
+    else
+        simulatedPorts[port] |= digitalPinToBitMask(pin);
+}
+
+/// @brief Lit le bit de la broche dans son port simulé.
+int digitalRead(uint8_t pin)
+{
+    uint8_t port = digitalPinToPort(pin);
+    if (port == NOT_A_PIN)
+        return LOW;
+
+    return (simulatedPorts[port] & digitalPinToBitMask(pin)) ? HIGH : LOW;
+}
+
+/// @brief Renvoie la valeur choisie par le test pour l'entrée analogique.
+int analogRead(uint8_t pin)
+{
+    if (pin >= A0)
+        pin -= A0;
+
+    return (pin < 16) ? analogValues[pin] : 0;
+}
+
+/// @brief Choisit la valeur renvoyée par `analogRead()`.
+/// @param pin L'entrée analogique (`A0` à `A15`, ou `0` à `15`).
+/// @param value La valeur, de `0` à `1023`.
+void setAnalogValue(uint8_t pin, int value)
+{
+    if (pin >= A0)
+        pin -= A0;
+
+    if (pin < 16)
+        analogValues[pin] = value;
+}
+
+/// @brief Renvoie le timer relié à la sortie PWM de la broche.
+uint8_t digitalPinToTimer(uint8_t pin)
+{
+    return (pin < (sizeof(pinTimers) / sizeof(pinTimers[0]))) ? pinTimers[pin] : NOT_ON_TIMER;
+}
+
+/// @brief Renvoie le port de la broche.
+uint8_t digitalPinToPort(uint8_t pin)
+{
+    return (pin < PINS_NUMBER) ? pinPorts[pin] : NOT_A_PIN;
+}
+
+/// @brief Renvoie le masque de la broche dans son port.
+uint8_t digitalPinToBitMask(uint8_t pin)
+{
+    return (pin < PINS_NUMBER) ? _BV(pinBits[pin]) : 0;
+}
+
+/// @brief Renvoie le registre de sortie simulé d'un port.
+volatile uint8_t *portOutputRegister(uint8_t port)
+{
+    return &simulatedPorts[port];
+}
+
+/// @brief Le port série simulé n'a rien à initialiser.
+void HardwareSerial::begin(unsigned long baud) {}
+
+/// @brief Aucun octet n'est jamais reçu.
+int HardwareSerial::available()
+{
+    return 0;
+}
+
+/// @brief Aucun octet n'est jamais reçu.
+int HardwareSerial::read()
+{
+    return -1;
+}
+
+/// @brief Les octets envoyés sont ignorés.
+size_t HardwareSerial::write(uint8_t character)
+{
+    return 1;
+}
+
+/// @brief Renvoie le temps simulé en millisecondes.
+unsigned long millis()
+{
+    return simulatedMicros / 1000;
+}
+
+/// @brief Renvoie le temps simulé en microsecondes.
+unsigned long micros()
+{
+    return simulatedMicros;
+}
+
+/// @brief Fait avancer le temps simulé (aucune attente réelle).
+void delay(unsigned long duration)
+{
+    advanceTime(duration);
+}
+
+/// @brief Fait avancer le temps simulé (aucune attente réelle).
+void delayMicroseconds(unsigned int duration)
+{
+    advanceMicros(duration);
+}
+
+/// @brief Fait avancer le temps simulé.
+/// @param duration La durée en millisecondes.
+void advanceTime(unsigned long duration)
+{
+    simulatedMicros += duration * 1000;
+}
+
+/// @brief Fait avancer le temps simulé.
+/// @param duration La durée en microsecondes.
+void advanceMicros(unsigned long duration)
+{
+    simulatedMicros += duration;
+}
+
+/// @brief Écrit un entier non signé dans une base (2 à 16) : renvoie le début du texte, écrit à la fin de `buffer`.
+static char *formatNumber(unsigned long value, uint8_t base, char *buffer, size_t size)
+{
+    char *text = &buffer[size - 1];
+    *text = '\0';
+
+    if (base < 2)
+        base = 10;
+
+    do
+    {
+        uint8_t digit = value % base;
+        *--text = (digit < 10) ? ('0' + digit) : ('A' + digit - 10);
+        value /= base;
+    } while (value > 0);
+
+    return text;
+}
+
+/// @brief Écrit un nombre à virgule comme `dtostrf()` d'avr-libc (simple précision).
+static void formatFloat(float value, unsigned char decimalPlaces, char *buffer, size_t size)
+{
+    snprintf(buffer, size, "%.*f", decimalPlaces, double(value));
+}
+
+String::String(const char *text) : m_buffer(nullptr), m_length(0)
+{
+    this->append(text, strlen(text));
+}
+
+String::String(const __FlashStringHelper *text) : m_buffer(nullptr), m_length(0)
+{
+    const char *characters = reinterpret_cast<const char *>(text);
+    this->append(characters, strlen(characters));
+}
+
+String::String(const String &string) : m_buffer(nullptr), m_length(0)
+{
+    this->append(string.c_str(), string.length());
+}
+
+String::String(char character) : m_buffer(nullptr), m_length(0)
+{
+    this->append(&character, 1);
+}
+
+String::String(unsigned char value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(int value, unsigned char base) : String(long(value), base) {}
+
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base) : m_buffer(nullptr), m_length(0)
+{
+    char buffer[34];
+    if (base == DEC && value < 0)
+    {
+        this->append("-", 1);
+        value = -value;
+    }
+
+    char *text = formatNumber((unsigned long)value, base, buffer, sizeof(buffer));
+    this->append(text, strlen(text));
+}
+
+String::String(unsigned long value, unsigned char base) : m_buffer(nullptr), m_length(0)
+{
+    char buffer[34];
+    char *text = formatNumber(value, base, buffer, sizeof(buffer));
+    this->append(text, strlen(text));
+}
+
+String::String(float value, unsigned char decimalPlaces) : m_buffer(nullptr), m_length(0)
+{
+    char buffer[48];
+    formatFloat(value, decimalPlaces, buffer, sizeof(buffer));
+    this->append(buffer, strlen(buffer));
+}
+
+String::String(double value, unsigned char decimalPlaces) : String(float(value), decimalPlaces) {}
+
+String::~String()
+{
+    free(m_buffer);
+}
+
+String &String::operator=(const String &string)
+{
+    if (this == &string)
+        return *this;
+
+    m_length = 0;
+    this->append(string.c_str(), string.length());
+    return *this;
+}
+
+String &String::operator=(const char *text)
+{
+    m_length = 0;
+    this->append(text, strlen(text));
+    return *this;
+}
+
+String &String::operator+=(const String &string)
+{
+    this->append(string.c_str(), string.length());
+    return *this;
+}
+
+String &String::operator+=(const char *text)
+{
+    this->append(text, strlen(text));
+    return *this;
+}
+
+String &String::operator+=(char character)
+{
+    this->append(&character, 1);
+    return *this;
+}
+
+bool String::operator==(const String &string) const
+{
+    return m_length == string.length() && memcmp(this->c_str(), string.c_str(), m_length) == 0;
+}
+
+bool String::operator==(const char *text) const
+{
+    return strcmp(this->c_str(), text) == 0;
+}
+
+bool String::operator!=(const String &string) const
+{
+    return !(*this == string);
+}
+
+bool String::operator!=(const char *text) const
+{
+    return !(*this == text);
+}
+
+char String::operator[](unsigned int index) const
+{
+    return (index < m_length) ? m_buffer[index] : '\0';
+}
+
+unsigned int String::length() const
+{
+    return m_length;
+}
+
+const char *String::c_str() const
+{
+    return (m_buffer != nullptr) ? m_buffer : "";
+}
+
+/// @brief Ajoute des caractères à la fin de la chaîne.
+void String::append(const char *text, unsigned int length)
+{
+    char *buffer = static_cast<char *>(realloc(m_buffer, m_length + length + 1));
+    if (buffer == nullptr)
+        return;
+
+    memmove(buffer + m_length, text, length);
+    m_buffer = buffer;
+    m_length += length;
+    m_buffer[m_length] = '\0';
+}
+
+String operator+(const String &left, const String &right)
+{
+    String result(left);
+    result += right;
+    return result;
+}
+
+String operator+(const String &left, const char *right)
+{
+    String result(left);
+    result += right;
+    return result;
+}
+
+String operator+(const char *left, const String &right)
+{
+    String result(left);
+    result += right;
+    return result;
+}
+
+Print::Print() : m_writeError(0) {}
+
+Print::~Print() {}
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t written = 0;
+    while (size--)
+    {
+        if (this->write(*buffer++) == 0)
+            break;
+
+        written++;
+    }
+
+    return written;
+}
+
+size_t Print::write(const char *text)
+{
+    return (text == nullptr) ? 0 : this->write(reinterpret_cast<const uint8_t *>(text), strlen(text));
+}
+
+size_t Print::write(const char *buffer, size_t size)
+{
+    return this->write(reinterpret_cast<const uint8_t *>(buffer), size);
+}
+
+size_t Print::print(const __FlashStringHelper *text)
+{
+    return this->write(reinterpret_cast<const char *>(text));
+}
+
+size_t Print::print(const String &string)
+{
+    return this->write(string.c_str(), string.length());
+}
+
+size_t Print::print(const char *text)
+{
+    return this->write(text);
+}
+
+size_t Print::print(char character)
+{
+    return this->write(uint8_t(character));
+}
+
+size_t Print::print(unsigned char value, int base)
+{
+    return this->print((unsigned long)value, base);
+}
+
+size_t Print::print(int value, int base)
+{
+    return this->print(long(value), base);
+}
+
+size_t Print::print(unsigned int value, int base)
+{
+    return this->print((unsigned long)value, base);
+}
+
+size_t Print::print(long value, int base)
+{
+    if (base == 0)
+        return this->write(uint8_t(value));
+
+    if (base == DEC && value < 0)
+    {
+        size_t written = this->print('-');
+        return written + this->printNumber((unsigned long)(-value), DEC);
+    }
+
+    return this->printNumber((unsigned long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+    if (base == 0)
+        return this->write(uint8_t(value));
+
+    return this->printNumber(value, base);
+}
+
+size_t Print::print(double value, int digits)
+{
+    return this->printFloat(float(value), digits);
+}
+
+size_t Print::println()
+{
+    return this->write("\r\n");
+}
+
+size_t Print::println(const __FlashStringHelper *text)
+{
+    size_t written = this->print(text);
+    return written + this->println();
+}
+
+size_t Print::println(const String &string)
+{
+    size_t written = this->print(string);
+    return written + this->println();
+}
+
+size_t Print::println(const char *text)
+{
+    size_t written = this->print(text);
+    return written + this->println();
+}
+
+size_t Print::println(int value, int base)
+{
+    size_t written = this->print(value, base);
+    return written + this->println();
+}
+
+int Print::getWriteError() const
+{
+    return m_writeError;
+}
+
+void Print::clearWriteError()
+{
+    m_writeError = 0;
+}
+
+void Print::setWriteError(int error)
+{
+    m_writeError = error;
+}
+
+size_t Print::printNumber(unsigned long value, uint8_t base)
+{
+    char buffer[34];
+    return this->write(formatNumber(value, base, buffer, sizeof(buffer)));
+}
+
+/// @brief Affiche un nombre à virgule avec l'algorithme de la classe `Print` d'Arduino, en simple précision comme sur la carte.
+size_t Print::printFloat(float value, uint8_t digits)
+{
+    if (isnan(value))
+        return this->print("nan");
+
+    if (isinf(value))
+        return this->print("inf");
+
+    if (value > 4294967040.0f || value < -4294967040.0f)
+        return this->print("ovf");
+
+    size_t written = 0;
+    if (value < 0.0f)
+    {
+        written += this->print('-');
+        value = -value;
+    }
+
+    float rounding = 0.5f;
+    for (uint8_t i = 0; i < digits; i++)
+        rounding /= 10.0f;
+
+    value += rounding;
+
+    unsigned long integerPart = (unsigned long)value;
+    float remainder = value - float(integerPart);
+    written += this->print(integerPart);
+
+    if (digits > 0)
+        written += this->print('.');
+
+    while (digits-- > 0)
+    {
+        remainder *= 10.0f;
+        unsigned int digit = (unsigned int)remainder;
+        written += this->print(digit);
+        remainder -= digit;
+    }
+
+    return written;
+}
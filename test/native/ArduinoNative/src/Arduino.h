@@ -0,0 +1,191 @@
+#ifndef ARDUINO_NATIVE_DEFINITIONS
+#define ARDUINO_NATIVE_DEFINITIONS
+
+// Remplaçant du cœur Arduino pour compiler l'écran et les périphériques testés sur l'ordinateur (environnement `native`) : seules les fonctions utilisées par ces fichiers sont fournies, et le temps est simulé.
+
+// Ajout des bibliothèques au programme.
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Autres fichiers du programme.
+#include "avr/pgmspace.h"
+#include "avr/io.h"
+#include "avr/interrupt.h"
+
+// Version du cœur Arduino simulée (les mêmes options que sur la carte sont compilées).
+#ifndef ARDUINO
+#define ARDUINO 10819
+#endif
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+// Comme sur la carte, `min()` et `max()` sont des macros : les en-têtes de la bibliothèque standard doivent être inclus avant celui-ci.
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#define constrain(x, low, high) ((x) < (low) ? (low) : ((x) > (high) ? (high) : (x)))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+class __FlashStringHelper;
+#define F(text) (reinterpret_cast<const __FlashStringHelper *>(PSTR(text)))
+
+long map(long x, long inMinimum, long inMaximum, long outMinimum, long outMaximum);
+long random(long maximum);
+long random(long minimum, long maximum);
+void randomSeed(unsigned long seed);
+
+// Broches de l'Arduino Méga : premières entrées analogiques et timers reliés aux sorties PWM, avec les mêmes valeurs que dans `pins_arduino.h`.
+#define A0 54
+#define A1 55
+#define A2 56
+
+#define NOT_A_PIN 0
+#define NOT_ON_TIMER 0
+#define TIMER0A 1
+#define TIMER0B 2
+#define TIMER1A 3
+#define TIMER1B 4
+#define TIMER1C 5
+#define TIMER2 6
+#define TIMER2A 7
+#define TIMER2B 8
+#define TIMER3A 9
+#define TIMER3B 10
+#define TIMER3C 11
+#define TIMER4A 12
+#define TIMER4B 13
+#define TIMER4C 14
+#define TIMER4D 15
+#define TIMER5A 16
+#define TIMER5B 17
+#define TIMER5C 18
+
+// Entrées et sorties simulées : les ports sont de simples variables, et `analogRead()` renvoie la valeur choisie par le test.
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void setAnalogValue(uint8_t pin, int value);
+uint8_t digitalPinToTimer(uint8_t pin);
+uint8_t digitalPinToPort(uint8_t pin);
+uint8_t digitalPinToBitMask(uint8_t pin);
+volatile uint8_t *portOutputRegister(uint8_t port);
+
+// Les interruptions sont simulées par des appels directs des tests : les sections atomiques n'ont rien à faire.
+#define noInterrupts() cli()
+#define interrupts() sei()
+
+// Temps simulé : il n'avance que lorsque le test le demande, pour que les affichages soient reproductibles.
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long duration);
+void delayMicroseconds(unsigned int duration);
+void advanceTime(unsigned long duration);
+void advanceMicros(unsigned long duration);
+
+/// @brief Chaîne de caractères dynamique, avec les méthodes de la classe `String` d'Arduino utilisées par le programme.
+class String
+{
+public:
+    String(const char *text = "");
+    String(const __FlashStringHelper *text);
+    String(const String &string);
+    explicit String(char character);
+    explicit String(unsigned char value, unsigned char base = DEC);
+    explicit String(int value, unsigned char base = DEC);
+    explicit String(unsigned int value, unsigned char base = DEC);
+    explicit String(long value, unsigned char base = DEC);
+    explicit String(unsigned long value, unsigned char base = DEC);
+    explicit String(float value, unsigned char decimalPlaces = 2);
+    explicit String(double value, unsigned char decimalPlaces = 2);
+    ~String();
+    String &operator=(const String &string);
+    String &operator=(const char *text);
+    String &operator+=(const String &string);
+    String &operator+=(const char *text);
+    String &operator+=(char character);
+    bool operator==(const String &string) const;
+    bool operator==(const char *text) const;
+    bool operator!=(const String &string) const;
+    bool operator!=(const char *text) const;
+    char operator[](unsigned int index) const;
+    unsigned int length() const;
+    const char *c_str() const;
+
+protected:
+    void append(const char *text, unsigned int length);
+
+    char *m_buffer;
+    unsigned int m_length;
+};
+
+String operator+(const String &left, const String &right);
+String operator+(const String &left, const char *right);
+String operator+(const char *left, const String &right);
+
+/// @brief Classe d'affichage de texte et de nombres, comme la classe `Print` d'Arduino (les nombres à virgule sont calculés en simple précision, comme sur la carte).
+class Print
+{
+public:
+    Print();
+    virtual ~Print();
+    virtual size_t write(uint8_t character) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *text);
+    size_t write(const char *buffer, size_t size);
+    size_t print(const __FlashStringHelper *text);
+    size_t print(const String &string);
+    size_t print(const char *text);
+    size_t print(char character);
+    size_t print(unsigned char value, int base = DEC);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+    size_t println();
+    size_t println(const __FlashStringHelper *text);
+    size_t println(const String &string);
+    size_t println(const char *text);
+    size_t println(int value, int base = DEC);
+    int getWriteError() const;
+    void clearWriteError();
+
+protected:
+    void setWriteError(int error = 1);
+    size_t printNumber(unsigned long value, uint8_t base);
+    size_t printFloat(float value, uint8_t digits);
+
+    int m_writeError;
+};
+
+/// @brief Port série, dont les octets envoyés sont ignorés (le faux `HomeAssistant` des tests ne l'utilise pas).
+class HardwareSerial : public Print
+{
+public:
+    void begin(unsigned long baud);
+    int available();
+    int read();
+    size_t write(uint8_t character) override;
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#endif
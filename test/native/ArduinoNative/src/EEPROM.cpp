@@ -0,0 +1,48 @@
+/**
+ * @file EEPROM.cpp
+ * @brief Mémoire EEPROM simulée pour l'environnement `native`.
+ */
+
+// Ajout des bibliothèques au programme.
+#include <string.h>
+#include "EEPROM.h"
+
+EEPROMClass EEPROM;
+
+/// @brief Constructeur de la classe : comme une mémoire neuve, tous les octets valent `0xFF`.
+EEPROMClass::EEPROMClass() : m_writesNumber(0)
+{
+    memset(m_memory, 0xFF, sizeof(m_memory));
+}
+
+/// @brief Lit un octet (`0` en dehors de la mémoire).
+uint8_t EEPROMClass::read(int address)
+{
+    if (address < 0 || address >= EEPROM_SIZE)
+        return 0;
+
+    return m_memory[address];
+}
+
+/// @brief Écrit un octet, même s'il est identique.
+void EEPROMClass::write(int address, uint8_t value)
+{
+    if (address < 0 || address >= EEPROM_SIZE)
+        return;
+
+    m_memory[address] = value;
+    m_writesNumber++;
+}
+
+/// @brief Écrit un octet uniquement s'il a changé.
+void EEPROMClass::update(int address, uint8_t value)
+{
+    if (this->read(address) != value)
+        this->write(address, value);
+}
+
+/// @brief Renvoie le nombre d'écritures effectuées.
+unsigned long EEPROMClass::getWritesNumber() const
+{
+    return m_writesNumber;
+}
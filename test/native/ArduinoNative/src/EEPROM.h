@@ -0,0 +1,27 @@
+#ifndef ARDUINO_NATIVE_EEPROM_DEFINITIONS
+#define ARDUINO_NATIVE_EEPROM_DEFINITIONS
+
+// Ajout des bibliothèques au programme.
+#include <stdint.h>
+
+// Taille de la mémoire EEPROM de l'ATmega2560.
+#define EEPROM_SIZE 4096
+
+/// @brief Mémoire EEPROM simulée en mémoire vive, avec les méthodes de la bibliothèque EEPROM d'Arduino utilisées par le programme. Le nombre d'écritures est compté pour vérifier l'usure.
+class EEPROMClass
+{
+public:
+    EEPROMClass();
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    void update(int address, uint8_t value);
+    unsigned long getWritesNumber() const;
+
+protected:
+    uint8_t m_memory[EEPROM_SIZE];
+    unsigned long m_writesNumber;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,379 @@
+/**
+ * @file SSD1306Simulator.cpp
+ * @brief Écran SSD1306 simulé et registres du module TWI de l'ATmega2560, pour tester l'écran sur l'ordinateur.
+ */
+
+// Ajout des bibliothèques au programme.
+#include <string.h>
+#include "avr/io.h"
+#include "SSD1306Simulator.h"
+
+SSD1306Simulator simulatedScreen(0x3C);
+
+TWIControlRegister TWCR;
+volatile uint8_t TWDR = 0;
+volatile uint8_t TWSR = 0xF8;
+volatile uint8_t TWBR = 0;
+
+// Contenu de la mémoire de l'écran à la mise sous tension : un motif plutôt que des zéros, pour que les zones jamais envoyées soient visibles.
+#define SSD1306_SIMULATOR_POWER_ON_PATTERN 0xA5
+
+/// @brief Constructeur de la classe.
+/// @param address L'adresse I2C de l'écran.
+SSD1306Simulator::SSD1306Simulator(uint8_t address) : m_address(address)
+{
+    this->reset();
+    m_receivedBytes = 0;
+    m_transactions = 0;
+    m_dataBytes = 0;
+}
+
+/// @brief Remet l'écran dans son état de mise sous tension (adressage par page, écran éteint, mémoire indéterminée). Les compteurs ne sont pas remis à zéro.
+void SSD1306Simulator::reset()
+{
+    memset(m_memory, SSD1306_SIMULATOR_POWER_ON_PATTERN, sizeof(m_memory));
+    m_selected = false;
+    m_controlExpected = false;
+    m_dataMode = false;
+    m_commandLength = 0;
+    m_argumentsNumber = 0;
+    m_addressingMode = 2;
+    m_firstColumn = 0;
+    m_lastColumn = SSD1306_SIMULATOR_WIDTH - 1;
+    m_firstPage = 0;
+    m_lastPage = SSD1306_SIMULATOR_PAGES - 1;
+    m_column = 0;
+    m_page = 0;
+    m_startLine = 0;
+    m_contrast = 0x7F;
+    m_inverted = false;
+    m_on = false;
+    m_entireDisplayOn = false;
+}
+
+/// @brief Reçoit l'adresse d'une transaction d'écriture.
+/// @param address L'adresse sur 7 bit envoyée par le maître.
+/// @return `true` si l'écran acquitte l'adresse.
+bool SSD1306Simulator::startTransaction(uint8_t address)
+{
+    m_selected = address == m_address;
+    m_controlExpected = true;
+
+    if (m_selected)
+        m_transactions++;
+
+    return m_selected;
+}
+
+/// @brief Reçoit un octet de la transaction en cours : octet de contrôle, commande ou donnée.
+/// @param byte L'octet reçu.
+void SSD1306Simulator::receive(uint8_t byte)
+{
+    if (!m_selected)
+        return;
+
+    m_receivedBytes++;
+
+    // L'octet de contrôle indique si la suite contient des commandes ou des données (D/C#), et s'il ne concerne que l'octet suivant (Co).
+    if (m_controlExpected)
+    {
+        m_dataMode = byte & 0x40;
+        m_controlExpected = byte & 0x80;
+        return;
+    }
+
+    if (m_dataMode)
+        this->writeData(byte);
+
+    else
+        this->receiveCommand(byte);
+}
+
+/// @brief Termine la transaction en cours.
+void SSD1306Simulator::stopTransaction()
+{
+    m_selected = false;
+}
+
+/// @brief Renvoie l'état d'un pixel tel qu'il est affiché : la ligne de départ, l'inversion des couleurs et la mise en marche sont appliquées.
+/// @param x La colonne du pixel.
+/// @param y La ligne du pixel.
+/// @return `true` si le pixel est allumé.
+bool SSD1306Simulator::getPixel(int16_t x, int16_t y) const
+{
+    if (!m_on || x < 0 || x >= SSD1306_SIMULATOR_WIDTH || y < 0 || y >= SSD1306_SIMULATOR_HEIGHT)
+        return false;
+
+    if (m_entireDisplayOn)
+        return true;
+
+    uint8_t line = (y + m_startLine) % SSD1306_SIMULATOR_HEIGHT;
+    bool lit = m_memory[(line / 8) * SSD1306_SIMULATOR_WIDTH + x] & (1 << (line % 8));
+    return lit != m_inverted;
+}
+
+/// @brief Copie l'image affichée, rangée comme la mémoire tampon de la bibliothèque Adafruit (8 pages de 128 colonnes, le bit de poids faible en haut).
+/// @param image L'image de 1024 octets à remplir.
+void SSD1306Simulator::getImage(uint8_t image[SSD1306_SIMULATOR_PAGES * SSD1306_SIMULATOR_WIDTH]) const
+{
+    memset(image, 0, SSD1306_SIMULATOR_PAGES * SSD1306_SIMULATOR_WIDTH);
+
+    for (int16_t y = 0; y < SSD1306_SIMULATOR_HEIGHT; y++)
+    {
+        for (int16_t x = 0; x < SSD1306_SIMULATOR_WIDTH; x++)
+        {
+            if (this->getPixel(x, y))
+                image[(y / 8) * SSD1306_SIMULATOR_WIDTH + x] |= 1 << (y % 8);
+        }
+    }
+}
+
+/// @brief Renvoie la mémoire d'affichage brute (sans ligne de départ ni inversion).
+const uint8_t *SSD1306Simulator::getMemory() const
+{
+    return m_memory;
+}
+
+/// @brief Renvoie la ligne de la mémoire affichée en haut de l'écran (commande `SETSTARTLINE`).
+uint8_t SSD1306Simulator::getStartLine() const
+{
+    return m_startLine;
+}
+
+/// @brief Renvoie le contraste de l'écran.
+uint8_t SSD1306Simulator::getContrast() const
+{
+    return m_contrast;
+}
+
+/// @brief Indique si les couleurs de l'écran sont inversées.
+bool SSD1306Simulator::isInverted() const
+{
+    return m_inverted;
+}
+
+/// @brief Indique si l'écran est allumé.
+bool SSD1306Simulator::isOn() const
+{
+    return m_on;
+}
+
+/// @brief Renvoie le nombre d'octets reçus depuis le démarrage, octets de contrôle compris (l'adresse n'est pas comptée).
+unsigned long SSD1306Simulator::getReceivedBytes() const
+{
+    return m_receivedBytes;
+}
+
+/// @brief Renvoie le nombre de transactions acquittées depuis le démarrage.
+unsigned long SSD1306Simulator::getTransactions() const
+{
+    return m_transactions;
+}
+
+/// @brief Renvoie le nombre d'octets écrits dans la mémoire d'affichage depuis le démarrage.
+unsigned long SSD1306Simulator::getDataBytes() const
+{
+    return m_dataBytes;
+}
+
+/// @brief Ajoute un octet à la commande en cours, et l'exécute lorsque tous ses arguments ont été reçus.
+void SSD1306Simulator::receiveCommand(uint8_t byte)
+{
+    if (m_commandLength == 0)
+    {
+        switch (byte)
+        {
+        case 0x20: // Mode d'adressage.
+        case 0x81: // Contraste.
+        case 0x8D: // Pompe de charge.
+        case 0xA8: // Nombre de lignes.
+        case 0xD3: // Décalage vertical.
+        case 0xD5: // Horloge.
+        case 0xD9: // Précharge.
+        case 0xDA: // Configuration des lignes.
+        case 0xDB: // Tension VCOMH.
+            m_argumentsNumber = 1;
+            break;
+
+        case 0x21: // Colonnes de la fenêtre d'écriture.
+        case 0x22: // Pages de la fenêtre d'écriture.
+        case 0xA3: // Zone de défilement vertical.
+            m_argumentsNumber = 2;
+            break;
+
+        case 0x26: // Défilement horizontal.
+        case 0x27:
+            m_argumentsNumber = 6;
+            break;
+
+        case 0x29: // Défilement vertical et horizontal.
+        case 0x2A:
+            m_argumentsNumber = 5;
+            break;
+
+        default:
+            m_argumentsNumber = 0;
+            break;
+        }
+    }
+
+    m_command[m_commandLength++] = byte;
+
+    if (m_commandLength > m_argumentsNumber)
+    {
+        this->executeCommand();
+        m_commandLength = 0;
+    }
+}
+
+/// @brief Exécute la commande reçue (les commandes de configuration électrique et de défilement automatique sont ignorées).
+void SSD1306Simulator::executeCommand()
+{
+    uint8_t command = m_command[0];
+
+    if (command <= 0x0F)
+        m_column = (m_column & 0xF0) | command;
+
+    else if (command <= 0x1F)
+        m_column = ((command & 0x07) << 4) | (m_column & 0x0F);
+
+    else if (command == 0x20)
+        m_addressingMode = m_command[1] & 0x03;
+
+    else if (command == 0x21)
+    {
+        m_firstColumn = m_command[1] & 0x7F;
+        m_lastColumn = m_command[2] & 0x7F;
+        m_column = m_firstColumn;
+    }
+
+    else if (command == 0x22)
+    {
+        m_firstPage = m_command[1] & 0x07;
+        m_lastPage = m_command[2] & 0x07;
+        m_page = m_firstPage;
+    }
+
+    else if (command >= 0x40 && command <= 0x7F)
+        m_startLine = command & 0x3F;
+
+    else if (command == 0x81)
+        m_contrast = m_command[1];
+
+    else if (command == 0xA4 || command == 0xA5)
+        m_entireDisplayOn = command == 0xA5;
+
+    else if (command == 0xA6 || command == 0xA7)
+        m_inverted = command == 0xA7;
+
+    else if (command == 0xAE || command == 0xAF)
+        m_on = command == 0xAF;
+
+    else if (command >= 0xB0 && command <= 0xB7)
+        m_page = command & 0x07;
+}
+
+/// @brief Écrit un octet dans la mémoire d'affichage et avance le pointeur selon le mode d'adressage.
+void SSD1306Simulator::writeData(uint8_t byte)
+{
+    m_memory[m_page * SSD1306_SIMULATOR_WIDTH + m_column] = byte;
+    m_dataBytes++;
+
+    // Adressage horizontal : colonne suivante, puis page suivante de la fenêtre.
+    if (m_addressingMode == 0)
+    {
+        if (m_column++ >= m_lastColumn)
+        {
+            m_column = m_firstColumn;
+            m_page = (m_page >= m_lastPage) ? m_firstPage : (m_page + 1);
+        }
+    }
+
+    // Adressage vertical : page suivante, puis colonne suivante de la fenêtre.
+    else if (m_addressingMode == 1)
+    {
+        if (m_page++ >= m_lastPage)
+        {
+            m_page = m_firstPage;
+            m_column = (m_column >= m_lastColumn) ? m_firstColumn : (m_column + 1);
+        }
+    }
+
+    // Adressage par page : seule la colonne avance.
+    else
+        m_column = (m_column + 1) % SSD1306_SIMULATOR_WIDTH;
+}
+
+/// @brief Constructeur de la classe.
+TWIControlRegister::TWIControlRegister() : m_value(0), m_open(false), m_addressExpected(false) {}
+
+/// @brief Lit le registre : l'opération précédente étant toujours terminée, TWINT est levé après chaque opération et TWSTO est toujours à zéro.
+TWIControlRegister::operator uint8_t() const
+{
+    return m_value;
+}
+
+/// @brief Lance l'opération demandée sur le bus simulé et la termine immédiatement, en mettant à jour le registre d'état TWSR.
+/// @param value La valeur écrite dans le registre.
+TWIControlRegister &TWIControlRegister::operator=(uint8_t value)
+{
+    // Module désactivé : la transaction en cours est abandonnée.
+    if (!(value & _BV(TWEN)))
+    {
+        if (m_open)
+            simulatedScreen.stopTransaction();
+
+        m_open = false;
+        m_value = value;
+        TWSR = 0xF8;
+        return *this;
+    }
+
+    // Condition d'arrêt.
+    if (value & _BV(TWSTO))
+    {
+        if (m_open)
+            simulatedScreen.stopTransaction();
+
+        m_open = false;
+        m_value = value & ~(_BV(TWSTO) | _BV(TWINT));
+        TWSR = 0xF8;
+        return *this;
+    }
+
+    // Condition de départ (0x08) ou de départ répété (0x10).
+    if (value & _BV(TWSTA))
+    {
+        if (m_open)
+            simulatedScreen.stopTransaction();
+
+        TWSR = m_open ? 0x10 : 0x08;
+        m_open = true;
+        m_addressExpected = true;
+        m_value = value | _BV(TWINT);
+        return *this;
+    }
+
+    // Envoi de TWDR : adresse acquittée (0x18) ou non (0x20), puis octet acquitté (0x28).
+    if ((value & _BV(TWINT)) && m_open)
+    {
+        if (m_addressExpected)
+        {
+            m_addressExpected = false;
+            bool write = !(TWDR & 0x01);
+            TWSR = (write && simulatedScreen.startTransaction(TWDR >> 1)) ? 0x18 : 0x20;
+        }
+
+        else
+        {
+            simulatedScreen.receive(TWDR);
+            TWSR = 0x28;
+        }
+
+        m_value = value | _BV(TWINT);
+        return *this;
+    }
+
+    m_value = value;
+    return *this;
+}
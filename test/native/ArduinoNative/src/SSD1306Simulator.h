@@ -0,0 +1,63 @@
+#ifndef SSD1306_SIMULATOR_DEFINITIONS
+#define SSD1306_SIMULATOR_DEFINITIONS
+
+#include <stdint.h>
+
+#define SSD1306_SIMULATOR_WIDTH 128
+#define SSD1306_SIMULATOR_HEIGHT 64
+#define SSD1306_SIMULATOR_PAGES 8
+
+/// @brief Écran SSD1306 simulé, seul périphérique du bus I2C : les commandes reçues sont interprétées (adressage, ligne de départ, inversion, mise en marche) et les données écrites dans sa mémoire d'affichage (GDDRAM). Les octets reçus sont comptés pour mesurer le coût des affichages.
+class SSD1306Simulator
+{
+public:
+    SSD1306Simulator(uint8_t address);
+    void reset();
+    bool startTransaction(uint8_t address);
+    void receive(uint8_t byte);
+    void stopTransaction();
+    bool getPixel(int16_t x, int16_t y) const;
+    void getImage(uint8_t image[SSD1306_SIMULATOR_PAGES * SSD1306_SIMULATOR_WIDTH]) const;
+    const uint8_t *getMemory() const;
+    uint8_t getStartLine() const;
+    uint8_t getContrast() const;
+    bool isInverted() const;
+    bool isOn() const;
+    unsigned long getReceivedBytes() const;
+    unsigned long getTransactions() const;
+    unsigned long getDataBytes() const;
+
+protected:
+    void receiveCommand(uint8_t byte);
+    void executeCommand();
+    void writeData(uint8_t byte);
+
+    const uint8_t m_address;
+    uint8_t m_memory[SSD1306_SIMULATOR_PAGES * SSD1306_SIMULATOR_WIDTH];
+    bool m_selected;
+    bool m_controlExpected;
+    bool m_dataMode;
+    uint8_t m_command[7];
+    uint8_t m_commandLength;
+    uint8_t m_argumentsNumber;
+    uint8_t m_addressingMode;
+    uint8_t m_firstColumn;
+    uint8_t m_lastColumn;
+    uint8_t m_firstPage;
+    uint8_t m_lastPage;
+    uint8_t m_column;
+    uint8_t m_page;
+    uint8_t m_startLine;
+    uint8_t m_contrast;
+    bool m_inverted;
+    bool m_on;
+    bool m_entireDisplayOn;
+    unsigned long m_receivedBytes;
+    unsigned long m_transactions;
+    unsigned long m_dataBytes;
+};
+
+// Écran simulé branché au bus (adresse 0x3C, comme l'écran du système).
+extern SSD1306Simulator simulatedScreen;
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file Wire.cpp
+ * @brief Bus I2C simulé avec l'interface de la bibliothèque Wire, relié à l'écran simulé.
+ */
+
+// Ajout des bibliothèques au programme.
+#include "Wire.h"
+#include "SSD1306Simulator.h"
+
+TwoWire Wire;
+
+/// @brief Constructeur de la classe.
+TwoWire::TwoWire() : m_address(0), m_buffer(), m_length(0), m_transmitting(false), m_clock(100000UL) {}
+
+/// @brief Initialise le bus (à 100 kHz, comme la bibliothèque Wire).
+void TwoWire::begin()
+{
+    m_clock = 100000UL;
+}
+
+/// @brief Arrête le bus.
+void TwoWire::end()
+{
+    m_transmitting = false;
+}
+
+/// @brief Règle la fréquence du bus.
+/// @param clock La fréquence en hertz.
+void TwoWire::setClock(uint32_t clock)
+{
+    m_clock = clock;
+}
+
+/// @brief Le bus simulé ne se bloque jamais : le délai maximal est ignoré.
+void TwoWire::setWireTimeout(uint32_t timeout, bool resetWithTimeout)
+{
+}
+
+/// @brief Commence une transaction d'écriture.
+/// @param address L'adresse sur 7 bit du périphérique.
+void TwoWire::beginTransmission(uint8_t address)
+{
+    m_address = address;
+    m_length = 0;
+    m_transmitting = true;
+}
+
+/// @brief Envoie la transaction à l'écran simulé.
+/// @param sendStop Inutilisé : la transaction est toujours terminée par une condition d'arrêt.
+/// @return `0` si la transaction a été acquittée, `2` si l'adresse n'a pas été acquittée.
+uint8_t TwoWire::endTransmission(bool sendStop)
+{
+    m_transmitting = false;
+
+    if (!simulatedScreen.startTransaction(m_address))
+    {
+        simulatedScreen.stopTransaction();
+        return 2;
+    }
+
+    for (uint8_t i = 0; i < m_length; i++)
+        simulatedScreen.receive(m_buffer[i]);
+
+    simulatedScreen.stopTransaction();
+    return 0;
+}
+
+/// @brief Ajoute un octet à la transaction en cours.
+/// @return `1` si l'octet a été mémorisé, `0` si la mémoire tampon est pleine.
+size_t TwoWire::write(uint8_t byte)
+{
+    if (!m_transmitting || m_length >= BUFFER_LENGTH)
+    {
+        this->setWriteError();
+        return 0;
+    }
+
+    m_buffer[m_length++] = byte;
+    return 1;
+}
+
+/// @brief Ajoute des octets à la transaction en cours.
+/// @return Le nombre d'octets mémorisés.
+size_t TwoWire::write(const uint8_t *buffer, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        if (this->write(buffer[i]) == 0)
+            return i;
+    }
+
+    return size;
+}
+
+/// @brief Renvoie la fréquence actuelle du bus.
+uint32_t TwoWire::getClock() const
+{
+    return m_clock;
+}
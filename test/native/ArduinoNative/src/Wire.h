@@ -0,0 +1,36 @@
+#ifndef ARDUINO_NATIVE_WIRE_DEFINITIONS
+#define ARDUINO_NATIVE_WIRE_DEFINITIONS
+
+// Ajout des bibliothèques au programme.
+#include "Arduino.h"
+
+// Taille de la mémoire tampon d'émission de la bibliothèque Wire de la carte : les octets au-delà sont perdus.
+#define BUFFER_LENGTH 32
+
+/// @brief Bus I2C simulé avec l'interface de la bibliothèque Wire : chaque transaction est envoyée à l'écran simulé lors de `endTransmission()`. Comme sur la carte, une transaction ne peut pas dépasser `BUFFER_LENGTH` octets (une écriture de trop lève l'erreur d'écriture).
+class TwoWire : public Print
+{
+public:
+    TwoWire();
+    void begin();
+    void end();
+    void setClock(uint32_t clock);
+    void setWireTimeout(uint32_t timeout = 25000, bool resetWithTimeout = false);
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(bool sendStop = true);
+    size_t write(uint8_t byte) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    uint32_t getClock() const;
+
+protected:
+    uint8_t m_address;
+    uint8_t m_buffer[BUFFER_LENGTH];
+    uint8_t m_length;
+    bool m_transmitting;
+    uint32_t m_clock;
+};
+
+extern TwoWire Wire;
+
+#endif
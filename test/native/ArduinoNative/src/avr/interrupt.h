@@ -0,0 +1,10 @@
+#ifndef ARDUINO_NATIVE_INTERRUPT_DEFINITIONS
+#define ARDUINO_NATIVE_INTERRUPT_DEFINITIONS
+
+// Sur l'ordinateur, une routine d'interruption est une fonction ordinaire du nom de son vecteur : les tests l'appellent pour simuler l'interruption.
+#define ISR(vector) extern "C" void vector()
+
+#define cli()
+#define sei()
+
+#endif
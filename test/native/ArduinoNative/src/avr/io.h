@@ -0,0 +1,120 @@
+#ifndef ARDUINO_NATIVE_IO_DEFINITIONS
+#define ARDUINO_NATIVE_IO_DEFINITIONS
+
+// Registres de l'ATmega2560 simulés. Ceux du module TWI (I2C) terminent immédiatement chaque opération demandée par `TWCR` et transmettent les octets à l'écran simulé (voir `SSD1306Simulator`). Ceux des timers, du convertisseur analogique-numérique et des ports sont de simples variables : les tests les lisent pour vérifier ce que le programme y a écrit.
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+
+// Bits du registre TWCR.
+#define TWINT 7
+#define TWEA 6
+#define TWSTA 5
+#define TWSTO 4
+#define TWWC 3
+#define TWEN 2
+#define TWIE 0
+
+/// @brief Registre de contrôle du module TWI : une écriture lance l'opération demandée (condition de départ, envoi de TWDR ou condition d'arrêt) sur le bus simulé.
+class TWIControlRegister
+{
+public:
+    TWIControlRegister();
+    operator uint8_t() const;
+    TWIControlRegister &operator=(uint8_t value);
+
+protected:
+    uint8_t m_value;
+    bool m_open;
+    bool m_addressExpected;
+};
+
+extern TWIControlRegister TWCR;
+extern volatile uint8_t TWDR;
+extern volatile uint8_t TWSR;
+extern volatile uint8_t TWBR;
+
+// Bits des registres de contrôle des timers.
+#define COM0A1 7
+#define COM0B1 5
+#define WGM01 1
+#define WGM00 0
+#define COM1A1 7
+#define COM1B1 5
+#define COM1C1 3
+#define COM2A1 7
+#define COM2B1 5
+#define COM3A1 7
+#define COM3B1 5
+#define COM3C1 3
+#define COM4A1 7
+#define COM4B1 5
+#define COM4C1 3
+#define WGM41 1
+#define WGM43 4
+#define WGM42 3
+#define CS40 0
+#define COM5A1 7
+#define COM5B1 5
+#define COM5C1 3
+#define CS51 1
+
+// Bits des registres d'interruption des timers.
+#define TOIE3 0
+#define OCIE5A 1
+#define OCIE5B 2
+#define OCF5A 1
+#define OCF5B 2
+
+// Registres des timers.
+extern volatile uint8_t TCCR0A;
+extern volatile uint8_t TCCR0B;
+extern volatile uint8_t OCR0A;
+extern volatile uint8_t OCR0B;
+extern volatile uint8_t TCCR1A;
+extern volatile uint16_t OCR1A;
+extern volatile uint16_t OCR1B;
+extern volatile uint16_t OCR1C;
+extern volatile uint8_t TCCR2A;
+extern volatile uint8_t OCR2A;
+extern volatile uint8_t OCR2B;
+extern volatile uint8_t TCCR3A;
+extern volatile uint16_t OCR3A;
+extern volatile uint16_t OCR3B;
+extern volatile uint16_t OCR3C;
+extern volatile uint8_t TIMSK3;
+extern volatile uint8_t TCCR4A;
+extern volatile uint8_t TCCR4B;
+extern volatile uint16_t OCR4A;
+extern volatile uint16_t OCR4B;
+extern volatile uint16_t OCR4C;
+extern volatile uint16_t ICR4;
+extern volatile uint8_t TCCR5A;
+extern volatile uint8_t TCCR5B;
+extern volatile uint16_t TCNT5;
+extern volatile uint16_t OCR5A;
+extern volatile uint16_t OCR5B;
+extern volatile uint16_t OCR5C;
+extern volatile uint8_t TIMSK5;
+extern volatile uint8_t TIFR5;
+
+// Bits des registres du convertisseur analogique-numérique.
+#define ADEN 7
+#define ADSC 6
+#define ADATE 5
+#define ADIF 4
+#define ADIE 3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+#define REFS0 6
+#define MUX5 3
+
+// Registres du convertisseur analogique-numérique.
+extern volatile uint8_t ADCSRA;
+extern volatile uint8_t ADCSRB;
+extern volatile uint8_t ADMUX;
+extern volatile uint16_t ADC;
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef ARDUINO_NATIVE_PGMSPACE_DEFINITIONS
+#define ARDUINO_NATIVE_PGMSPACE_DEFINITIONS
+
+// Sur l'ordinateur, les données « en mémoire flash » sont des variables ordinaires : les fonctions de lecture sont de simples accès.
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(text) (text)
+
+#define pgm_read_byte(address) (*reinterpret_cast<const uint8_t *>(address))
+#define pgm_read_word(address) (*reinterpret_cast<const uint16_t *>(address))
+#define pgm_read_dword(address) (*reinterpret_cast<const uint32_t *>(address))
+#define pgm_read_ptr(address) (*reinterpret_cast<void *const *>(address))
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+
+#endif
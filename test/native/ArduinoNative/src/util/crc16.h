@@ -0,0 +1,15 @@
+#ifndef ARDUINO_NATIVE_CRC16_DEFINITIONS
+#define ARDUINO_NATIVE_CRC16_DEFINITIONS
+
+#include <stdint.h>
+
+/// @brief Équivalent en C de la fonction `_crc_ccitt_update()` d'avr-libc (CRC-16 CCITT, polynôme 0x1021, bits réfléchis).
+static inline uint16_t _crc_ccitt_update(uint16_t crc, uint8_t data)
+{
+    data ^= uint8_t(crc & 0xFF);
+    data ^= uint8_t(data << 4);
+
+    return ((uint16_t(data) << 8) | (crc >> 8)) ^ uint8_t(data >> 4) ^ (uint16_t(data) << 3);
+}
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef HOME_ASSISTANT_NATIVE_DEFINITIONS
+#define HOME_ASSISTANT_NATIVE_DEFINITIONS
+
+// Faux `HomeAssistant` des tests sur l'ordinateur : `HomeAssistant.cpp` dépend de tout le système (alarme, plateau, bibliothèques des lecteurs de cartes...) et n'est pas compilé dans l'environnement `native`.
+// Les méthodes sont définies dans cet en-tête, qui doit être inclus par un seul fichier de chaque test.
+
+// Ajout des bibliothèques au programme.
+#include <Arduino.h>
+
+// Autres fichiers du programme.
+#include "device/interface/HomeAssistant.hpp"
+
+/// @brief Nombre de messages de chaque type qui auraient été envoyés à l'ESP.
+struct HomeAssistantMessages
+{
+    unsigned long availabilityUpdates;
+    unsigned long stateUpdates;
+    unsigned long stripModeUpdates;
+    unsigned long volumeUpdates;
+    unsigned long remoteCommands;
+    unsigned long videos;
+    unsigned long musicRequests;
+    unsigned long total;
+};
+
+HomeAssistantMessages sentMessages = {};
+
+/// @brief Compte un message envoyé à l'ESP.
+/// @param counter Le compteur du type du message.
+static void countMessage(unsigned long &counter)
+{
+    counter++;
+    sentMessages.total++;
+}
+
+HomeAssistant::HomeAssistant(const __FlashStringHelper *friendlyName, unsigned int ID, HardwareSerial &serial, Display &display) : Device(friendlyName, ID), m_serial(serial), m_display(display), m_deviceList(nullptr), m_devicesNumber(0), m_inputDeviceList(nullptr), m_inputDevicesNumber(0), m_remoteDeviceList(nullptr), m_remoteDevicesNumber(0), m_colorModeList(nullptr), m_rainbowModeList(nullptr), m_soundreactModeList(nullptr), m_alarmModeList(nullptr), m_spectrumModeList(nullptr), m_RGBLEDStripModesNumber(0), m_initialisationFinishTime(0) {}
+
+void HomeAssistant::setDevices(Output *deviceList[], int &devicesNumber, Input *inputDeviceList[], int &inputDevicesNumber, ConnectedOutput *remoteDeviceList[], int &remoteDevicesNumber, RGBLEDStripMode *colorModeList[], RGBLEDStripMode *rainbowModeList[], RGBLEDStripMode *soundreactModeList[], RGBLEDStripMode *alarmModeList[], RGBLEDStripMode *spectrumModeList[], int &RGBLEDStripModesNumber) {}
+
+void HomeAssistant::setup()
+{
+    m_operational = true;
+}
+
+void HomeAssistant::loop() {}
+
+void HomeAssistant::turnOnConnectedDevice(unsigned int ID)
+{
+    countMessage(sentMessages.remoteCommands);
+}
+
+void HomeAssistant::turnOffConnectedDevice(unsigned int ID)
+{
+    countMessage(sentMessages.remoteCommands);
+}
+
+void HomeAssistant::toggleConnectedDevice(unsigned int ID)
+{
+    countMessage(sentMessages.remoteCommands);
+}
+
+void HomeAssistant::setConnectedTemperatureVariableLightTemperature(unsigned int ID, int temperature)
+{
+    countMessage(sentMessages.remoteCommands);
+}
+
+void HomeAssistant::setConnectedTemperatureVariableLightLuminosity(unsigned int ID, int luminosity)
+{
+    countMessage(sentMessages.remoteCommands);
+}
+
+void HomeAssistant::setConnectedColorVariableLightColor(unsigned int ID, int r, int g, int b)
+{
+    countMessage(sentMessages.remoteCommands);
+}
+
+void HomeAssistant::setConnectedColorVariableLightTemperature(unsigned int ID, int temperature)
+{
+    countMessage(sentMessages.remoteCommands);
+}
+
+void HomeAssistant::setConnectedColorVariableLightLuminosity(unsigned int ID, int luminosity)
+{
+    countMessage(sentMessages.remoteCommands);
+}
+
+void HomeAssistant::updateDeviceAvailability(unsigned int ID, bool availability)
+{
+    countMessage(sentMessages.availabilityUpdates);
+}
+
+void HomeAssistant::updateOutputDeviceState(unsigned int ID, bool state)
+{
+    countMessage(sentMessages.stateUpdates);
+}
+
+void HomeAssistant::updateRGBLEDStripMode(unsigned int ID, int mode, int r, int g, int b)
+{
+    countMessage(sentMessages.stripModeUpdates);
+}
+
+void HomeAssistant::updateAlarmTriggeredState(unsigned int ID, bool state)
+{
+    countMessage(sentMessages.stateUpdates);
+}
+
+void HomeAssistant::updateAlarmMissileLauncherBaseAngle(unsigned int ID, int angle)
+{
+    countMessage(sentMessages.stateUpdates);
+}
+
+void HomeAssistant::updateAlarmMissileLauncherAngleAngle(unsigned int ID, int angle)
+{
+    countMessage(sentMessages.stateUpdates);
+}
+
+void HomeAssistant::updateAlarmMissileLauncherMissilesState(unsigned int ID, bool firstMissile, bool secondMissile, bool thirdMissile)
+{
+    countMessage(sentMessages.stateUpdates);
+}
+
+void HomeAssistant::updateTelevisionVolume(unsigned int ID, int mode, int volume)
+{
+    countMessage(sentMessages.volumeUpdates);
+}
+
+void HomeAssistant::updateBinaryInput(unsigned int ID, bool state)
+{
+    countMessage(sentMessages.stateUpdates);
+}
+
+void HomeAssistant::updateAnalogInput(unsigned int ID, int state)
+{
+    countMessage(sentMessages.stateUpdates);
+}
+
+void HomeAssistant::updateAirSensor(unsigned int ID, float temperature, float humidity)
+{
+    countMessage(sentMessages.stateUpdates);
+}
+
+void HomeAssistant::sayMessage(String message)
+{
+    countMessage(sentMessages.remoteCommands);
+}
+
+void HomeAssistant::playVideo(String videoURL)
+{
+    countMessage(sentMessages.videos);
+}
+
+void HomeAssistant::requestMusicActions(unsigned int ID, unsigned int streamNumber, unsigned int firstIndex, unsigned int actionsNumber)
+{
+    countMessage(sentMessages.musicRequests);
+}
+
+void HomeAssistant::stopSystem(bool restart) {}
+
+void HomeAssistant::processMessage() {}
+
+Output *HomeAssistant::getDeviceFromID(unsigned int ID)
+{
+    return nullptr;
+}
+
+ConnectedOutput *HomeAssistant::getRemoteDeviceFromID(unsigned int ID)
+{
+    return nullptr;
+}
+
+RGBLEDStripMode *HomeAssistant::getRGBLEDStripModeFromID(unsigned int ID, RGBLEDStripMode **list)
+{
+    return nullptr;
+}
+
+#endif
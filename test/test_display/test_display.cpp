@@ -0,0 +1,500 @@
+/**
+ * @file test/test_display/test_display.cpp
+ * @brief Tests de l'écran sur l'ordinateur (`pio test -e native` et `pio test -e native_page`) : chaque méthode `Display::display*()` est affichée sur l'écran simulé, et l'image obtenue est comparée à une image de référence du répertoire `golden`. Les deux modes d'affichage partagent les mêmes images. Un tableau des coûts de chaque écran (durée de dessin et d'envoi sur l'ordinateur, pixels dessinés, octets envoyés) est affiché à la fin.
+ *
+ * Pour régénérer les images de référence après une modification volontaire d'un écran : `UPDATE_GOLDEN=1 pio test -e native`. Une image différente de sa référence est enregistrée à côté d'elle (`<nom>.actual.pbm`).
+ */
+
+// Ajout des bibliothèques au programme.
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <SSD1306Simulator.h>
+
+// Autres fichiers du programme.
+#include "device/device.hpp"
+#include "device/interface/display.hpp"
+#include "utils/musicActions.hpp"
+
+// Répertoire des images de référence, relatif au répertoire du projet (d'où `pio test` lance le programme).
+#ifndef GOLDEN_DIRECTORY
+#define GOLDEN_DIRECTORY "test/test_display/golden"
+#endif
+
+// Taille d'une image de l'écran (8 pages de 128 colonnes).
+#define IMAGE_SIZE (SSD1306_SIMULATOR_PAGES * SSD1306_SIMULATOR_WIDTH)
+
+// Nombre maximal d'écrans mesurés.
+#define BENCHMARKS_NUMBER 48
+
+/// @brief Écran donnant accès à son affichage, pour comparer la mémoire tampon à l'écran simulé et terminer les envois.
+class DisplayProbe : public Display
+{
+public:
+    using Display::Display;
+
+    DisplayBackend &getBackend()
+    {
+        return m_display;
+    }
+};
+
+/// @brief Périphérique dont la disponibilité est choisie par le test (pour `displayUnavailableDevices()`).
+class TestDevice : public Device
+{
+public:
+    TestDevice(const __FlashStringHelper *friendlyName, unsigned int ID, bool operational) : Device(friendlyName, ID)
+    {
+        m_operational = operational;
+    }
+
+    void setup() override {}
+};
+
+/// @brief Mesures d'un écran.
+struct Benchmark
+{
+    const char *name;
+    unsigned long drawTime;
+    unsigned long flushTime;
+    unsigned long pixelOperations;
+    unsigned long transferredBytes;
+    unsigned long transactions;
+};
+
+static DisplayProbe display(F("Écran"), 0);
+static Benchmark benchmarks[BENCHMARKS_NUMBER];
+static unsigned int benchmarksNumber = 0;
+
+// Compteurs relevés au début de l'écran mesuré.
+static unsigned long startPixelOperations;
+static unsigned long startTransferredBytes;
+static unsigned long startReceivedBytes;
+static unsigned long startTransactions;
+static std::chrono::steady_clock::time_point startTime;
+
+// Nombre de dessins ignorés avant l'écran vérifié.
+static unsigned long startDroppedDrawings;
+
+// Musiques de test, stockées comme celles de la télévision.
+static const char firstMusicName[] PROGMEM = "Au clair de la lune";
+static const char secondMusicName[] PROGMEM = "Frère Jacques";
+static const char thirdMusicName[] PROGMEM = "Il était une bergère";
+static const Music firstMusic PROGMEM = {firstMusicName, nullptr, nullptr, 0, 1};
+static const Music secondMusic PROGMEM = {secondMusicName, nullptr, nullptr, 0, 2};
+static const Music thirdMusic PROGMEM = {thirdMusicName, nullptr, nullptr, 0, 3};
+static const Music *const musicsList[] PROGMEM = {&firstMusic, &secondMusic, &thirdMusic};
+
+// Aides des menus de test : la première tient sur une page, la seconde sur deux.
+static const __FlashStringHelper *shortHelpList[] = {F("Allumer"), F("Éteindre"), F("Basculer"), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+static const __FlashStringHelper *longHelpList[] = {F("Allumer"), F("Éteindre"), F("Basculer"), F("Précédent"), F("Suivant"), F("Plus"), F("Moins"), F("Muet"), F("Entrée"), F("Retour")};
+
+/// @brief Termine l'envoi en cours en faisant tourner la boucle de l'écran (le temps simulé est figé : chaque appel envoie tout ce qui peut l'être).
+static void flush()
+{
+    while (display.getBackend().isFlushPending())
+        display.loop();
+}
+
+/// @brief Remet l'écran au repos : les durées d'affichage minimales sont écoulées, l'écran en cours et l'animation sont terminés et l'écran est éteint.
+static void prepare()
+{
+    for (int i = 0; i < 2; i++)
+    {
+        advanceTime(20000);
+        display.loop();
+        flush();
+    }
+
+    startDroppedDrawings = display.getDroppedDrawings();
+}
+
+/// @brief Commence la mesure d'un écran.
+static void startBenchmark()
+{
+    startPixelOperations = gfxPixelOperations;
+    startTransferredBytes = display.getTransferredBytes();
+    startReceivedBytes = simulatedScreen.getReceivedBytes();
+    startTransactions = simulatedScreen.getTransactions();
+    startTime = std::chrono::steady_clock::now();
+}
+
+/// @brief Termine la mesure d'un écran : l'envoi est terminé, et les octets comptés par l'écran sont comparés à ceux reçus par l'écran simulé.
+/// @param name Le nom de l'écran.
+static void stopBenchmark(const char *name)
+{
+    std::chrono::steady_clock::time_point drawEnd = std::chrono::steady_clock::now();
+    flush();
+    std::chrono::steady_clock::time_point flushEnd = std::chrono::steady_clock::now();
+
+    unsigned long transferredBytes = display.getTransferredBytes() - startTransferredBytes;
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(simulatedScreen.getReceivedBytes() - startReceivedBytes, transferredBytes, name);
+
+    if (benchmarksNumber >= BENCHMARKS_NUMBER)
+        return;
+
+    Benchmark &benchmark = benchmarks[benchmarksNumber++];
+    benchmark.name = name;
+    benchmark.drawTime = std::chrono::duration_cast<std::chrono::microseconds>(drawEnd - startTime).count();
+    benchmark.flushTime = std::chrono::duration_cast<std::chrono::microseconds>(flushEnd - drawEnd).count();
+    benchmark.pixelOperations = gfxPixelOperations - startPixelOperations;
+    benchmark.transferredBytes = transferredBytes;
+    benchmark.transactions = simulatedScreen.getTransactions() - startTransactions;
+}
+
+/// @brief Enregistre une image au format PBM binaire (P4), comme `tools/packbits.py` : un bit à 1 est un pixel allumé, le bit de poids fort à gauche.
+/// @return `false` si le fichier n'a pas pu être écrit.
+static bool writePBM(const char *path, const uint8_t image[IMAGE_SIZE])
+{
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr)
+        return false;
+
+    fprintf(file, "P4\n%d %d\n", SSD1306_SIMULATOR_WIDTH, SSD1306_SIMULATOR_HEIGHT);
+
+    for (int y = 0; y < SSD1306_SIMULATOR_HEIGHT; y++)
+    {
+        uint8_t row[SSD1306_SIMULATOR_WIDTH / 8] = {};
+
+        for (int x = 0; x < SSD1306_SIMULATOR_WIDTH; x++)
+        {
+            if (image[(y / 8) * SSD1306_SIMULATOR_WIDTH + x] & (1 << (y % 8)))
+                row[x / 8] |= 0x80 >> (x % 8);
+        }
+
+        fwrite(row, 1, sizeof(row), file);
+    }
+
+    return fclose(file) == 0;
+}
+
+/// @brief Lit une image au format PBM binaire (P4) de la taille de l'écran.
+/// @return `false` si le fichier n'existe pas ou n'a pas le bon format.
+static bool readPBM(const char *path, uint8_t image[IMAGE_SIZE])
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr)
+        return false;
+
+    int width = 0;
+    int height = 0;
+    bool valid = fscanf(file, "P4 %d %d", &width, &height) == 2 && fgetc(file) != EOF && width == SSD1306_SIMULATOR_WIDTH && height == SSD1306_SIMULATOR_HEIGHT;
+
+    memset(image, 0, IMAGE_SIZE);
+
+    for (int y = 0; valid && y < SSD1306_SIMULATOR_HEIGHT; y++)
+    {
+        uint8_t row[SSD1306_SIMULATOR_WIDTH / 8];
+        valid = fread(row, 1, sizeof(row), file) == sizeof(row);
+
+        for (int x = 0; valid && x < SSD1306_SIMULATOR_WIDTH; x++)
+        {
+            if (row[x / 8] & (0x80 >> (x % 8)))
+                image[(y / 8) * SSD1306_SIMULATOR_WIDTH + x] |= 1 << (y % 8);
+        }
+    }
+
+    fclose(file);
+    return valid;
+}
+
+/// @brief Compare l'image affichée par l'écran simulé à son image de référence. Avec la variable d'environnement `UPDATE_GOLDEN`, l'image de référence est remplacée.
+/// @param name Le nom de l'image de référence (sans extension).
+static void assertGolden(const char *name)
+{
+    uint8_t image[IMAGE_SIZE];
+    simulatedScreen.getImage(image);
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.pbm", GOLDEN_DIRECTORY, name);
+
+    if (getenv("UPDATE_GOLDEN") != nullptr)
+    {
+        TEST_ASSERT_TRUE_MESSAGE(writePBM(path, image), path);
+        return;
+    }
+
+    uint8_t golden[IMAGE_SIZE];
+    if (!readPBM(path, golden))
+        TEST_FAIL_MESSAGE(path);
+
+    if (memcmp(image, golden, IMAGE_SIZE) == 0)
+        return;
+
+    char actualPath[256];
+    snprintf(actualPath, sizeof(actualPath), "%s/%s.actual.pbm", GOLDEN_DIRECTORY, name);
+    writePBM(actualPath, image);
+    TEST_FAIL_MESSAGE(actualPath);
+}
+
+/// @brief Vérifie l'écran affiché : l'écran simulé est allumé, montre la mémoire tampon (en mode partiel), et l'image correspond à sa référence.
+/// @param name Le nom de l'image de référence (sans extension).
+static void assertScreen(const char *name)
+{
+    TEST_ASSERT_TRUE(simulatedScreen.isOn());
+    TEST_ASSERT_EQUAL_UINT32(startDroppedDrawings, display.getDroppedDrawings());
+    TEST_ASSERT_EQUAL_INT(0, Wire.getWriteError());
+
+#if !DISPLAY_PAGE_MODE
+    // Les envois partiels et le défilement matériel doivent reproduire exactement la mémoire tampon.
+    const uint8_t *buffer = display.getBackend().getBuffer();
+    for (int16_t y = 0; y < SSD1306_SIMULATOR_HEIGHT; y++)
+    {
+        for (int16_t x = 0; x < SSD1306_SIMULATOR_WIDTH; x++)
+        {
+            bool lit = buffer[(y / 8) * SSD1306_SIMULATOR_WIDTH + x] & (1 << (y % 8));
+            TEST_ASSERT_EQUAL_MESSAGE(lit != simulatedScreen.isInverted(), simulatedScreen.getPixel(x, y), name);
+        }
+    }
+#endif
+
+    assertGolden(name);
+}
+
+/// @brief Affiche et vérifie un écran dessiné immédiatement par sa méthode.
+#define CHECK_SCREEN(name, call) \
+    do                           \
+    {                            \
+        prepare();               \
+        startBenchmark();        \
+        call;                    \
+        stopBenchmark(name);     \
+        assertScreen(name);      \
+    } while (0)
+
+void setUp()
+{
+    Wire.clearWriteError();
+}
+
+void tearDown()
+{
+}
+
+void test_message()
+{
+    CHECK_SCREEN("message", display.displayMessage("Porte ouverte"));
+    CHECK_SCREEN("message_title", display.displayMessage("Température trop élevée dans la chambre", "Alerte"));
+}
+
+void test_message_marquee()
+{
+    prepare();
+    // Le message (155 caractères et le titre) tient dans la liste de caractères de l'affichage page par page, et défile de deux lignes.
+    display.displayMessage("Ce message est trop long pour tenir sur l'écran : il défile ligne par ligne, et le titre reste fixe en haut de l'écran pendant tout le défilement du texte.", "Défilement");
+    flush();
+    assertScreen("marquee_0");
+
+    const char *names[] = {"marquee_1", "marquee_2"};
+    for (int i = 0; i < 2; i++)
+    {
+        advanceTime(DISPLAY_MARQUEE_PERIOD);
+        startBenchmark();
+        display.loop();
+        stopBenchmark(names[i]);
+        assertScreen(names[i]);
+    }
+}
+
+void test_bell()
+{
+    CHECK_SCREEN("bell", display.displayBell());
+}
+
+void test_alarm_triggered()
+{
+    CHECK_SCREEN("alarm_triggered", display.displayAlarmTriggered(false));
+    CHECK_SCREEN("alarm_triggered_inverted", display.displayAlarmTriggered(true));
+    TEST_ASSERT_TRUE(simulatedScreen.isInverted());
+}
+
+void test_volume()
+{
+    CHECK_SCREEN("volume_increase", display.displayVolume(INCREASE, 18));
+    CHECK_SCREEN("volume_decrease", display.displayVolume(DECREASE, 7));
+    CHECK_SCREEN("volume_mute", display.displayVolume(MUTE));
+    CHECK_SCREEN("volume_unmute", display.displayVolume(UNMUTE, 12));
+}
+
+void test_sensors()
+{
+    CHECK_SCREEN("air_values", display.displayAirValues(21.5, 48.2));
+    CHECK_SCREEN("analog_sensor", display.displayAnalogSensorValue(742));
+    CHECK_SCREEN("binary_sensor", display.displayBinarySensorValue(true));
+}
+
+void test_lights()
+{
+    CHECK_SCREEN("led_state", display.displayLEDState(255, 128, 0));
+    CHECK_SCREEN("light_color_temperature", display.displayLightColorTemperature(2700, 6500, 4000));
+    CHECK_SCREEN("luminosity", display.displayLuminosity(191));
+    CHECK_SCREEN("percentage", display.displayPercentage("Humidité", 65));
+}
+
+void test_keypad_menu()
+{
+    CHECK_SCREEN("menu_outputs", display.displayKeypadMenu(OUTPUTS, F("Périphériques")));
+    CHECK_SCREEN("menu_lights", display.displayKeypadMenu(LIGHTS, F("Lumières")));
+    CHECK_SCREEN("menu_televisions", display.displayKeypadMenu(TELEVISIONS, F("Télévision")));
+    CHECK_SCREEN("menu_alarms", display.displayKeypadMenu(ALARMS, F("Alarme")));
+    CHECK_SCREEN("menu_inputs", display.displayKeypadMenu(INPUTS, F("Capteurs")));
+    CHECK_SCREEN("menu_controls", display.displayKeypadMenu(CONTROLS, F("Contrôle")));
+}
+
+void test_keypad_menu_help()
+{
+    CHECK_SCREEN("menu_help_short", display.displayKeypadMenuHelp(shortHelpList, F("Sortie")));
+
+    // Les deux pages de l'aide s'alternent lorsque la même aide est demandée à nouveau.
+    CHECK_SCREEN("menu_help_page_1", display.displayKeypadMenuHelp(longHelpList, F("Télévision")));
+    startBenchmark();
+    display.displayKeypadMenuHelp(longHelpList, F("Télévision"));
+    stopBenchmark("menu_help_page_2");
+    assertScreen("menu_help_page_2");
+}
+
+void test_device_state()
+{
+    const char *names[][2] = {{"device_off_start", "device_off_end"}, {"device_on_start", "device_on_end"}};
+
+    for (int on = 0; on < 2; on++)
+    {
+        prepare();
+        display.displayDeviceState(on);
+
+        // La première image est dessinée au premier passage dans la boucle, la dernière à la fin de l'animation.
+        startBenchmark();
+        display.loop();
+        stopBenchmark(names[on][0]);
+        assertScreen(names[on][0]);
+
+        advanceTime(DISPLAY_DEVICE_STATE_ANIMATION_DURATION);
+        startBenchmark();
+        display.loop();
+        stopBenchmark(names[on][1]);
+        assertScreen(names[on][1]);
+    }
+}
+
+void test_tray()
+{
+    const char *names[][2] = {{"tray_closing_start", "tray_closing_end"}, {"tray_opening_start", "tray_opening_end"}};
+
+    for (int opening = 0; opening < 2; opening++)
+    {
+        prepare();
+        display.displayTray(opening, 2000);
+
+        startBenchmark();
+        display.loop();
+        stopBenchmark(names[opening][0]);
+        assertScreen(names[opening][0]);
+
+        advanceTime(2000);
+        startBenchmark();
+        display.loop();
+        stopBenchmark(names[opening][1]);
+        assertScreen(names[opening][1]);
+    }
+}
+
+void test_selected_music()
+{
+    CHECK_SCREEN("music_first", display.displaySelectedMusic(musicsList, 3, 0));
+    CHECK_SCREEN("music_middle", display.displaySelectedMusic(musicsList, 3, 1));
+    CHECK_SCREEN("music_last", display.displaySelectedMusic(musicsList, 3, 2));
+}
+
+void test_unavailable_devices()
+{
+    TestDevice lamp(F("Lampe"), 1, true);
+    TestDevice sensor(F("Détecteur de présence"), 2, false);
+    TestDevice television(F("Télévision"), 3, false);
+
+    Device *availableDevices[] = {&lamp};
+    int availableDevicesNumber = 1;
+    CHECK_SCREEN("unavailable_devices_none", display.displayUnavailableDevices(availableDevices, availableDevicesNumber));
+
+    Device *devices[] = {&lamp, &sensor, &television};
+    int devicesNumber = 3;
+    CHECK_SCREEN("unavailable_devices", display.displayUnavailableDevices(devices, devicesNumber));
+}
+
+void test_partial_update()
+{
+    // Un écran qui ne change qu'une valeur n'envoie que les blocs modifiés, bien moins qu'un écran complet (1024 octets de données).
+    prepare();
+    display.displayVolume(UNMUTE, 12);
+    flush();
+
+    unsigned long transferredBytes = display.getTransferredBytes();
+    startBenchmark();
+    display.displayVolume(UNMUTE, 13);
+    stopBenchmark("volume_update");
+    assertScreen("volume_update");
+    TEST_ASSERT_LESS_THAN_UINT32(256, display.getTransferredBytes() - transferredBytes);
+
+    // Un écran identique n'est ni redessiné ni envoyé.
+    transferredBytes = display.getTransferredBytes();
+    display.displayVolume(UNMUTE, 13);
+    flush();
+    TEST_ASSERT_EQUAL_UINT32(transferredBytes, display.getTransferredBytes());
+}
+
+void test_blank()
+{
+    // L'écran est effacé 15 secondes après le dernier affichage.
+    prepare();
+    display.displayBell();
+    flush();
+    advanceTime(15000);
+    display.loop();
+    flush();
+    assertScreen("blank");
+}
+
+/// @brief Affiche le tableau des mesures. La durée d'envoi sur la carte est estimée pour un bus à 400 kHz : 9 bits par octet, plus l'adresse de chaque transaction. En mode page par page, l'envoi est compris dans la durée de dessin.
+static void printBenchmarks()
+{
+    printf("\n%-28s %10s %10s %10s %8s %8s %10s\n", "Écran", "Dessin µs", "Envoi µs", "Pixels", "Octets", "Trans.", "I2C µs");
+
+    for (unsigned int i = 0; i < benchmarksNumber; i++)
+    {
+        const Benchmark &benchmark = benchmarks[i];
+        unsigned long busTime = ((benchmark.transferredBytes + benchmark.transactions) * 9 * 10) / 4;
+        printf("%-28s %10lu %10lu %10lu %8lu %8lu %10lu\n", benchmark.name, benchmark.drawTime, benchmark.flushTime, benchmark.pixelOperations, benchmark.transferredBytes, benchmark.transactions, busTime);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // Le temps simulé commence après le démarrage, comme sur la carte (`millis()` vaut 0 pour un écran jamais affiché).
+    advanceTime(1000);
+    display.setup();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_message);
+    RUN_TEST(test_message_marquee);
+    RUN_TEST(test_bell);
+    RUN_TEST(test_alarm_triggered);
+    RUN_TEST(test_volume);
+    RUN_TEST(test_sensors);
+    RUN_TEST(test_lights);
+    RUN_TEST(test_keypad_menu);
+    RUN_TEST(test_keypad_menu_help);
+    RUN_TEST(test_device_state);
+    RUN_TEST(test_tray);
+    RUN_TEST(test_selected_music);
+    RUN_TEST(test_unavailable_devices);
+    RUN_TEST(test_partial_update);
+    RUN_TEST(test_blank);
+    int result = UNITY_END();
+
+    printBenchmarks();
+    return result;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file test/test_microphone/test_microphone.cpp
+ * @brief Tests du microphone sur l'ordinateur (`pio test -e native`) : démarrage et arrêt de l'échantillonnage par les utilisateurs, interruption limitée à l'écriture du tampon et suivi d'enveloppe dans la boucle. Un tableau des mesures (durée sur l'ordinateur et estimation du nombre de cycles sur l'ATmega2560 à 16 MHz) est affiché à la fin.
+ */
+
+// Ajout des bibliothèques au programme.
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+#include <Arduino.h>
+#include <HomeAssistantNative.h>
+
+// Autres fichiers du programme.
+#include "pinDefinitions.hpp"
+#include "device/interface/display.hpp"
+#include "device/interface/HomeAssistant.hpp"
+#include "device/input/analogInput.hpp"
+
+// Nombre maximal de mesures.
+#define BENCHMARKS_NUMBER 16
+
+// Routine d'interruption du convertisseur analogique-numérique (une fonction ordinaire sur l'ordinateur, voir `avr/interrupt.h`).
+extern "C" void ADC_vect();
+
+/// @brief Mesure d'une opération : durée moyenne d'un appel sur l'ordinateur et estimation sur la carte.
+struct Benchmark
+{
+    const char *name;
+    unsigned long calls;
+    double hostTime;
+    unsigned long AVRCycles;
+};
+
+static Display display(F("Écran"), 0);
+static HomeAssistant connection(F("Home Assistant"), 0, Serial, display);
+static Microphone microphone(F("Microphone"), 1, connection, PIN_MICROPHONE, false);
+static Benchmark benchmarks[BENCHMARKS_NUMBER];
+static unsigned int benchmarksNumber = 0;
+
+/// @brief Enregistre une mesure.
+/// @param name Le nom de l'opération.
+/// @param calls Le nombre d'appels mesurés.
+/// @param startTime Le début de la mesure.
+/// @param AVRCycles Le nombre de cycles estimé d'un appel sur l'ATmega2560 (voir le test de l'opération).
+static void addBenchmark(const char *name, unsigned long calls, std::chrono::steady_clock::time_point startTime, unsigned long AVRCycles)
+{
+    std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+    if (benchmarksNumber >= BENCHMARKS_NUMBER)
+        return;
+
+    Benchmark &benchmark = benchmarks[benchmarksNumber++];
+    benchmark.name = name;
+    benchmark.calls = calls;
+    benchmark.hostTime = std::chrono::duration<double, std::nano>(endTime - startTime).count() / calls;
+    benchmark.AVRCycles = AVRCycles;
+}
+
+/// @brief Simule une conversion du convertisseur.
+/// @param sample L'échantillon brut, de `0` à `1023`.
+static void convert(unsigned int sample)
+{
+    ADC = sample;
+    ADC_vect();
+}
+
+/// @brief Échantillon d'un son pur centré sur 512.
+/// @param index L'indice de l'échantillon.
+/// @param amplitude L'amplitude du son.
+/// @return L'échantillon brut.
+static unsigned int tone(unsigned long index, unsigned int amplitude)
+{
+    return 512 + lround(amplitude * sin(2 * M_PI * 440.0 * index / MICROPHONE_SAMPLE_RATE));
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+/// @brief Le convertisseur ne fonctionne en continu qu'entre la première demande d'échantillonnage et la dernière libération.
+void test_sampling_consumers()
+{
+    TEST_ASSERT_TRUE(!(ADCSRA & _BV(ADATE)));
+    TEST_ASSERT_TRUE(!microphone.isSampling());
+
+    microphone.startSampling();
+    TEST_ASSERT_TRUE(ADCSRA & _BV(ADATE));
+    TEST_ASSERT_TRUE(ADCSRA & _BV(ADIE));
+
+    microphone.startSampling();
+    microphone.stopSampling();
+    TEST_ASSERT_TRUE(ADCSRA & _BV(ADATE));
+
+    microphone.stopSampling();
+    TEST_ASSERT_TRUE(!(ADCSRA & _BV(ADATE)));
+    TEST_ASSERT_TRUE(!(ADCSRA & _BV(ADIE)));
+
+    // Une libération de trop ne fait pas repartir le compteur à l'envers.
+    microphone.stopSampling();
+    microphone.startSampling();
+    TEST_ASSERT_TRUE(ADCSRA & _BV(ADATE));
+    microphone.stopSampling();
+    TEST_ASSERT_TRUE(!microphone.isSampling());
+}
+
+/// @brief L'interruption écrit seulement le tampon : l'enveloppe ne change qu'au passage dans la boucle, puis suit l'amplitude du son.
+void test_envelope_in_loop()
+{
+    microphone.startSampling();
+    unsigned int position = microphone.getSamplePosition();
+
+    for (unsigned long i = 0; i < 64; i++)
+        convert(tone(i, 200));
+
+    TEST_ASSERT_EQUAL_UINT32(0, microphone.getEnvelope());
+
+    // Boucle appelée toutes les 64 conversions (environ 7 ms).
+    for (unsigned long i = 64; i < 9600; i++)
+    {
+        convert(tone(i, 200));
+
+        if ((i % 64) == 0)
+            microphone.loop();
+    }
+
+    microphone.loop();
+
+    TEST_ASSERT_TRUE(microphone.getEnvelope() >= 150 && microphone.getEnvelope() <= 200);
+    TEST_ASSERT_TRUE(microphone.getAverageLevel() >= 100 && microphone.getAverageLevel() <= 200);
+    TEST_ASSERT_EQUAL_UINT32(tone(9599, 200), microphone.getValue());
+
+    // Les échantillons lus sont centrés sur zéro par la composante continue calculée dans la boucle.
+    int samples[MICROPHONE_BUFFER_SIZE];
+    unsigned int samplesNumber = microphone.readSamples(samples, MICROPHONE_BUFFER_SIZE, position);
+    TEST_ASSERT_EQUAL_UINT32(MICROPHONE_BUFFER_SIZE, samplesNumber);
+
+    for (unsigned int i = 0; i < samplesNumber; i++)
+        TEST_ASSERT_TRUE(abs(samples[i] - (int(tone(9600 - MICROPHONE_BUFFER_SIZE + i, 200)) - 512)) <= 2);
+
+    microphone.stopSampling();
+}
+
+/// @brief Mesure l'interruption du convertisseur, exécutée à 9615 Hz tant que l'échantillonnage est actif.
+/// Estimation sur l'ATmega2560 : environ 40 cycles d'entrée et de sortie, 5 cycles pour le test du microphone et 15 cycles d'écriture du tampon et de l'indice, soit 60 cycles (3,6 % du processeur pendant l'échantillonnage, 0 % sinon). Avec la composante continue, l'enveloppe et le niveau moyen sur 32 bit, l'ancienne interruption coûtait environ 230 cycles (14 % du processeur en permanence).
+void test_interrupt_benchmark()
+{
+    microphone.startSampling();
+
+    unsigned long calls = 1000000;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    for (unsigned long i = 0; i < calls; i++)
+        convert(512 + (i & 0xFF));
+
+    addBenchmark("Interruption du convertisseur", calls, startTime, 60);
+
+    microphone.stopSampling();
+}
+
+/// @brief Mesure le suivi d'enveloppe dans la boucle, par échantillon, pour des passages toutes les 64 conversions.
+/// Estimation sur l'ATmega2560 : environ 160 cycles par échantillon (composante continue, enveloppe et niveau moyen sur 32 bit), exécutés seulement pendant l'échantillonnage.
+void test_levels_benchmark()
+{
+    microphone.startSampling();
+
+    unsigned long calls = 0;
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::duration::zero();
+
+    for (unsigned long block = 0; block < 20000; block++)
+    {
+        for (unsigned long i = 0; i < 64; i++)
+            convert(tone((block * 64) + i, 300));
+
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        microphone.loop();
+        time += std::chrono::steady_clock::now() - startTime;
+        calls += 64;
+    }
+
+    addBenchmark("Enveloppe (par échantillon)", calls, std::chrono::steady_clock::now() - time, 160);
+
+    TEST_ASSERT_TRUE(microphone.getEnvelope() >= 250 && microphone.getEnvelope() <= 300);
+
+    microphone.stopSampling();
+}
+
+/// @brief Affiche le tableau des mesures. La durée sur la carte est déduite du nombre de cycles estimé, à 16 MHz.
+static void printBenchmarks()
+{
+    printf("\n%-32s %10s %12s %12s %10s\n", "Mesure", "Appels", "ns (PC)", "Cycles AVR", "µs AVR");
+
+    for (unsigned int i = 0; i < benchmarksNumber; i++)
+    {
+        const Benchmark &benchmark = benchmarks[i];
+        printf("%-32s %10lu %12.1f %12lu %10.1f\n", benchmark.name, benchmark.calls, benchmark.hostTime, benchmark.AVRCycles, benchmark.AVRCycles / 16.0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    advanceTime(1000);
+    microphone.setup();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_sampling_consumers);
+    RUN_TEST(test_envelope_in_loop);
+    RUN_TEST(test_interrupt_benchmark);
+    RUN_TEST(test_levels_benchmark);
+    int result = UNITY_END();
+
+    printBenchmarks();
+    return result;
+}
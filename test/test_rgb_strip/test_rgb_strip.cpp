@@ -0,0 +1,555 @@
+/**
+ * @file test/test_rgb_strip/test_rgb_strip.cpp
+ * @brief Tests du ruban de DEL RVB sur l'ordinateur (`pio test -e native`) : tramage temporel des intensités sur 16 bit, écriture des registres PWM, transformée de Fourier du mode spectre et fondu enchaîné entre deux modes. Un tableau des mesures (durée sur l'ordinateur et estimation du nombre de cycles sur l'ATmega2560 à 16 MHz) est affiché à la fin.
+ */
+
+// Ajout des bibliothèques au programme.
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+#include <Arduino.h>
+#include <HomeAssistantNative.h>
+
+// Autres fichiers du programme.
+#include "pinDefinitions.hpp"
+#include "device/interface/display.hpp"
+#include "device/interface/HomeAssistant.hpp"
+#include "device/input/analogInput.hpp"
+#include "device/output/RGBLEDStrip.hpp"
+
+// Nombre maximal de mesures.
+#define BENCHMARKS_NUMBER 16
+
+// Le tramage répartit les 4 bits de poids fort de la fraction sur un motif de 16 trames.
+#define DITHER_PERIOD 16
+
+// Emplacement de la vitesse du mode arc-en-ciel dans la mémoire EEPROM simulée.
+#define EEPROM_TEST_RAINBOW_SPEED 10
+
+// Nombre de passages dans la boucle mesurés pour le fondu enchaîné (un passage toutes les 2 ms).
+#define TRANSITION_FRAMES 20000
+
+// Écart maximal toléré entre une raie de la transformée en virgule fixe et la transformée de référence, en unités de la sortie (pleine échelle de ±8192) : les troncatures des 6 étages donnent au plus 5 unités.
+#define SPECTRUM_TOLERANCE 6
+
+// Routines d'interruption du timer 3 et du convertisseur analogique-numérique (des fonctions ordinaires sur l'ordinateur, voir `avr/interrupt.h`).
+extern "C" void TIMER3_OVF_vect();
+extern "C" void ADC_vect();
+
+/// @brief Ruban de DEL donnant accès à ses couleurs et au calcul de chaque trame.
+class StripProbe : public RGBLEDStrip
+{
+public:
+    using RGBLEDStrip::RGBLEDStrip;
+    using RGBLEDStrip::dither;
+    using RGBLEDStrip::writeChannel;
+    using RGBLEDStrip::blend;
+
+    RGBLEDStripChannel &getChannel(unsigned int color)
+    {
+        return (color == 0) ? m_RChannel : ((color == 1) ? m_GChannel : m_BChannel);
+    }
+
+    bool isInTransition() const
+    {
+        return m_outgoingMode != nullptr;
+    }
+
+    const RGBLEDStripFrame &getOutgoingFrame() const
+    {
+        return m_outgoingFrame;
+    }
+
+    const RGBLEDStripFrame &getIncomingFrame() const
+    {
+        return m_incomingFrame;
+    }
+
+    unsigned long getTransitionStart() const
+    {
+        return m_transitionStart;
+    }
+};
+
+/// @brief Mode spectre donnant accès à l'étape en cours et aux raies de la transformée.
+class SpectrumProbe : public SpectrumMode
+{
+public:
+    using SpectrumMode::SpectrumMode;
+
+    SpectrumStep getStep() const
+    {
+        return m_step;
+    }
+
+    int getReal(unsigned int bin) const
+    {
+        return m_real[bin];
+    }
+
+    int getImaginary(unsigned int bin) const
+    {
+        return m_imaginary[bin];
+    }
+};
+
+/// @brief Mesure d'une opération : durée moyenne d'un appel sur l'ordinateur et estimation sur la carte.
+struct Benchmark
+{
+    const char *name;
+    unsigned long calls;
+    double hostTime;
+    unsigned long AVRCycles;
+};
+
+static Display display(F("Écran"), 0);
+static HomeAssistant connection(F("Home Assistant"), 0, Serial, display);
+static StripProbe strip(F("Ruban de DEL"), 1, connection, display, PIN_RED_LED, PIN_GREEN_LED, PIN_BLUE_LED);
+static Microphone microphone(F("Microphone"), 2, connection, PIN_MICROPHONE, false);
+static SpectrumProbe spectrumMode(F("Mode spectre"), 3, strip, microphone);
+static RainbowMode rainbowMode(F("Mode arc-en-ciel"), 4, strip, EEPROM_TEST_RAINBOW_SPEED);
+static Benchmark benchmarks[BENCHMARKS_NUMBER];
+static unsigned int benchmarksNumber = 0;
+
+/// @brief Enregistre une mesure dont la durée a été cumulée sur plusieurs intervalles.
+/// @param name Le nom de l'opération.
+/// @param calls Le nombre d'appels mesurés.
+/// @param time La durée totale des appels.
+/// @param AVRCycles Le nombre de cycles estimé d'un appel sur l'ATmega2560 (voir le test de l'opération).
+static void addBenchmark(const char *name, unsigned long calls, std::chrono::steady_clock::duration time, unsigned long AVRCycles)
+{
+    if (benchmarksNumber >= BENCHMARKS_NUMBER)
+        return;
+
+    Benchmark &benchmark = benchmarks[benchmarksNumber++];
+    benchmark.name = name;
+    benchmark.calls = calls;
+    benchmark.hostTime = std::chrono::duration<double, std::nano>(time).count() / calls;
+    benchmark.AVRCycles = AVRCycles;
+}
+
+/// @brief Enregistre une mesure.
+/// @param name Le nom de l'opération.
+/// @param calls Le nombre d'appels mesurés.
+/// @param startTime Le début de la mesure.
+/// @param AVRCycles Le nombre de cycles estimé d'un appel sur l'ATmega2560 (voir le test de l'opération).
+static void addBenchmark(const char *name, unsigned long calls, std::chrono::steady_clock::time_point startTime, unsigned long AVRCycles)
+{
+    addBenchmark(name, calls, std::chrono::steady_clock::now() - startTime, AVRCycles);
+}
+
+/// @brief Envoie un bloc d'échantillons au microphone, comme le ferait le convertisseur.
+/// @param samples Les échantillons centrés sur zéro.
+static void convertSamples(const int *samples)
+{
+    for (unsigned int i = 0; i < SPECTRUM_FFT_SIZE; i++)
+    {
+        ADC = samples[i] + 512;
+        ADC_vect();
+    }
+}
+
+/// @brief Calcule la transformée de référence (en nombres réels) des échantillons fenêtrés comme le fait le mode spectre, à l'échelle de sa sortie (divisée par la taille de la transformée).
+/// @param samples Les échantillons centrés sur zéro.
+/// @param real Les parties réelles des raies.
+/// @param imaginary Les parties imaginaires des raies.
+static void referenceFFT(const int *samples, double *real, double *imaginary)
+{
+    double windowed[SPECTRUM_FFT_SIZE];
+
+    for (unsigned int n = 0; n < SPECTRUM_FFT_SIZE; n++)
+    {
+        unsigned int index = (n < (SPECTRUM_FFT_SIZE / 2)) ? n : (SPECTRUM_FFT_SIZE - 1 - n);
+        double window = 0.5 * (1 - cos(2 * M_PI * index / (SPECTRUM_FFT_SIZE - 1)));
+        windowed[n] = ((long)samples[n] * 32 * lround(window * 32768)) >> 15;
+    }
+
+    for (unsigned int k = 0; k < SPECTRUM_FFT_SIZE; k++)
+    {
+        real[k] = 0;
+        imaginary[k] = 0;
+
+        for (unsigned int n = 0; n < SPECTRUM_FFT_SIZE; n++)
+        {
+            real[k] += windowed[n] * cos(2 * M_PI * k * n / SPECTRUM_FFT_SIZE) / SPECTRUM_FFT_SIZE;
+            imaginary[k] -= windowed[n] * sin(2 * M_PI * k * n / SPECTRUM_FFT_SIZE) / SPECTRUM_FFT_SIZE;
+        }
+    }
+}
+
+/// @brief Exécute le mode spectre sur un bloc d'échantillons jusqu'à la fin des papillons, puis compare chaque raie à la transformée de référence.
+/// @param samples Les échantillons centrés sur zéro.
+/// @param name Le nom du signal, affiché en cas d'échec.
+/// @return La raie la plus intense (hors composante continue).
+static unsigned int checkSpectrum(const int *samples, const char *name)
+{
+    convertSamples(samples);
+
+    for (unsigned int i = 0; i < 16 && spectrumMode.getStep() != SPECTRUM_ANALYSE; i++)
+        strip.loop();
+
+    TEST_ASSERT_EQUAL_UINT32(SPECTRUM_ANALYSE, spectrumMode.getStep());
+
+    double real[SPECTRUM_FFT_SIZE];
+    double imaginary[SPECTRUM_FFT_SIZE];
+    referenceFFT(samples, real, imaginary);
+
+    unsigned int peakBin = 1;
+    long peakAmplitude = 0;
+
+    for (unsigned int k = 0; k < (SPECTRUM_FFT_SIZE / 2); k++)
+    {
+        if (fabs(spectrumMode.getReal(k) - real[k]) > SPECTRUM_TOLERANCE || fabs(spectrumMode.getImaginary(k) - imaginary[k]) > SPECTRUM_TOLERANCE)
+        {
+            char message[128];
+            snprintf(message, sizeof(message), "%s, raie %u : %d%+di au lieu de %.1f%+.1fi", name, k, spectrumMode.getReal(k), spectrumMode.getImaginary(k), real[k], imaginary[k]);
+            TEST_FAIL_MESSAGE(message);
+        }
+
+        long amplitude = abs(spectrumMode.getReal(k)) + abs(spectrumMode.getImaginary(k));
+        if (k > 0 && amplitude > peakAmplitude)
+        {
+            peakAmplitude = amplitude;
+            peakBin = k;
+        }
+    }
+
+    // Analyse des bandes et retour à la collecte des échantillons.
+    strip.loop();
+    return peakBin;
+}
+
+/// @brief Produit un extrait musical de synthèse : trois notes (graves, médiums et aigus) de phases aléatoires et un bruit blanc.
+/// @param samples Les échantillons centrés sur zéro.
+/// @param block L'indice du bloc dans l'extrait.
+static void musicBlock(int *samples, unsigned long block)
+{
+    for (unsigned int n = 0; n < SPECTRUM_FFT_SIZE; n++)
+    {
+        double time = double((block * SPECTRUM_FFT_SIZE) + n) / MICROPHONE_SAMPLE_RATE;
+        double value = 180 * sin(2 * M_PI * 196 * time) + 120 * sin(2 * M_PI * 880 * time + 1.3) + 60 * sin(2 * M_PI * 3520 * time + 0.4);
+        samples[n] = lround(value) + (int)random(-40, 41);
+    }
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+/// @brief Sur 16 trames, le tramage rend exactement les 4 bits de poids fort de la fraction (sauf au rapport cyclique maximal, qui ne peut pas être dépassé).
+void test_dither_average()
+{
+    RGBLEDStripChannel channel = {};
+
+    for (unsigned long intensity = 0; intensity <= 0xFFFF; intensity++)
+    {
+        channel.intensity = intensity;
+        channel.error = 0;
+
+        unsigned long sum = 0;
+        for (unsigned int frame = 0; frame < DITHER_PERIOD; frame++)
+            sum += StripProbe::dither(channel);
+
+        unsigned long duty = intensity >> 8;
+        unsigned long expected = (duty * DITHER_PERIOD) + ((duty < 255) ? ((intensity >> 4) & 0x0F) : 0);
+
+        if (sum != expected)
+        {
+            char message[64];
+            snprintf(message, sizeof(message), "intensité 0x%04lX", intensity);
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected, sum, message);
+        }
+    }
+}
+
+/// @brief Le motif se répète toutes les 16 trames, quelle que soit l'intensité : un pas supplémentaire revient au moins toutes les 16 trames (environ 30 Hz), au-delà du seuil de scintillement visible.
+void test_dither_period()
+{
+    RGBLEDStripChannel channel = {};
+    unsigned int duties[DITHER_PERIOD * 2];
+
+    for (unsigned long intensity = 0; intensity <= 0xFFFF; intensity++)
+    {
+        channel.intensity = intensity;
+        channel.error = (intensity * 7) & 0x0F;
+
+        for (unsigned int frame = 0; frame < (DITHER_PERIOD * 2); frame++)
+            duties[frame] = StripProbe::dither(channel);
+
+        for (unsigned int frame = 0; frame < DITHER_PERIOD; frame++)
+        {
+            if (duties[frame] != duties[frame + DITHER_PERIOD])
+            {
+                char message[64];
+                snprintf(message, sizeof(message), "intensité 0x%04lX, trame %u", intensity, frame);
+                TEST_FAIL_MESSAGE(message);
+            }
+        }
+    }
+}
+
+/// @brief Mesure l'interruption du timer 3, exécutée à chaque trame PWM (environ 490 Hz) : tramage et écriture des trois couleurs.
+/// Estimation sur l'ATmega2560 : environ 75 cycles d'entrée et de sortie (sauvegarde des 15 registres utilisés par l'appel d'une méthode), 10 cycles pour l'appel de `updateDithering()`, puis pour chaque couleur environ 30 cycles de tramage et 20 cycles d'écriture lorsque le rapport cyclique ne change pas (45 sinon). Avec des fractions non nulles sur les trois couleurs, environ une trame sur deux change de rapport cyclique : 75 + 10 + 3 × (30 + 33) ≈ 275 cycles, soit 17 µs toutes les 2 ms (moins de 1 % du processeur).
+void test_dither_interrupt_benchmark()
+{
+    // Fractions différentes sur les trois couleurs : le rapport cyclique change régulièrement.
+    strip.getChannel(0).intensity = 0x1238;
+    strip.getChannel(1).intensity = 0x00A5;
+    strip.getChannel(2).intensity = 0x7F7F;
+
+    unsigned long calls = 1000000;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    for (unsigned long i = 0; i < calls; i++)
+        TIMER3_OVF_vect();
+
+    addBenchmark("Interruption du timer 3", calls, startTime, 275);
+
+    TEST_ASSERT_TRUE(strip.getChannel(0).duty >= 0x12 && strip.getChannel(0).duty <= 0x13);
+    TEST_ASSERT_TRUE(strip.getChannel(2).duty >= 0x7F && strip.getChannel(2).duty <= 0x80);
+}
+
+/// @brief L'interruption ne modifie jamais `TCCR3A` (rouge et bleu en PWM à phase correcte, connectés dès l'initialisation), et ne modifie `TCCR0A` (vert en PWM rapide) que lorsque le rapport cyclique du vert passe par zéro.
+void test_write_channel_registers()
+{
+    TEST_ASSERT_TRUE(TCCR3A & _BV(COM3C1));
+    TEST_ASSERT_TRUE(TCCR3A & _BV(COM3A1));
+
+    uint8_t timer3Control = TCCR3A;
+    uint8_t timer0Control = TCCR0A;
+    unsigned int timer0Changes = 0;
+    unsigned int greenCrossings = 0;
+    bool greenOn = strip.getChannel(1).duty > 0;
+
+    // Extinction puis faible intensité toutes les 32 trames, avec une fraction qui fait alterner le vert entre 0 et 1.
+    for (unsigned long frame = 0; frame < 4096; frame++)
+    {
+        unsigned int intensity = ((frame / 32) % 2) ? 0x0008 + ((frame / 64) % 4) * 0x0040 : 0;
+
+        for (unsigned int color = 0; color < 3; color++)
+            strip.getChannel(color).intensity = intensity;
+
+        TIMER3_OVF_vect();
+
+        TEST_ASSERT_EQUAL_UINT32(timer3Control, TCCR3A);
+
+        if (TCCR0A != timer0Control)
+        {
+            timer0Control = TCCR0A;
+            timer0Changes++;
+        }
+
+        if ((strip.getChannel(1).duty > 0) != greenOn)
+        {
+            greenOn = !greenOn;
+            greenCrossings++;
+        }
+
+        TEST_ASSERT_EQUAL_UINT32(greenOn, (TCCR0A & _BV(COM0B1)) != 0);
+
+        if (intensity == 0)
+        {
+            TEST_ASSERT_EQUAL_UINT32(0, OCR3C);
+            TEST_ASSERT_EQUAL_UINT32(0, OCR3A);
+        }
+    }
+
+    TEST_ASSERT_TRUE(greenCrossings > 0);
+    TEST_ASSERT_EQUAL_UINT32(greenCrossings, timer0Changes);
+}
+
+/// @brief Mesure l'écriture d'un rapport cyclique dans les trois cas rencontrés par l'interruption.
+/// Estimation sur l'ATmega2560 (appel et retour compris) : environ 20 cycles lorsque le rapport cyclique ne change pas, 45 cycles pour une nouvelle valeur du registre de comparaison, et 55 cycles lorsque le vert passe par zéro (lecture, modification et écriture de `TCCR0A` et du port).
+void test_write_channel_benchmark()
+{
+    RGBLEDStripChannel &red = strip.getChannel(0);
+    RGBLEDStripChannel &green = strip.getChannel(1);
+    unsigned long calls = 1000000;
+
+    StripProbe::writeChannel(red, 100);
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    for (unsigned long i = 0; i < calls; i++)
+        StripProbe::writeChannel(red, 100);
+
+    addBenchmark("Écriture inchangée", calls, startTime, 20);
+    startTime = std::chrono::steady_clock::now();
+
+    for (unsigned long i = 0; i < calls; i++)
+        StripProbe::writeChannel(red, 100 + (i & 1));
+
+    addBenchmark("Écriture (timer 3)", calls, startTime, 45);
+    startTime = std::chrono::steady_clock::now();
+
+    for (unsigned long i = 0; i < calls; i++)
+        StripProbe::writeChannel(green, i & 1);
+
+    addBenchmark("Passage par zéro (timer 0)", calls, startTime, 55);
+
+    TEST_ASSERT_EQUAL_UINT32(101, OCR3C);
+    TEST_ASSERT_EQUAL_UINT32(1, OCR0B);
+    TEST_ASSERT_TRUE(TCCR0A & _BV(COM0B1));
+}
+
+/// @brief Un son pur sur chaque raie du spectre donne la raie attendue, et toutes les raies restent à moins de `SPECTRUM_TOLERANCE` de la transformée de référence.
+void test_spectrum_bins()
+{
+    strip.setTransitionDuration(0);
+    strip.setMode(&spectrumMode);
+    strip.turnOn(false);
+
+    int samples[SPECTRUM_FFT_SIZE];
+
+    for (unsigned int bin = 1; bin < (SPECTRUM_FFT_SIZE / 2); bin++)
+    {
+        for (unsigned int n = 0; n < SPECTRUM_FFT_SIZE; n++)
+            samples[n] = lround(500 * sin(2 * M_PI * bin * n / SPECTRUM_FFT_SIZE + 0.3));
+
+        char name[32];
+        snprintf(name, sizeof(name), "son pur sur la raie %u", bin);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(bin, checkSpectrum(samples, name), name);
+    }
+
+    // Extrait musical bruité : les raies restent exactes, et la note grave (196 Hz, raie 1,3) domine.
+    randomSeed(7);
+    for (unsigned long block = 0; block < 64; block++)
+    {
+        musicBlock(samples, block);
+        TEST_ASSERT_EQUAL_UINT32(1, checkSpectrum(samples, "extrait musical"));
+    }
+}
+
+/// @brief Mesure chaque passage du mode spectre dans la boucle sur un extrait musical de synthèse.
+/// Estimation sur l'ATmega2560 : une collecte de 16 échantillons coûte environ 1400 cycles (lecture du tampon, fenêtre et multiplication sur 32 bit par échantillon) ; un étage de papillons coûte environ 5000 cycles (32 papillons de 4 multiplications de 16 bit par 16 bit) ; l'analyse coûte environ 2500 cycles (somme de 31 raies et 3 divisions sur 32 bit). Une transformée complète coûte donc 4 × 1400 + 6 × 5000 + 2500 ≈ 38 000 cycles (2,4 ms pour 6,7 ms d'échantillons), et aucun passage dans la boucle ne dépasse 0,3 ms.
+void test_spectrum_benchmark()
+{
+    int samples[SPECTRUM_FFT_SIZE];
+    unsigned long frames = 20000;
+    std::chrono::steady_clock::duration times[SPECTRUM_ANALYSE + 1] = {};
+    unsigned long calls[SPECTRUM_ANALYSE + 1] = {};
+
+    for (unsigned long frame = 0; frame < frames; frame++)
+    {
+        musicBlock(samples, frame);
+        convertSamples(samples);
+
+        SpectrumStep step;
+
+        do
+        {
+            step = spectrumMode.getStep();
+            std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+            strip.loop();
+            times[step] += std::chrono::steady_clock::now() - startTime;
+            calls[step]++;
+        } while (step != SPECTRUM_ANALYSE);
+    }
+
+    addBenchmark("Spectre : collecte (16 éch.)", calls[SPECTRUM_COLLECT], times[SPECTRUM_COLLECT], 1400);
+    addBenchmark("Spectre : étage de papillons", calls[SPECTRUM_BUTTERFLIES], times[SPECTRUM_BUTTERFLIES], 5000);
+    addBenchmark("Spectre : analyse", calls[SPECTRUM_ANALYSE], times[SPECTRUM_ANALYSE], 2500);
+    addBenchmark("Spectre : transformée complète", frames, times[SPECTRUM_COLLECT] + times[SPECTRUM_BUTTERFLIES] + times[SPECTRUM_ANALYSE], 38100);
+
+    TEST_ASSERT_EQUAL_UINT32(frames * 4, calls[SPECTRUM_COLLECT]);
+    TEST_ASSERT_EQUAL_UINT32(frames * SPECTRUM_FFT_STAGES, calls[SPECTRUM_BUTTERFLIES]);
+
+    strip.turnOff(false);
+}
+
+/// @brief Exécute la boucle du ruban en envoyant au microphone les échantillons d'un passage, et mesure sa durée.
+/// @param frames Le nombre de passages.
+/// @return La durée totale des passages.
+static std::chrono::steady_clock::duration measureStripLoop(unsigned long frames)
+{
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::duration::zero();
+    int samples[SPECTRUM_FFT_SIZE];
+
+    for (unsigned long frame = 0; frame < frames; frame++)
+    {
+        // Environ 19 échantillons sont enregistrés toutes les 2 ms : le mode spectre a toujours une étape à exécuter.
+        if ((frame % 4) == 0)
+        {
+            musicBlock(samples, frame / 4);
+            convertSamples(samples);
+        }
+
+        advanceTime(2);
+
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        strip.loop();
+        time += std::chrono::steady_clock::now() - startTime;
+    }
+
+    return time;
+}
+
+/// @brief Mesure un passage dans la boucle pendant un fondu enchaîné, qui exécute les deux modes dans leurs sorties virtuelles puis écrit leur mélange, et le compare au mode seul.
+/// Estimation sur l'ATmega2560 : le mode arc-en-ciel seul coûte environ 700 cycles lorsqu'il change de couleur (3 corrections gamma de 16 bit), soit un passage sur cinq, et 50 cycles sinon : environ 200 cycles en moyenne. Pendant le fondu, le mode arc-en-ciel écrit dans sa sortie virtuelle (environ 150 cycles), le mode spectre exécute son étape (jusqu'à 5000 cycles pour un étage de papillons, 1400 cycles en moyenne sur une transformée), puis le mélange (6 multiplications de 16 bit par 16 bit) et l'écriture corrigée coûtent environ 800 cycles. Le passage le plus long est donc d'environ 6000 cycles (0,4 ms), sous le budget d'une trame PWM (2 ms à 490 Hz), et un passage moyen d'environ 2500 cycles.
+void test_transition_benchmark()
+{
+    strip.setTransitionDuration(0);
+    strip.setMode(&rainbowMode);
+    strip.turnOn(false);
+
+    std::chrono::steady_clock::duration time = measureStripLoop(TRANSITION_FRAMES);
+    addBenchmark("Boucle : arc-en-ciel seul", TRANSITION_FRAMES, time, 200);
+
+    strip.setTransitionDuration(TRANSITION_FRAMES * 4);
+    strip.setMode(&spectrumMode);
+
+    time = measureStripLoop(TRANSITION_FRAMES);
+    addBenchmark("Boucle : fondu arc-en-ciel/spectre", TRANSITION_FRAMES, time, 2500);
+
+    // À mi-parcours, les deux modes tournent toujours et le ruban affiche le mélange de leurs sorties virtuelles.
+    TEST_ASSERT_TRUE(strip.isInTransition());
+    TEST_ASSERT_TRUE(rainbowMode.isActivated());
+    TEST_ASSERT_TRUE(spectrumMode.isActivated());
+    TEST_ASSERT_TRUE(microphone.isSampling());
+
+    unsigned int weight = (millis() - strip.getTransitionStart()) * 256 / strip.getTransitionDuration();
+    TEST_ASSERT_EQUAL_UINT32(128, weight);
+    TEST_ASSERT_EQUAL_UINT32(StripProbe::blend(strip.getOutgoingFrame().r, strip.getIncomingFrame().r, weight), strip.getChannel(0).value);
+    TEST_ASSERT_EQUAL_UINT32(StripProbe::blend(strip.getOutgoingFrame().g, strip.getIncomingFrame().g, weight), strip.getChannel(1).value);
+    TEST_ASSERT_EQUAL_UINT32(StripProbe::blend(strip.getOutgoingFrame().b, strip.getIncomingFrame().b, weight), strip.getChannel(2).value);
+
+    strip.turnOff(false);
+    strip.setTransitionDuration(RGB_LED_STRIP_TRANSITION_DURATION);
+
+    TEST_ASSERT_TRUE(!rainbowMode.isActivated());
+    TEST_ASSERT_TRUE(!spectrumMode.isActivated());
+    TEST_ASSERT_TRUE(!microphone.isSampling());
+}
+
+/// @brief Affiche le tableau des mesures. La durée sur la carte est déduite du nombre de cycles estimé, à 16 MHz.
+static void printBenchmarks()
+{
+    printf("\n%-32s %10s %12s %12s %10s\n", "Mesure", "Appels", "ns (PC)", "Cycles AVR", "µs AVR");
+
+    for (unsigned int i = 0; i < benchmarksNumber; i++)
+    {
+        const Benchmark &benchmark = benchmarks[i];
+        printf("%-32s %10lu %12.1f %12lu %10.1f\n", benchmark.name, benchmark.calls, benchmark.hostTime, benchmark.AVRCycles, benchmark.AVRCycles / 16.0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    advanceTime(1000);
+    strip.setup();
+    microphone.setup();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_dither_average);
+    RUN_TEST(test_dither_period);
+    RUN_TEST(test_dither_interrupt_benchmark);
+    RUN_TEST(test_write_channel_registers);
+    RUN_TEST(test_write_channel_benchmark);
+    RUN_TEST(test_spectrum_bins);
+    RUN_TEST(test_spectrum_benchmark);
+    RUN_TEST(test_transition_benchmark);
+    int result = UNITY_END();
+
+    printBenchmarks();
+    return result;
+}
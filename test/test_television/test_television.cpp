@@ -0,0 +1,829 @@
+/**
+ * @file test/test_television/test_television.cpp
+ * @brief Tests de la télévision sur l'ordinateur (`pio test -e native`) : détection du son clé de lancement d'une vidéo par les filtres de Goertzel, sur des sons purs, décalés et bruités,, calibration du volume vérifiée par une télévision simulée qui décode les trames infrarouges émises, et ponctualité des actions des musiques fournies, lues en entier sur une horloge simulée. Le retard de chaque action et le nombre de messages de disponibilité de chaque musique sont affichés à la fin.
+ */
+
+// Ajout des bibliothèques au programme.
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+#include <Arduino.h>
+#include <HomeAssistantNative.h>
+
+// Autres fichiers du programme.
+#include "pinDefinitions.hpp"
+#include "device/interface/display.hpp"
+#include "device/interface/HomeAssistant.hpp"
+#include "device/input/analogInput.hpp"
+#include "deviceID.hpp"
+#include "device/output/connectedOutput.hpp"
+#include "device/output/RGBLEDStrip.hpp"
+#include "device/output/television.hpp"
+#include "musics.hpp"
+#include "utils/readPROGMEMString.hpp"
+
+// Taille des blocs analysés par les filtres de Goertzel, et nombre de blocs consécutifs nécessaires à une détection.
+#define TRIGGER_BLOCK_SIZE 96
+#define TRIGGER_DETECTIONS 5
+
+// Retard de la boucle sur l'interruption du microphone lors du test de l'instant de détection, en échantillons (environ 3 ms).
+#define TRIGGER_LOOP_LATENCY 30
+
+// Période d'échantillonnage du microphone, en microsecondes (arrondie).
+#define SAMPLE_PERIOD 104
+
+// Durées NEC reconnues par la télévision simulée, en microsecondes : en-tête, silence d'une trame complète et seuil entre un bit à 0 et un bit à 1.
+#define NEC_HEADER_MARK_MINIMUM 8000
+#define NEC_HEADER_SPACE_MINIMUM 4000
+#define NEC_ONE_SPACE_MINIMUM 1000
+
+// Commandes de volume de la télévision.
+#define TELEVISION_VOLUME_UP 0x47
+#define TELEVISION_VOLUME_DOWN 0xC7
+
+// Nombre de musiques fournies, et nombre maximal d'actions d'une musique suivies par la mesure de ponctualité.
+#define MUSICS_NUMBER 3
+#define SHOW_MAXIMUM_ACTIONS 160
+
+// Nombre de lectures de chaque musique, avec des durées de boucle différentes, et durée simulée maximale d'une lecture en millisecondes.
+#define SHOW_RUNS 5
+#define SHOW_TIMEOUT 240000
+
+// Durée d'un passage dans la boucle principale simulée, en périodes d'échantillonnage (de 0,8 à 3,1 ms environ).
+#define LOOP_MINIMUM_TICKS 8
+#define LOOP_MAXIMUM_TICKS 30
+
+// Retard maximal admis pour une action, en microsecondes : un passage de boucle, la résolution de `millis()` et celle de l'horloge simulée.
+#define MAXIMUM_LATENESS ((LOOP_MAXIMUM_TICKS * SAMPLE_PERIOD) + 1000 + SAMPLE_PERIOD)
+
+// Latences mesurées simulées des ampoules connectées, en millisecondes : leurs actions sont envoyées en avance par le second curseur.
+#define SOFA_LIGHT_LATENCY 300
+#define BED_LIGHT_LATENCY 150
+
+// Définition d'un pointeur de la liste des périphériques des musiques, comme dans main.cpp.
+#define MUSIC_DEVICE_OUTPUT(ID, type, device) &device,
+
+// Routines d'interruption du convertisseur analogique-numérique et de l'émetteur infrarouge (des fonctions ordinaires sur l'ordinateur, voir `avr/interrupt.h`).
+extern "C" void ADC_vect();
+extern "C" void TIMER5_COMPA_vect();
+
+/// @brief Ponctualité d'une action d'une musique sur l'ensemble des lectures.
+struct ActionDispatch
+{
+    unsigned int latency;
+    unsigned long executions;
+    unsigned long totalLateness;
+    unsigned long maximumLateness;
+};
+
+// Ponctualité des actions de chaque musique, et musique en cours de mesure.
+static ActionDispatch showDispatches[MUSICS_NUMBER][SHOW_MAXIMUM_ACTIONS];
+static ActionDispatch *dispatches = nullptr;
+
+// Nombre d'actions exécutées depuis le lancement du programme.
+static unsigned long executedActions = 0;
+
+// Messages de disponibilité envoyés pendant une lecture de chaque musique, et nombre d'actions exécutées.
+static unsigned long showAvailabilityUpdates[MUSICS_NUMBER];
+static unsigned long showExecutedActions[MUSICS_NUMBER];
+
+/// @brief Enregistre l'exécution d'une action.
+/// @param index La position de l'action dans la musique.
+/// @param lateness Le retard de l'exécution sur l'instant prévu, en microsecondes.
+/// @param latency La latence du périphérique compensée par le second curseur, en millisecondes (`0` pour un périphérique local).
+static void recordDispatch(unsigned int index, unsigned long lateness, unsigned int latency)
+{
+    if (dispatches == nullptr || index >= SHOW_MAXIMUM_ACTIONS)
+        return;
+
+    ActionDispatch &dispatch = dispatches[index];
+    dispatch.latency = latency;
+    dispatch.executions++;
+    dispatch.totalLateness += lateness;
+    dispatch.maximumLateness = max(dispatch.maximumLateness, lateness);
+}
+
+/// @brief Télévision donnant accès à la détection du son clé, et mesurant le retard de chaque action exécutée.
+class TelevisionProbe : public Television
+{
+public:
+    using Television::Television;
+    using Television::resetTriggerSoundDetection;
+    using Television::detectTriggerSound;
+
+    unsigned long getTriggerSoundDetectionTime() const
+    {
+        return m_triggerSoundDetectionTime;
+    }
+
+    bool isCalibrating() const
+    {
+        return m_syncVolumeDecreases > 0 || m_syncVolumeIncreases > 0;
+    }
+
+    bool isCalibrationAscending() const
+    {
+        return m_syncVolumeDecreases == 0 && m_syncVolumeIncreases > 0;
+    }
+
+    bool isTransmitterIdle() const
+    {
+        return m_IRTransmitter.isIdle();
+    }
+
+    unsigned int getQueueDepth() const
+    {
+        return m_IRTransmitter.getQueueDepth();
+    }
+
+protected:
+    /// @brief Mesure le retard de l'action sur l'instant où elle est due : son moment dans la musique, avancé de la latence du périphérique pour les actions du second curseur.
+    virtual void executeAction(Output *output, const Action &action) override
+    {
+        bool remote = &action == &m_remoteAction;
+        unsigned int index = remote ? m_remoteActionIndex : m_lastActionIndex;
+        unsigned int latency = remote ? m_deviceLatencies[getDeviceIndex(action.deviceID)] : 0;
+        unsigned long dueTime = remote ? (m_remoteActionTime - latency) : m_nextActionTime;
+
+        recordDispatch(index, micros() - (dueTime * 1000), latency);
+        executedActions++;
+        Television::executeAction(output, action);
+    }
+};
+
+/// @brief Périphérique de sortie simple piloté par les musiques (plateau, cube de DEL...).
+class ShowOutput : public Output
+{
+public:
+    using Output::Output;
+
+    virtual void setup() override
+    {
+        if (m_operational)
+            return;
+
+        Output::setup();
+        m_operational = true;
+    }
+
+    virtual void turnOn(bool shareInformation = false) override
+    {
+        if (!m_operational || m_locked)
+            return;
+
+        m_state = true;
+    }
+
+    virtual void turnOff(bool shareInformation = false) override
+    {
+        if (!m_operational || m_locked)
+            return;
+
+        m_state = false;
+    }
+};
+
+/// @brief Ampoule connectée dont la latence mesurée est fixée par le test.
+template <class Light>
+class LatencyProbe : public Light
+{
+public:
+    using Light::Light;
+
+    void setLatency(unsigned int latency)
+    {
+        this->m_latency = latency;
+    }
+};
+
+/// @brief Télévision simulée : décode les trames NEC à partir de l'état de la porteuse et de la durée de chaque étape de l'émetteur, et applique les commandes de volume (par demi-pas, de 0 à 50).
+struct SimulatedTelevision
+{
+    bool mark;
+    unsigned long duration;
+    bool header;
+    bool receiving;
+    uint32_t frame;
+    uint8_t bitsNumber;
+    int halfSteps;
+    unsigned int volumeCommands;
+
+    void receive(bool segmentMark, unsigned long segmentDuration);
+    void decode(bool segmentMark, unsigned long segmentDuration);
+};
+
+static Display display(F("Écran"), 0);
+static HomeAssistant connection(F("Home Assistant"), 0, Serial, display);
+static ShowOutput tray(F("Plateau"), ID_TRAY, connection, display);
+static ShowOutput LEDCube(F("Cube de DEL"), ID_LED_CUBE, connection, display);
+static ShowOutput disco(F("Boule disco"), ID_DISCO, connection, display);
+static ShowOutput beacon(F("Gyrophare"), ID_BEACON, connection, display);
+static ShowOutput wardrobeLights(F("Lumières de l'armoire"), ID_WARDROBE_LIGHTS, connection, display);
+static ShowOutput street(F("Rue"), ID_STREET, connection, display);
+static ShowOutput deskLight(F("Lampe du bureau"), ID_DESK_LIGHT, connection, display);
+static ShowOutput doorLED(F("DEL de la porte"), ID_DOOR_LED, connection, display);
+static RGBLEDStrip LEDStrip(F("Ruban de DEL"), ID_LED_STRIP, connection, display, PIN_RED_LED, PIN_GREEN_LED, PIN_BLUE_LED);
+static ShowOutput alarm(F("Alarme"), ID_ALARM, connection, display);
+static ConnectedOutput mainLights(F("Lumières du plafond"), ID_MAIN_LIGHTS, connection, display);
+static LatencyProbe<ConnectedTemperatureVariableLight> sofaLight(F("Lampe du canapé"), ID_SOFA_LIGHT, connection, display, 2000, 5000);
+static LatencyProbe<ConnectedColorVariableLight> bedLight(F("Lampe de chevet"), ID_BED_LIGHT, connection, display, 2202, 6535);
+static ConnectedOutput cameraLight(F("DEL de la caméra"), ID_CAMERA_LIGHT, connection, display);
+static MusicsAnimationsMode musicsAnimationsMode(F("Mode musiques animées"), 4, LEDStrip);
+static Microphone microphone(F("Microphone"), ID_MICROPHONE, connection, PIN_MICROPHONE, false);
+static TelevisionProbe television(F("Télévision"), ID_TELEVISION, connection, display, PIN_SCREEN_SERVO, PIN_IR_LED, 10, musicsAnimationsMode);
+static Output *musicDevices[] = {MUSIC_DEVICES(MUSIC_DEVICE_OUTPUT)};
+static const Music *const musics[MUSICS_NUMBER] = {&worldsSmallestViolinMusic, &CruelSummerMusic, &testMusic};
+static SimulatedTelevision receiver;
+
+// Indice du prochain échantillon produit depuis le début de la détection (la phase des sons est continue d'un bloc à l'autre).
+static unsigned long sampleNumber = 0;
+
+/// @brief Simule une conversion du convertisseur, une période d'échantillonnage après la précédente.
+/// @param sample L'échantillon centré sur zéro.
+static void convert(int sample)
+{
+    advanceMicros(SAMPLE_PERIOD);
+    ADC = constrain(sample + 512, 0, 1023);
+    ADC_vect();
+    sampleNumber++;
+}
+
+/// @brief Produit un bloc d'échantillons : un son pur éventuellement bruité.
+/// @param frequency La fréquence du son en hertz (`0` pour le bruit seul).
+/// @param amplitude L'amplitude du son.
+/// @param noise L'amplitude maximale du bruit blanc (uniforme).
+static void convertBlock(double frequency, int amplitude, int noise)
+{
+    for (unsigned int i = 0; i < TRIGGER_BLOCK_SIZE; i++)
+    {
+        double value = amplitude * sin(2 * M_PI * frequency * sampleNumber / MICROPHONE_SAMPLE_RATE);
+
+        if (noise > 0)
+            value += random(-noise, noise + 1);
+
+        convert(lround(value));
+    }
+}
+
+/// @brief Envoie des blocs d'un son et les fait analyser un par un par la télévision.
+/// @param frequency La fréquence du son en hertz.
+/// @param amplitude L'amplitude du son.
+/// @param noise L'amplitude maximale du bruit blanc.
+/// @param blocks Le nombre de blocs.
+/// @return Le numéro du bloc (à partir de 1) à la fin duquel un son a été détecté, ou `0`.
+static unsigned int detectBlocks(double frequency, int amplitude, int noise, unsigned int blocks, int &detectedFrequency)
+{
+    for (unsigned int block = 1; block <= blocks; block++)
+    {
+        convertBlock(frequency, amplitude, noise);
+
+        detectedFrequency = television.detectTriggerSound();
+        if (detectedFrequency != 0)
+            return block;
+    }
+
+    return 0;
+}
+
+/// @brief Recommence une détection sur un tampon vide.
+static void resetDetection()
+{
+    television.resetTriggerSoundDetection();
+    microphone.stopSampling();
+    sampleNumber = 0;
+}
+
+/// @brief Ajoute une étape de l'émetteur : les étapes consécutives de même état sont fusionnées en une impulsion ou un silence.
+/// @param segmentMark L'état de la porteuse pendant l'étape.
+/// @param segmentDuration La durée de l'étape en microsecondes.
+void SimulatedTelevision::receive(bool segmentMark, unsigned long segmentDuration)
+{
+    if (segmentMark != mark && duration > 0)
+    {
+        decode(mark, duration);
+        duration = 0;
+    }
+
+    mark = segmentMark;
+    duration += segmentDuration;
+}
+
+/// @brief Décode une impulsion ou un silence complet. Les trames de répétition sont ignorées.
+/// @param segmentMark `true` pour une impulsion de la porteuse.
+/// @param segmentDuration La durée en microsecondes.
+void SimulatedTelevision::decode(bool segmentMark, unsigned long segmentDuration)
+{
+    if (segmentMark)
+    {
+        header = segmentDuration >= NEC_HEADER_MARK_MINIMUM;
+        return;
+    }
+
+    if (header)
+    {
+        header = false;
+        receiving = segmentDuration >= NEC_HEADER_SPACE_MINIMUM;
+        frame = 0;
+        bitsNumber = 0;
+        return;
+    }
+
+    if (!receiving)
+        return;
+
+    if (segmentDuration >= NEC_ONE_SPACE_MINIMUM)
+        frame |= 1UL << bitsNumber;
+
+    if (++bitsNumber < 32)
+        return;
+
+    receiving = false;
+    uint8_t command = frame >> 16;
+
+    if (command == TELEVISION_VOLUME_UP)
+    {
+        halfSteps = min(halfSteps + 1, 50);
+        volumeCommands++;
+    }
+
+    else if (command == TELEVISION_VOLUME_DOWN)
+    {
+        halfSteps = max(halfSteps - 1, 0);
+        volumeCommands++;
+    }
+}
+
+/// @brief Exécute une étape de l'émetteur infrarouge et la transmet à la télévision simulée.
+/// @return La durée de l'étape en microsecondes, jusqu'à la prochaine interruption.
+static unsigned long transmitStep()
+{
+    uint16_t start = OCR5A;
+    TIMER5_COMPA_vect();
+
+    // Le timer 5 compte par pas de 0,5 µs.
+    unsigned long duration = (uint16_t)(OCR5A - start) / 2;
+    receiver.receive(TCCR4A & _BV(COM4A1), duration);
+    return duration;
+}
+
+/// @brief Fait tourner la boucle de la télévision et l'émetteur jusqu'à la fin de la calibration et des émissions.
+/// @param action Une action exécutée à chaque étape (changement de volume par l'utilisateur...), ou `nullptr`.
+static void runTelevision(void (*action)())
+{
+    while (television.isCalibrating() || !television.isTransmitterIdle())
+    {
+        television.loop();
+
+        if (action != nullptr)
+            action();
+
+        if (!television.isTransmitterIdle())
+            advanceMicros(transmitStep());
+    }
+
+    // Dernier silence entre deux commandes.
+    receiver.receive(true, 0);
+}
+
+/// @brief Calibre le volume d'une télévision simulée réglée sur un volume quelconque.
+/// @param halfSteps Le volume de départ de la télévision simulée, en demi-pas.
+/// @param action Une action exécutée à chaque étape de l'émission, ou `nullptr`.
+static void calibrate(int halfSteps, void (*action)())
+{
+    runTelevision(nullptr);
+    receiver.halfSteps = halfSteps;
+    receiver.volumeCommands = 0;
+
+    television.syncVolume(false);
+    runTelevision(action);
+}
+
+void setUp()
+{
+    resetDetection();
+}
+
+void tearDown() {}
+
+/// @brief Un son pur sur chacune des trois fréquences est reconnu exactement à la fin du cinquième bloc consécutif.
+void test_trigger_pure_tones()
+{
+    const unsigned int frequencies[3] = {1000, 1500, 2000};
+
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        resetDetection();
+
+        int frequency = 0;
+        unsigned int block = detectBlocks(frequencies[i], 200, 0, 20, frequency);
+
+        TEST_ASSERT_EQUAL_UINT32(TRIGGER_DETECTIONS, block);
+        TEST_ASSERT_EQUAL_INT(frequencies[i], frequency);
+    }
+}
+
+/// @brief Un son faible, mais au-dessus de l'énergie minimale, est aussi reconnu.
+void test_trigger_quiet_tone()
+{
+    int frequency = 0;
+    TEST_ASSERT_EQUAL_UINT32(TRIGGER_DETECTIONS, detectBlocks(1500, 40, 0, 20, frequency));
+    TEST_ASSERT_EQUAL_INT(1500, frequency);
+}
+
+/// @brief Des sons entre les raies recherchées, ou loin d'elles, ne sont jamais reconnus.
+void test_trigger_off_bin_tones()
+{
+    const double frequencies[] = {440, 700, 1250, 1750, 2500, 3500};
+
+    for (unsigned int i = 0; i < (sizeof(frequencies) / sizeof(frequencies[0])); i++)
+    {
+        resetDetection();
+
+        int frequency = 0;
+        char message[48];
+        snprintf(message, sizeof(message), "son de %.0f Hz", frequencies[i]);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, detectBlocks(frequencies[i], 300, 0, 50, frequency), message);
+    }
+}
+
+/// @brief Un son clé couvert par un bruit modéré est reconnu ; un son noyé dans le bruit, le bruit seul et le silence ne le sont pas.
+void test_trigger_noisy_tones()
+{
+    randomSeed(3);
+    int frequency = 0;
+
+    // Bruit uniforme de ±120 : le son garde environ 80 % de l'énergie du bloc.
+    TEST_ASSERT_EQUAL_UINT32(TRIGGER_DETECTIONS, detectBlocks(2000, 200, 120, 20, frequency));
+    TEST_ASSERT_EQUAL_INT(2000, frequency);
+
+    // Bruit uniforme de ±450 : le son n'a plus qu'environ 23 % de l'énergie du bloc.
+    resetDetection();
+    TEST_ASSERT_EQUAL_UINT32(0, detectBlocks(1000, 200, 450, 100, frequency));
+
+    resetDetection();
+    TEST_ASSERT_EQUAL_UINT32(0, detectBlocks(0, 0, 300, 100, frequency));
+
+    resetDetection();
+    TEST_ASSERT_EQUAL_UINT32(0, detectBlocks(1000, 0, 0, 100, frequency));
+}
+
+/// @brief Les blocs reconnus doivent être consécutifs : un bloc de silence remet le compte à zéro.
+void test_trigger_consecutive_blocks()
+{
+    int frequency = 0;
+
+    TEST_ASSERT_EQUAL_UINT32(0, detectBlocks(1000, 200, 0, TRIGGER_DETECTIONS - 1, frequency));
+    TEST_ASSERT_EQUAL_UINT32(0, detectBlocks(1000, 0, 0, 1, frequency));
+    TEST_ASSERT_EQUAL_UINT32(0, detectBlocks(1000, 200, 0, TRIGGER_DETECTIONS - 1, frequency));
+    TEST_ASSERT_EQUAL_UINT32(1, detectBlocks(1000, 200, 0, 1, frequency));
+    TEST_ASSERT_EQUAL_INT(1000, frequency);
+}
+
+/// @brief L'instant de détection est celui de l'enregistrement de la fin du premier bloc reconnu, et non celui de son traitement par la boucle, qui arrive ici 3 ms plus tard.
+void test_trigger_detection_time()
+{
+    unsigned long firstBlockEnd = 0;
+    int frequency = 0;
+
+    // Deux blocs de silence puis le son, analysés par la boucle 30 échantillons après la fin de chaque bloc.
+    for (unsigned long i = 0; i < (TRIGGER_BLOCK_SIZE * 10) && frequency == 0; i++)
+    {
+        bool tone = i >= (TRIGGER_BLOCK_SIZE * 2);
+        convert(tone ? lround(200 * sin(2 * M_PI * 1500 * i / MICROPHONE_SAMPLE_RATE)) : 0);
+
+        if (i == ((TRIGGER_BLOCK_SIZE * 3) - 1))
+            firstBlockEnd = millis();
+
+        if ((i % TRIGGER_BLOCK_SIZE) == TRIGGER_LOOP_LATENCY)
+            frequency = television.detectTriggerSound();
+    }
+
+    TEST_ASSERT_EQUAL_INT(1500, frequency);
+
+    long error = long(television.getTriggerSoundDetectionTime() - firstBlockEnd);
+    TEST_ASSERT_TRUE(abs(error) <= 1);
+}
+
+/// @brief Sans intervention de l'utilisateur, la calibration ramène la télévision à zéro puis au volume enregistré, quel que soit son volume de départ.
+void test_volume_calibration()
+{
+    calibrate(37, nullptr);
+    TEST_ASSERT_EQUAL_UINT32(10, television.getVolume());
+    TEST_ASSERT_EQUAL_INT(20, receiver.halfSteps);
+    TEST_ASSERT_EQUAL_UINT32(25 * 2 + 10 * 2, receiver.volumeCommands);
+
+    calibrate(3, nullptr);
+    TEST_ASSERT_EQUAL_INT(20, receiver.halfSteps);
+}
+
+// Nombre de changements de volume restant à faire par l'utilisateur pendant une calibration.
+static unsigned int userSteps = 0;
+
+/// @brief L'utilisateur monte le volume pendant la descente de la calibration.
+static void increaseDuringDescent()
+{
+    if (userSteps > 0 && television.isCalibrating() && !television.isCalibrationAscending())
+    {
+        television.increaseVolume(false);
+        userSteps--;
+    }
+}
+
+/// @brief L'utilisateur baisse le volume pendant la montée de la calibration, alors que des hausses de calibration sont en attente.
+static void decreaseDuringAscent()
+{
+    if (userSteps > 0 && television.isCalibrationAscending())
+    {
+        television.decreaseVolume(false);
+        userSteps--;
+    }
+}
+
+/// @brief L'utilisateur monte le volume pendant la montée de la calibration.
+static void increaseDuringAscent()
+{
+    if (userSteps > 0 && television.isCalibrationAscending())
+    {
+        television.increaseVolume(false);
+        userSteps--;
+    }
+}
+
+/// @brief Un changement de volume pendant la descente est appliqué par la montée, et un changement pendant la montée l'ajuste : la télévision finit toujours au volume affiché.
+void test_volume_calibration_user_changes()
+{
+    userSteps = 3;
+    calibrate(37, increaseDuringDescent);
+    TEST_ASSERT_EQUAL_UINT32(0, userSteps);
+    TEST_ASSERT_EQUAL_UINT32(13, television.getVolume());
+    TEST_ASSERT_EQUAL_INT(26, receiver.halfSteps);
+
+    userSteps = 4;
+    calibrate(37, decreaseDuringAscent);
+    TEST_ASSERT_EQUAL_UINT32(0, userSteps);
+    TEST_ASSERT_EQUAL_UINT32(9, television.getVolume());
+    TEST_ASSERT_EQUAL_INT(18, receiver.halfSteps);
+
+    // Les baisses retirent des hausses de la calibration pas encore émises, sans jamais toucher aux commandes déjà dans la file.
+    TEST_ASSERT_EQUAL_UINT32(25 * 2 + 9 * 2, receiver.volumeCommands);
+
+    userSteps = 2;
+    calibrate(37, increaseDuringAscent);
+    TEST_ASSERT_EQUAL_UINT32(0, userSteps);
+    TEST_ASSERT_EQUAL_UINT32(11, television.getVolume());
+    TEST_ASSERT_EQUAL_INT(22, receiver.halfSteps);
+}
+
+/// @brief En dehors d'une calibration, une hausse puis une baisse encore en attente s'annulent sans rien émettre.
+void test_volume_coalescing()
+{
+    calibrate(20, nullptr);
+    receiver.volumeCommands = 0;
+    unsigned int volume = television.getVolume();
+
+    television.increaseVolume(false);
+    television.increaseVolume(false);
+    television.decreaseVolume(false);
+    runTelevision(nullptr);
+
+    TEST_ASSERT_EQUAL_UINT32(volume + 1, television.getVolume());
+    TEST_ASSERT_EQUAL_INT((volume + 1) * 2, receiver.halfSteps);
+
+    // La première hausse est déjà en cours d'émission : seule la seconde est annulée par la baisse.
+    TEST_ASSERT_EQUAL_UINT32(2, receiver.volumeCommands);
+}
+
+/// @brief Une hausse de l'utilisateur émise alors que les baisses de la calibration sont encore dans la file ne les annule pas : la télévision atteint bien zéro avant la hausse.
+void test_volume_calibration_not_coalesced()
+{
+    while (television.getVolume() > 0)
+        television.decreaseVolume(false);
+
+    calibrate(37, nullptr);
+    TEST_ASSERT_EQUAL_INT(0, receiver.halfSteps);
+
+    receiver.halfSteps = 37;
+    television.syncVolume(false);
+
+    while (television.isCalibrating())
+    {
+        television.loop();
+        advanceMicros(transmitStep());
+    }
+
+    TEST_ASSERT_TRUE(television.getQueueDepth() > 0);
+    television.increaseVolume(false);
+    runTelevision(nullptr);
+
+    TEST_ASSERT_EQUAL_UINT32(1, television.getVolume());
+    TEST_ASSERT_EQUAL_INT(2, receiver.halfSteps);
+}
+
+/// @brief Lit une musique en entier sur l'horloge simulée, du lancement à l'arrêt de la vidéo. La boucle principale est appelée à intervalles irréguliers, le microphone échantillonne à sa fréquence et l'émetteur infrarouge avance à chacune de ses étapes. La vidéo fait entendre le son clé de 1000 Hz dès son lancement.
+/// @param musicIndex La position de la musique.
+/// @param seed La graine des durées de boucle.
+/// @return `false` si la vidéo ne s'est pas terminée à temps.
+static bool playShow(unsigned int musicIndex, unsigned long seed)
+{
+    randomSeed(seed);
+    television.playMusic(musicIndex);
+
+    unsigned long startTime = millis();
+    unsigned long toneSample = 0;
+    unsigned int elapsedTicks = 0;
+    unsigned int loopTicks = 0;
+    long transmitterDelay = 0;
+
+    while (television.getShowStage() != SHOW_IDLE)
+    {
+        if ((millis() - startTime) >= SHOW_TIMEOUT)
+            return false;
+
+        advanceMicros(SAMPLE_PERIOD);
+
+        if (microphone.isSampling())
+        {
+            long sample = (television.getShowStage() == SHOW_WAIT_TRIGGER) ? lround(200 * sin(2 * M_PI * 1000 * toneSample++ / MICROPHONE_SAMPLE_RATE)) : 0;
+            ADC = 512 + sample;
+            ADC_vect();
+        }
+
+        // Les étapes de l'émetteur sont exécutées à la période d'échantillonnage près.
+        transmitterDelay -= SAMPLE_PERIOD;
+        while (transmitterDelay <= 0 && !television.isTransmitterIdle())
+            transmitterDelay += transmitStep();
+
+        if (television.isTransmitterIdle())
+            transmitterDelay = 0;
+
+        if (++elapsedTicks >= loopTicks)
+        {
+            television.loop();
+            microphone.loop();
+            LEDStrip.loop();
+
+            elapsedTicks = 0;
+            loopTicks = random(LOOP_MINIMUM_TICKS, LOOP_MAXIMUM_TICKS + 1);
+        }
+    }
+
+    return true;
+}
+
+/// @brief Chaque musique fournie est lue plusieurs fois en entier : chaque action est exécutée une fois par lecture, jamais en avance, et avec un retard d'au plus un passage de boucle.
+/// Le second curseur conserve l'ordre des actions : une action distante qui suit de près celle d'un périphérique moins lent attend que celle-ci soit envoyée. Son retard est seulement borné par la latence qu'elle compense, pour que la commande parte au plus tard au moment de l'action.
+void test_show_dispatch_jitter()
+{
+    sofaLight.setLatency(SOFA_LIGHT_LATENCY);
+    bedLight.setLatency(BED_LIGHT_LATENCY);
+
+    for (unsigned int musicIndex = 0; musicIndex < MUSICS_NUMBER; musicIndex++)
+    {
+        Music music = television.getMusicFromIndex(musicIndex);
+        TEST_ASSERT_TRUE(music.actionsNumber <= SHOW_MAXIMUM_ACTIONS);
+
+        dispatches = showDispatches[musicIndex];
+        for (unsigned long run = 1; run <= SHOW_RUNS; run++)
+            TEST_ASSERT_TRUE_MESSAGE(playShow(musicIndex, run), readProgmemString(music.friendlyName).c_str());
+
+        dispatches = nullptr;
+
+        for (unsigned int i = 0; i < music.actionsNumber; i++)
+        {
+            char message[64];
+            snprintf(message, sizeof(message), "%s, action %u", readProgmemString(music.friendlyName).c_str(), i);
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(SHOW_RUNS, showDispatches[musicIndex][i].executions, message);
+            TEST_ASSERT_TRUE_MESSAGE(showDispatches[musicIndex][i].maximumLateness <= (MAXIMUM_LATENESS + (showDispatches[musicIndex][i].latency * 1000UL)), message);
+        }
+    }
+}
+
+/// @brief Chaque périphérique est réservé puis libéré une seule fois par vidéo : une lecture envoie deux messages de disponibilité par périphérique, quel que soit le nombre d'actions.
+void test_show_availability_messages()
+{
+    const unsigned long devicesNumber = sizeof(musicDevices) / sizeof(musicDevices[0]);
+
+    for (unsigned int musicIndex = 0; musicIndex < MUSICS_NUMBER; musicIndex++)
+    {
+        unsigned long availabilityUpdates = sentMessages.availabilityUpdates;
+        unsigned long actions = executedActions;
+
+        TEST_ASSERT_TRUE(playShow(musicIndex, 1));
+
+        showAvailabilityUpdates[musicIndex] = sentMessages.availabilityUpdates - availabilityUpdates;
+        showExecutedActions[musicIndex] = executedActions - actions;
+        TEST_ASSERT_EQUAL_UINT32(devicesNumber * 2, showAvailabilityUpdates[musicIndex]);
+    }
+}
+
+/// @brief Un périphérique bloqué entre la demande de lecture et la préparation des périphériques annule la vidéo : les périphériques déjà réservés sont libérés sans être modifiés, et le périphérique bloqué le reste.
+void test_show_device_unavailable()
+{
+    television.playMusic(2);
+    LEDCube.turnOn();
+    alarm.lock();
+
+    unsigned long availabilityUpdates = sentMessages.availabilityUpdates;
+    television.loop();
+
+    TEST_ASSERT_TRUE(television.getShowStage() == SHOW_IDLE);
+    TEST_ASSERT_TRUE(alarm.isLocked());
+    TEST_ASSERT_TRUE(LEDCube.getState());
+
+    for (unsigned int i = 0; i < (sizeof(musicDevices) / sizeof(musicDevices[0])); i++)
+        TEST_ASSERT_TRUE(!musicDevices[i]->isOwnedBy(&television));
+
+    // Les périphériques placés avant l'alarme dans la liste ont été réservés puis libérés.
+    TEST_ASSERT_EQUAL_UINT32(9 * 2, sentMessages.availabilityUpdates - availabilityUpdates);
+
+    // Une fois l'alarme débloquée, la vidéo peut à nouveau être lue.
+    alarm.unLock();
+    LEDCube.turnOff();
+    TEST_ASSERT_TRUE(playShow(2, 1));
+}
+
+/// @brief Affiche, pour chaque musique, les messages de disponibilité envoyés par une lecture, et ceux qu'envoyait le blocage puis le déblocage du périphérique à chaque action.
+static void printAvailabilityMessages()
+{
+    const unsigned long devicesNumber = sizeof(musicDevices) / sizeof(musicDevices[0]);
+
+    printf("\n%-32s %8s %20s %20s\n", "Musique", "Actions", "Messages (avant)", "Messages (après)");
+
+    for (unsigned int musicIndex = 0; musicIndex < MUSICS_NUMBER; musicIndex++)
+    {
+        Music music = television.getMusicFromIndex(musicIndex);
+        printf("%-32s %8lu %20lu %20lu\n", readProgmemString(music.friendlyName).c_str(), showExecutedActions[musicIndex], (devicesNumber * 2) + (showExecutedActions[musicIndex] * 2), showAvailabilityUpdates[musicIndex]);
+    }
+}
+
+/// @brief Affiche le retard moyen et maximal de chaque action de la première musique, puis de l'ensemble des actions de chaque musique.
+static void printDispatches()
+{
+    Music music = television.getMusicFromIndex(0);
+    unsigned long timecode = 0;
+
+    printf("\n%s (%u lectures, boucle de %.1f à %.1f ms)\n", readProgmemString(music.friendlyName).c_str(), SHOW_RUNS, LOOP_MINIMUM_TICKS * SAMPLE_PERIOD / 1000.0, LOOP_MAXIMUM_TICKS * SAMPLE_PERIOD / 1000.0);
+    printf("%6s %10s %10s %10s %14s %14s\n", "Action", "Moment", "Appareil", "Latence", "Retard moyen", "Retard max");
+
+    for (unsigned int i = 0; i < music.actionsNumber && i < SHOW_MAXIMUM_ACTIONS; i++)
+    {
+        Action action;
+        memcpy_P(&action, &music.actionList[i], sizeof(Action));
+        timecode += action.delay;
+
+        const ActionDispatch &dispatch = showDispatches[0][i];
+        double meanLateness = (dispatch.executions > 0) ? (double)dispatch.totalLateness / dispatch.executions : 0;
+        printf("%6u %8lu ms %10u %7u ms %11.0f µs %11lu µs\n", i, timecode, action.deviceID, dispatch.latency, meanLateness, dispatch.maximumLateness);
+    }
+
+    printf("\n%-32s %8s %14s %14s\n", "Musique", "Actions", "Retard moyen", "Retard max");
+
+    for (unsigned int musicIndex = 0; musicIndex < MUSICS_NUMBER; musicIndex++)
+    {
+        music = television.getMusicFromIndex(musicIndex);
+        unsigned long executions = 0;
+        unsigned long long totalLateness = 0;
+        unsigned long maximumLateness = 0;
+
+        for (unsigned int i = 0; i < music.actionsNumber && i < SHOW_MAXIMUM_ACTIONS; i++)
+        {
+            executions += showDispatches[musicIndex][i].executions;
+            totalLateness += showDispatches[musicIndex][i].totalLateness;
+            maximumLateness = max(maximumLateness, showDispatches[musicIndex][i].maximumLateness);
+        }
+
+        printf("%-32s %8u %11.0f µs %11lu µs\n", readProgmemString(music.friendlyName).c_str(), music.actionsNumber, (executions > 0) ? (double)totalLateness / executions : 0, maximumLateness);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    advanceTime(1000);
+    microphone.setup();
+    television.setMicrophone(microphone);
+    LEDStrip.setup();
+    television.setMusicsList(musics, MUSICS_NUMBER);
+    television.setMusicDevices(musicDevices, sizeof(musicDevices) / sizeof(musicDevices[0]));
+    television.setup();
+    television.turnOn(false);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_trigger_pure_tones);
+    RUN_TEST(test_trigger_quiet_tone);
+    RUN_TEST(test_trigger_off_bin_tones);
+    RUN_TEST(test_trigger_noisy_tones);
+    RUN_TEST(test_trigger_consecutive_blocks);
+    RUN_TEST(test_trigger_detection_time);
+    RUN_TEST(test_volume_calibration);
+    RUN_TEST(test_volume_calibration_user_changes);
+    RUN_TEST(test_volume_coalescing);
+    RUN_TEST(test_volume_calibration_not_coalesced);
+    RUN_TEST(test_show_dispatch_jitter);
+    RUN_TEST(test_show_availability_messages);
+    RUN_TEST(test_show_device_unavailable);
+    int result = UNITY_END();
+
+    printDispatches();
+    printAvailabilityMessages();
+    return result;
+}
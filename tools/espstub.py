@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""Remplaçant de l'ESP pour tester les musiques diffusées (à exécuter sur l'ordinateur).
+
+Le script répond aux demandes d'actions de la télévision (`HomeAssistant::requestMusicActions()`) avec des musiques
+lues dans des fichiers, comme le ferait l'ESP. Les autres messages de l'Arduino sont simplement affichés.
+
+  espstub.py --port /dev/ttyACM0 --show 0=chronologie.csv --show 1=src/musics.hpp:testActionSources
+  espstub.py --show 0=chronologie.csv < demandes.txt      (sans port : lecture de l'entrée standard)
+
+Les chronologies CSV/JSON sont lues et vérifiées par showtool.py. Des pannes peuvent être simulées pour tester le
+contrôle de flux : --drop (proportion de trames perdues), --corrupt (proportion de trames tronquées) et
+--stall-after (nombre de demandes servies avant que l'ESP cesse de répondre).
+
+Protocole (une trame par ligne) :
+  Arduino → ESP : 5 ID(2) musique(2) première position(4) nombre(2)
+  ESP → Arduino : 0 ID(2) 03 5 position(4) moment en ms(8) action     (une trame par action)
+                  0 ID(2) 03 6 nombre total d'actions(4)                (lorsque la demande atteint la fin)
+"""
+
+import argparse
+import os
+import random
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import showtool  # noqa: E402
+
+# Vitesse de la liaison série de l'Arduino (`HomeAssistant::setup()`).
+BAUDRATE = 9600
+
+
+def load_show(source, devices):
+    if ":" in source and source.split(":")[0].endswith(".hpp"):
+        path, symbol = source.rsplit(":", 1)
+        actions = showtool.load_sources(path, symbol)[symbol]
+    else:
+        actions, _ = showtool.load(source, devices)
+
+    actions, errors, warnings = showtool.validate(actions, devices, source, fix=True)
+    for message in warnings + errors:
+        print(message, file=sys.stderr)
+    if errors:
+        raise showtool.ShowError("%s : musique invalide" % source)
+
+    return actions
+
+
+class Link:
+    """Liaison avec l'Arduino : port série, ou entrée et sortie standard."""
+
+    def __init__(self, port):
+        self.serial = None
+        if port:
+            import serial  # pyserial
+
+            self.serial = serial.Serial(port, BAUDRATE, timeout=0.1)
+
+    def lines(self):
+        if self.serial is None:
+            for line in sys.stdin:
+                yield line.strip()
+            return
+
+        pending = b""
+        while True:
+            pending += self.serial.read(64)
+            while b"\n" in pending:
+                line, pending = pending.split(b"\n", 1)
+                yield line.decode("ascii", "replace").strip()
+
+    def send(self, frame):
+        if self.serial is None:
+            print(frame, flush=True)
+        else:
+            self.serial.write((frame + "\n").encode("ascii"))
+
+        print("→ %s" % frame, file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Remplaçant de l'ESP pour les musiques diffusées.")
+    parser.add_argument("--port", help="port série de l'Arduino (nécessite pyserial) ; entrée standard sinon")
+    parser.add_argument("--show", action="append", default=[], metavar="NUMÉRO=FICHIER", help="musique servie sous un numéro")
+    parser.add_argument("--drop", type=float, default=0, help="proportion de trames d'action perdues")
+    parser.add_argument("--corrupt", type=float, default=0, help="proportion de trames d'action tronquées")
+    parser.add_argument("--stall-after", type=int, default=-1, help="nombre de demandes servies avant de ne plus répondre")
+    parser.add_argument("--delay", type=float, default=0, help="délai de réponse en secondes")
+    arguments = parser.parse_args()
+
+    try:
+        devices = showtool.Devices()
+        shows = {}
+        for entry in arguments.show:
+            number, _, source = entry.partition("=")
+            shows[int(number)] = load_show(source, devices)
+            print("musique %d : %s (%d actions)" % (int(number), source, len(shows[int(number)])), file=sys.stderr)
+    except (showtool.ShowError, OSError, ValueError) as error:
+        print("erreur : %s" % error, file=sys.stderr)
+        return 1
+
+    link = Link(arguments.port)
+    served = 0
+
+    for line in link.lines():
+        if not line:
+            continue
+
+        print("← %s" % line, file=sys.stderr)
+
+        if not line.startswith("5") or len(line) != 11 or not line.isdigit():
+            continue
+
+        ID, number, first, count = int(line[1:3]), int(line[3:5]), int(line[5:9]), int(line[9:11])
+        if number not in shows:
+            print("musique %d inconnue" % number, file=sys.stderr)
+            continue
+
+        if 0 <= arguments.stall_after <= served:
+            print("demande ignorée (panne simulée)", file=sys.stderr)
+            continue
+
+        served += 1
+        time.sleep(arguments.delay)
+
+        actions = shows[number]
+        for index in range(first, min(first + count, len(actions))):
+            frame = "0%02d035%04d%08d%s" % (ID, index, actions[index].timecode, actions[index].code)
+            if random.random() < arguments.drop:
+                print("trame perdue : %s" % frame, file=sys.stderr)
+                continue
+            if random.random() < arguments.corrupt:
+                frame = frame[:random.randint(1, len(frame) - 1)]
+            link.send(frame)
+
+        if first + count >= len(actions):
+            link.send("0%02d036%04d" % (ID, len(actions)))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
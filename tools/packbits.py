@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+"""Générateur de `src/bitmaps.hpp` : compresse les pictogrammes plein écran au format PackBits (à exécuter sur l'ordinateur).
+
+Les pictogrammes (128 × 64) sont lus dans des images PBM ou PNG, dont le nom donne celui du tableau (`bell.png` devient
+`bellBitmap`), ou dans un fichier C contenant des tableaux au format de `drawBitmap()` (lignes de pixels, bit de poids
+fort à gauche), comme ceux produits par image2cpp :
+
+  packbits.py tools/icons/*.pbm -o src/bitmaps.hpp
+  packbits.py ancien_bitmaps.hpp nouveauPictogramme.png -o src/bitmaps.hpp
+  packbits.py src/bitmaps.hpp --export tools/icons      (extraction des pictogrammes en images PBM)
+
+Les tableaux déjà compressés (comme ceux de `src/bitmaps.hpp`) sont aussi acceptés en entrée.
+
+Les octets sont réordonnés comme la mémoire de l'écran SSD1306 (8 pages de 128 colonnes, le bit de poids faible en haut
+de chaque colonne) puis compressés : un en-tête `n` de 0 à 127 est suivi de `n + 1` octets copiés tels quels, un en-tête
+de 129 à 255 est suivi d'un octet répété `257 - n` fois. Chaque tableau est décompressé pour vérifier la compression.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+WIDTH = 128
+HEIGHT = 64
+BITMAP_SIZE = WIDTH * HEIGHT // 8
+
+HEADER = """#ifndef LOGO_DEFINITIONS
+#define LOGO_DEFINITIONS
+
+// Fichier généré par `tools/packbits.py` à partir des images des pictogrammes : ne pas modifier les tableaux à la main.
+// Pictogrammes plein écran (128 × 64) compressés au format PackBits. Les octets sont rangés dans l'ordre de la mémoire de l'écran SSD1306 (8 pages de 128 colonnes, le bit de poids faible en haut de chaque colonne) pour être décompressés directement dans la mémoire tampon.
+// Chaque bloc commence par un en-tête `n` : de 0 à 127, les `n + 1` octets suivants sont copiés tels quels ; de 129 à 255, l'octet suivant est répété `257 - n` fois ; 128 est ignoré.
+"""
+
+FOOTER = "\n#endif"
+
+
+class BitmapError(Exception):
+    pass
+
+
+def read_header(path):
+    """Lit les tableaux au format de `drawBitmap()` d'un fichier C : renvoie une liste de (nom, pixels)."""
+    with open(path, encoding="utf-8") as file:
+        text = file.read()
+
+    bitmaps = []
+    for name, body in re.findall(r"unsigned\s+char\s+(\w+)\s*\[\s*\]\s*(?:PROGMEM)?\s*=\s*\{([^}]*)\}", text):
+        data = [int(value, 0) for value in re.findall(r"0[xX][0-9a-fA-F]+|\d+", body)]
+        if len(data) == BITMAP_SIZE:
+            pixels = [[bool(data[y * WIDTH // 8 + x // 8] & (0x80 >> (x % 8))) for x in range(WIDTH)] for y in range(HEIGHT)]
+        elif len(decode(data)) == BITMAP_SIZE:
+            pixels = from_pages(decode(data))
+        else:
+            raise BitmapError("%s : %s n'est ni un pictogramme de %d octets ni un pictogramme compressé" % (path, name, BITMAP_SIZE))
+
+        bitmaps.append((name, pixels))
+
+    if not bitmaps:
+        raise BitmapError("%s : aucun tableau trouvé" % path)
+
+    return bitmaps
+
+
+def read_pbm(path):
+    with open(path, "rb") as file:
+        data = file.read()
+
+    tokens = []
+    position = 0
+    while len(tokens) < 3:
+        match = re.compile(rb"\s*(#[^\n]*\n\s*)*(\S+)").match(data, position)
+        if match is None:
+            raise BitmapError("%s : en-tête PBM incomplet" % path)
+        tokens.append(match.group(2))
+        position = match.end()
+
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    if magic == b"P4":
+        position += 1
+        stride = (width + 7) // 8
+        rows = [data[position + y * stride:position + (y + 1) * stride] for y in range(height)]
+        return width, height, [[bool(row[x // 8] & (0x80 >> (x % 8))) for x in range(width)] for row in rows]
+    if magic == b"P1":
+        bits = [character == ord("1") for character in re.sub(rb"#[^\n]*|\s", b"", data[position:])]
+        return width, height, [bits[y * width:(y + 1) * width] for y in range(height)]
+
+    raise BitmapError("%s : seuls les PBM P1 et P4 sont acceptés" % path)
+
+
+def read_png(path):
+    """Lit une image PNG 8 bits non entrelacée ; un pixel est allumé s'il est clair et opaque."""
+    with open(path, "rb") as file:
+        data = file.read()
+
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise BitmapError("%s : fichier PNG invalide" % path)
+
+    position = 8
+    compressed = b""
+    palette = None
+    while position < len(data):
+        length, kind = struct.unpack(">I4s", data[position:position + 8])
+        chunk = data[position + 8:position + 8 + length]
+        position += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [chunk[index:index + 3] for index in range(0, len(chunk), 3)]
+        elif kind == b"IDAT":
+            compressed += chunk
+
+    if depth != 8 or interlace or color not in (0, 2, 3, 4, 6):
+        raise BitmapError("%s : seules les images PNG 8 bits non entrelacées sont acceptées" % path)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    stride = width * channels
+    raw = zlib.decompress(compressed)
+    rows = []
+    previous = bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        row = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for index in range(stride):
+            left = row[index - channels] if index >= channels else 0
+            up = previous[index]
+            corner = previous[index - channels] if index >= channels else 0
+            if kind == 1:
+                row[index] = (row[index] + left) & 0xFF
+            elif kind == 2:
+                row[index] = (row[index] + up) & 0xFF
+            elif kind == 3:
+                row[index] = (row[index] + (left + up) // 2) & 0xFF
+            elif kind == 4:
+                estimate = left + up - corner
+                nearest = min((abs(estimate - left), 0, left), (abs(estimate - up), 1, up), (abs(estimate - corner), 2, corner))
+                row[index] = (row[index] + nearest[2]) & 0xFF
+        rows.append(row)
+        previous = row
+
+    def lit(pixel):
+        if color == 3:
+            pixel = palette[pixel[0]]
+        alpha = pixel[-1] if color in (4, 6) else 255
+        level = sum(pixel[:3] if color in (2, 3, 6) else pixel[:1]) / (3 if color in (2, 3, 6) else 1)
+        return alpha >= 128 and level >= 128
+
+    return width, height, [[lit(row[x * channels:(x + 1) * channels]) for x in range(width)] for row in rows]
+
+
+def read_image(path):
+    width, height, pixels = read_png(path) if path.lower().endswith(".png") else read_pbm(path)
+    if (width, height) != (WIDTH, HEIGHT):
+        raise BitmapError("%s : l'image mesure %d × %d au lieu de %d × %d" % (path, width, height, WIDTH, HEIGHT))
+
+    name = re.sub(r"\W", "", os.path.splitext(os.path.basename(path))[0])
+    return [(name + "Bitmap", pixels)]
+
+
+def to_pages(pixels):
+    """Range les pixels dans l'ordre de la mémoire du SSD1306 : octet (page, colonne), bit b pour la ligne 8 × page + b."""
+    return bytes(sum(1 << bit for bit in range(8) if pixels[page * 8 + bit][x]) for page in range(HEIGHT // 8) for x in range(WIDTH))
+
+
+def from_pages(data):
+    return [[bool(data[(y // 8) * WIDTH + x] & (1 << (y % 8))) for x in range(WIDTH)] for y in range(HEIGHT)]
+
+
+def write_pbm(path, pixels):
+    rows = (bytes(sum(0x80 >> bit for bit in range(8) if row[x + bit]) for x in range(0, WIDTH, 8)) for row in pixels)
+    with open(path, "wb") as file:
+        file.write(b"P4\n%d %d\n" % (WIDTH, HEIGHT) + b"".join(rows))
+
+
+def encode(data):
+    """Compresse au format PackBits : toute répétition d'au moins deux octets est codée par un bloc de répétition."""
+    output = bytearray()
+    literal = bytearray()
+
+    def flush_literal():
+        if literal:
+            output.append(len(literal) - 1)
+            output.extend(literal)
+            literal.clear()
+
+    position = 0
+    while position < len(data):
+        run = 1
+        while position + run < len(data) and run < 128 and data[position + run] == data[position]:
+            run += 1
+
+        if run >= 2:
+            flush_literal()
+            output.extend((257 - run, data[position]))
+        else:
+            literal.append(data[position])
+            if len(literal) == 128:
+                flush_literal()
+        position += run
+
+    flush_literal()
+    return bytes(output)
+
+
+def decode(data):
+    """Décompresse un tableau comme l'écran, pour vérifier la compression."""
+    output = bytearray()
+    position = 0
+    while position < len(data):
+        header = data[position]
+        position += 1
+        if header < 128:
+            output.extend(data[position:position + header + 1])
+            position += header + 1
+        elif header > 128:
+            output.extend(data[position:position + 1] * (257 - header))
+            position += 1
+
+    return bytes(output)
+
+
+def emit(name, data):
+    lines = ["    " + " ".join("0x%02x," % value for value in data[index:index + 16]) for index in range(0, len(data), 16)]
+    return "\nconst unsigned char %s[] PROGMEM = {\n%s};\n" % (name, "\n".join(lines)[:-1])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compresse les pictogrammes plein écran pour src/bitmaps.hpp.")
+    parser.add_argument("sources", nargs="+", help="images PBM ou PNG (128 × 64), ou fichiers C au format de drawBitmap()")
+    parser.add_argument("-o", "--output", help="fichier généré (sortie standard sinon)")
+    parser.add_argument("--export", metavar="DOSSIER", help="enregistre les pictogrammes en images PBM au lieu de générer le fichier")
+    arguments = parser.parse_args()
+
+    try:
+        bitmaps = []
+        for path in arguments.sources:
+            bitmaps += read_header(path) if path.endswith((".h", ".hpp")) else read_image(path)
+    except (BitmapError, OSError, ValueError, struct.error, zlib.error) as error:
+        print("erreur : %s" % error, file=sys.stderr)
+        return 1
+
+    if arguments.export:
+        os.makedirs(arguments.export, exist_ok=True)
+        for name, pixels in bitmaps:
+            write_pbm(os.path.join(arguments.export, re.sub(r"Bitmap$", "", name) + ".pbm"), pixels)
+        return 0
+
+    text = HEADER
+    total = 0
+    for name, pixels in bitmaps:
+        pages = to_pages(pixels)
+        packed = encode(pages)
+        if decode(packed) != pages:
+            print("erreur : %s : la compression n'est pas réversible" % name, file=sys.stderr)
+            return 1
+
+        text += emit(name, packed)
+        total += len(packed)
+        print("%s : %d octets (%d décompressés)" % (name, len(packed), len(pages)), file=sys.stderr)
+    text += FOOTER
+
+    print("total : %d octets pour %d pictogrammes" % (total, len(bitmaps)), file=sys.stderr)
+    if arguments.output:
+        with open(arguments.output, "w", encoding="utf-8") as file:
+            file.write(text)
+    else:
+        sys.stdout.write(text)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,503 @@
+#!/usr/bin/env python3
+"""Outil de préparation des musiques animées (à exécuter sur l'ordinateur, pas sur l'Arduino).
+
+Une chorégraphie est écrite sous forme de chronologie lisible (CSV ou JSON), puis :
+  - validée avec les identifiants et les types de périphériques de src/deviceID.hpp (table `MUSIC_DEVICES`) ;
+  - triée et dédoublonnée ;
+  - convertie en tableaux C++ à copier dans src/musics.hpp ;
+  - simulée pour obtenir la chronologie de chaque périphérique et un rapport de latence d'envoi.
+
+Commandes :
+  showtool.py check [src/musics.hpp]                  Vérifie les musiques déjà présentes dans musics.hpp.
+  showtool.py build chronologie.csv --symbol test --name "Test" --url https://...
+                                                      Affiche le bloc C++ de la musique.
+  showtool.py report chronologie.csv [--latency SOFA_LIGHT=350 ...]
+                                                      Affiche la chronologie par périphérique et le rapport de latence.
+  showtool.py export src/musics.hpp testActionSources Convertit une musique existante en CSV.
+
+Format CSV (une action par ligne, `#` pour les commentaires) :
+  temps,périphérique,action,arguments...
+  12500,LED_STRIP,transition,0,0,0,255,255,255,4000,in_out_cubic
+  1:02.300,SOFA_LIGHT,luminosity,50
+  13000,09010255000000                                (action déjà codée)
+
+Le temps est en millisecondes, ou au format `minutes:secondes.millisecondes`. Le périphérique est son nom dans
+deviceID.hpp (sans `ID_`) ou son numéro. Actions : off, on, toggle, color r g b, transition r g b r g b durée [effet],
+strobe r g b vitesse, light_color r g b, temperature kelvins, luminosity valeur.
+
+Format JSON : une liste d'objets {"time": ..., "device": ..., "action": ..., "args": [...]} ou {"time": ..., "raw": "..."},
+éventuellement dans un objet {"name": ..., "url": ..., "actions": [...]}.
+"""
+
+import argparse
+import csv
+import json
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir)
+SOURCE = os.path.join(ROOT, "src")
+
+# Instructions : (type, sous-type) de la chaîne d'action → nom, longueur exacte de la chaîne.
+OPCODES = {
+    (0, 0): ("off", 5),
+    (0, 1): ("on", 5),
+    (0, 2): ("toggle", 5),
+    (1, 0): ("color", 14),
+    (1, 1): ("transition", 29),
+    (1, 2): ("strobe", 18),
+    (2, 0): ("temperature", 9),
+    (2, 1): ("luminosity", 8),
+    (3, 0): ("light_color", 14),
+    (3, 1): ("temperature", 9),
+    (3, 2): ("luminosity", 8),
+}
+
+# Instructions acceptées par chaque type de périphérique (voir `actionAccepted()` dans musicActions.hpp).
+ACCEPTED = {
+    "ACTION_DEVICE_OUTPUT": {"off", "on", "toggle"},
+    "ACTION_DEVICE_STRIP": {"off", "on", "toggle", "color", "transition", "strobe"},
+    "ACTION_DEVICE_TEMPERATURE_LIGHT": {"off", "on", "toggle", "temperature", "luminosity"},
+    "ACTION_DEVICE_COLOR_LIGHT": {"off", "on", "toggle", "light_color", "temperature", "luminosity"},
+}
+
+EASINGS = ["linear", "in_cubic", "out_cubic", "in_out_cubic"]
+
+# Délai maximal entre deux actions (champ `delay` de 16 bit de `Action`).
+MAXIMUM_DELAY = 65535
+
+
+class ShowError(Exception):
+    pass
+
+
+class Action:
+    """Action d'une musique, conservée sous sa forme codée (celle de musics.hpp) et décodée."""
+
+    def __init__(self, timecode, code, line=None):
+        self.timecode = timecode
+        self.code = code
+        self.line = line
+        self.device = int(code[0:2])
+        self.name, self.arguments = decode(code)
+
+    def describe(self, devices):
+        device = devices.names.get(self.device, str(self.device))
+        arguments = " ".join(str(argument) for argument in self.arguments)
+        return "%s %s %s" % (device, self.name, arguments) if arguments else "%s %s" % (device, self.name)
+
+
+class Devices:
+    """Identifiants et types des périphériques, lus dans src/deviceID.hpp."""
+
+    def __init__(self, path=os.path.join(SOURCE, "deviceID.hpp")):
+        with open(path, encoding="utf-8") as file:
+            text = file.read()
+
+        self.IDs = {}
+        for name, value in re.findall(r"#define ID_(\w+) (\d+)", text):
+            self.IDs[name] = int(value)
+
+        self.names = {}
+        for name, value in self.IDs.items():
+            self.names.setdefault(value, name)
+
+        # Table `MUSIC_DEVICES` : seuls ces périphériques sont pilotables par une musique.
+        self.types = {}
+        for name, kind in re.findall(r"DEVICE\(ID_(\w+), (ACTION_DEVICE_\w+), \w+\)", text):
+            if name not in self.IDs:
+                raise ShowError("deviceID.hpp : ID_%s absent de la table des identifiants" % name)
+
+            self.types[self.IDs[name]] = kind
+            self.names[self.IDs[name]] = name
+
+        if not self.types:
+            raise ShowError("deviceID.hpp : table MUSIC_DEVICES introuvable")
+
+    def resolve(self, device):
+        device = str(device).strip()
+        if device.isdigit():
+            return int(device)
+
+        name = device.upper()
+        if name.startswith("ID_"):
+            name = name[3:]
+
+        if name not in self.IDs:
+            raise ShowError("périphérique inconnu : %s" % device)
+
+        return self.IDs[name]
+
+
+def decode(code):
+    """Décode une chaîne d'action en nom d'instruction et arguments, en vérifiant sa forme."""
+    if not code.isdigit():
+        raise ShowError("action %r : caractère non numérique" % code)
+
+    if len(code) < 5:
+        raise ShowError("action %r : trop courte" % code)
+
+    key = (int(code[2:4]), int(code[4]))
+    if key not in OPCODES:
+        raise ShowError("action %r : type d'action inconnu" % code)
+
+    name, length = OPCODES[key]
+    if len(code) != length:
+        raise ShowError("action %r : %d caractères au lieu de %d pour %s" % (code, len(code), length, name))
+
+    def field(position, size, maximum):
+        value = int(code[position:position + size])
+        if value > maximum:
+            raise ShowError("action %r : valeur %d hors limites (maximum %d)" % (code, value, maximum))
+        return value
+
+    colors = lambda number: [field(5 + (3 * i), 3, 255) for i in range(number)]
+
+    if name in ("color", "light_color"):
+        return name, colors(3)
+
+    if name == "transition":
+        return name, colors(6) + [field(23, 5, 65535), EASINGS[field(28, 1, 3)]]
+
+    if name == "strobe":
+        return name, colors(3) + [field(14, 4, 9999)]
+
+    if name == "temperature":
+        return name, [field(5, 4, 9999)]
+
+    if name == "luminosity":
+        return name, [field(5, 3, 255)]
+
+    return name, []
+
+
+def encode(devices, device, name, arguments):
+    """Code une action lisible dans le format de musics.hpp."""
+    ID = devices.resolve(device)
+    if ID not in devices.types:
+        raise ShowError("le périphérique %s n'est pas pilotable par une musique (table MUSIC_DEVICES)" % device)
+
+    kind = devices.types[ID]
+    name = name.strip().lower()
+    if name not in ACCEPTED[kind]:
+        raise ShowError("l'action %s n'est pas acceptée par %s (%s)" % (name, devices.names[ID], kind))
+
+    def number(value, maximum, width):
+        value = int(value)
+        if value < 0 or value > maximum:
+            raise ShowError("%s : valeur %d hors limites (0 à %d)" % (name, value, maximum))
+        return "%0*d" % (width, value)
+
+    def expect(count):
+        if len(arguments) != count:
+            raise ShowError("%s : %d argument(s) attendu(s), %d donné(s)" % (name, count, len(arguments)))
+
+    colors = lambda values: "".join(number(value, 255, 3) for value in values)
+    prefix = "%02d" % ID
+    light = "03" if kind == "ACTION_DEVICE_COLOR_LIGHT" else "02"
+
+    if name in ("off", "on", "toggle"):
+        expect(0)
+        return prefix + "00" + str(["off", "on", "toggle"].index(name))
+
+    if name == "color":
+        expect(3)
+        return prefix + "010" + colors(arguments)
+
+    if name == "transition":
+        if len(arguments) == 7:
+            arguments = list(arguments) + ["linear"]
+        expect(8)
+        easing = str(arguments[7]).strip().lower()
+        easing = EASINGS.index(easing) if easing in EASINGS else int(number(easing, 3, 1))
+        return prefix + "011" + colors(arguments[0:6]) + number(arguments[6], 65535, 5) + str(easing)
+
+    if name == "strobe":
+        expect(4)
+        return prefix + "012" + colors(arguments[0:3]) + number(arguments[3], 9999, 4)
+
+    if name == "light_color":
+        expect(3)
+        return prefix + "030" + colors(arguments)
+
+    if name == "temperature":
+        expect(1)
+        return prefix + light + ("0" if light == "02" else "1") + number(arguments[0], 9999, 4)
+
+    expect(1)
+    return prefix + light + ("1" if light == "02" else "2") + number(arguments[0], 255, 3)
+
+
+def parse_time(value):
+    value = str(value).strip()
+    match = re.fullmatch(r"(\d+):(\d+(?:\.\d+)?)", value)
+    if match:
+        return int(round((int(match.group(1)) * 60 + float(match.group(2))) * 1000))
+
+    if not value.isdigit():
+        raise ShowError("temps invalide : %r" % value)
+
+    return int(value)
+
+
+def load(path, devices):
+    """Lit une chronologie CSV ou JSON. Renvoie (actions, informations de la musique)."""
+    actions = []
+    information = {}
+
+    def add(line, time, device=None, name=None, arguments=(), raw=None):
+        try:
+            code = raw.strip() if raw else encode(devices, device, name, [argument for argument in arguments if str(argument).strip() != ""])
+            actions.append(Action(parse_time(time), code, line))
+        except (ShowError, ValueError) as error:
+            raise ShowError("%s:%s : %s" % (path, line, error))
+
+    with open(path, encoding="utf-8") as file:
+        if path.endswith(".json"):
+            data = json.load(file)
+            if isinstance(data, dict):
+                information = {key: value for key, value in data.items() if key != "actions"}
+                data = data.get("actions", [])
+
+            for index, entry in enumerate(data, 1):
+                add(index, entry["time"], entry.get("device"), entry.get("action"), entry.get("args", []), entry.get("raw"))
+
+        else:
+            for line, row in enumerate(csv.reader(file), 1):
+                if not row or not row[0].strip() or row[0].strip().startswith("#"):
+                    continue
+
+                if row[0].strip().lower() in ("temps", "time", "timecode"):
+                    continue
+
+                if len(row) == 2:
+                    add(line, row[0], raw=row[1])
+                else:
+                    add(line, row[0], row[1], row[2], row[3:])
+
+    return actions, information
+
+
+def load_sources(path, symbol=None):
+    """Lit les tableaux `ActionSource` de musics.hpp. Renvoie {symbole: actions}."""
+    with open(path, encoding="utf-8") as file:
+        text = file.read()
+
+    shows = {}
+    for match in re.finditer(r"constexpr ActionSource (\w+)\[\] = \{(.*?)\n\};", text, re.S):
+        if symbol is not None and match.group(1) != symbol:
+            continue
+
+        first = text.count("\n", 0, match.start(2)) + 1
+        actions = []
+        for entry in re.finditer(r"\{(\d+), \"([^\"]*)\"\}", match.group(2)):
+            line = first + match.group(2).count("\n", 0, entry.start())
+            try:
+                actions.append(Action(int(entry.group(1)), entry.group(2), line))
+            except ShowError as error:
+                raise ShowError("%s:%d : %s" % (path, line, error))
+
+        shows[match.group(1)] = actions
+
+    if symbol is not None and symbol not in shows:
+        raise ShowError("%s : tableau %s introuvable" % (path, symbol))
+
+    return shows
+
+
+def validate(actions, devices, name, fix=False):
+    """Vérifie les périphériques, l'ordre et les délais d'une liste d'actions. Renvoie (actions, erreurs, avertissements)."""
+    errors = []
+    warnings = []
+
+    for action in actions:
+        if action.device not in devices.types:
+            errors.append("%s, ligne %s : le périphérique %d n'est pas pilotable par une musique" % (name, action.line, action.device))
+        elif action.name not in ACCEPTED[devices.types[action.device]]:
+            errors.append("%s, ligne %s : l'action %s n'est pas acceptée par %s" % (name, action.line, action.name, devices.names[action.device]))
+
+    if fix:
+        # Tri stable : l'ordre du fichier est conservé pour les actions simultanées.
+        ordered = sorted(actions, key=lambda action: action.timecode)
+        unique = []
+        for action in ordered:
+            previous = [other for other in unique if other.timecode == action.timecode and other.device == action.device]
+            if any(other.code == action.code for other in previous):
+                warnings.append("%s, ligne %s : action en double supprimée (%d ms, %s)" % (name, action.line, action.timecode, action.code))
+                continue
+
+            if previous:
+                warnings.append("%s, ligne %s : plusieurs actions pour %s à %d ms" % (name, action.line, devices.names.get(action.device), action.timecode))
+
+            unique.append(action)
+
+        actions = unique
+
+    previous = 0
+    for action in actions:
+        if action.timecode < previous:
+            errors.append("%s, ligne %s : %d ms après %d ms (actions non triées)" % (name, action.line, action.timecode, previous))
+        elif action.timecode - previous > MAXIMUM_DELAY:
+            errors.append("%s, ligne %s : %d ms depuis l'action précédente (maximum %d)" % (name, action.line, action.timecode - previous, MAXIMUM_DELAY))
+
+        previous = max(previous, action.timecode)
+
+    return actions, errors, warnings
+
+
+def cpp_string(text):
+    return '"%s"' % text.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def emit(actions, symbol, name, url):
+    lines = ["// Musique : %s." % name, "constexpr ActionSource %sActionSources[] = {" % symbol]
+    lines += ['    {%d, "%s"},' % (action.timecode, action.code) for action in actions]
+    lines += [
+        "};",
+        "constexpr ActionList<countActions(%sActionSources)> %sActions PROGMEM = compileActions(%sActionSources);" % (symbol, symbol, symbol),
+        "const char %sName[] PROGMEM = %s;" % (symbol, cpp_string(name)),
+        "const char %sVideoURL[] PROGMEM = %s;" % (symbol, cpp_string(url)),
+        "const Music %sMusic PROGMEM = {" % symbol,
+        "    %sName," % symbol,
+        "    %sVideoURL," % symbol,
+        "    %sActions.actions," % symbol,
+        "    countActions(%sActionSources)};" % symbol,
+    ]
+    return "\n".join(lines)
+
+
+def read_define(path, name, default):
+    try:
+        with open(path, encoding="utf-8") as file:
+            match = re.search(r"#define %s (\d+)" % name, file.read())
+    except OSError:
+        return default
+
+    return int(match.group(1)) if match else default
+
+
+def report(actions, devices, latencies, output=sys.stdout):
+    """Simule la diffusion d'une musique comme `Television::scheduleMusic()` : chronologie par périphérique et latence d'envoi."""
+    television = os.path.join(SOURCE, "device", "output", "television.hpp")
+    lookahead = read_define(television, "MUSIC_LOOKAHEAD", 1000)
+    bufferSize = read_define(television, "MUSIC_STREAM_BUFFER_SIZE", 16)
+    requestTimeout = read_define(television, "MUSIC_STREAM_REQUEST_TIMEOUT", 1000)
+
+    def time(milliseconds):
+        return "%d:%06.3f" % (milliseconds // 60000, (milliseconds % 60000) / 1000)
+
+    print("Chronologie par périphérique", file=output)
+    for ID in sorted(set(action.device for action in actions)):
+        deviceActions = [action for action in actions if action.device == ID]
+        latency = min(latencies.get(ID, 0), lookahead)
+        print("\n  %s (%d), %d action(s), latence %d ms" % (devices.names.get(ID, ID), ID, len(deviceActions), latency), file=output)
+
+        previous = None
+        for action in deviceActions:
+            sent = action.timecode - latency
+            notes = []
+            if latency > 0:
+                notes.append("envoyée à %s" % time(max(sent, 0)))
+            if sent < 0:
+                notes.append("avance impossible : %d ms de retard" % -sent)
+            if previous is not None and action.timecode - previous.timecode < latency:
+                notes.append("%d ms après la précédente, moins que la latence" % (action.timecode - previous.timecode))
+
+            print("    %s  %-40s %s" % (time(action.timecode), action.describe(devices), " ; ".join(notes)), file=output)
+            previous = action
+
+    # Les actions sont envoyées dans l'ordre de la liste : une action locale n'attend jamais une action distante plus tardive.
+    print("\nLatence d'envoi", file=output)
+    dispatches = sorted(((action.timecode - min(latencies.get(action.device, 0), lookahead), action) for action in actions), key=lambda dispatch: dispatch[0])
+    late = [action for sent, action in dispatches if sent < 0]
+    print("  %d action(s), dont %d envoyée(s) en avance" % (len(actions), sum(1 for action in actions if latencies.get(action.device, 0) > 0)), file=output)
+    print("  %d action(s) trop proche(s) du début pour compenser la latence" % len(late), file=output)
+
+    # Diffusion depuis l'ESP : la mémoire tampon doit contenir toutes les actions d'une fenêtre de renouvellement.
+    densest = 0
+    start = 0
+    for end in range(len(actions)):
+        while actions[end].timecode - actions[start].timecode > requestTimeout:
+            start += 1
+        densest = max(densest, end - start + 1)
+
+    print("  diffusion : au plus %d action(s) en %d ms pour une mémoire tampon de %d%s" % (densest, requestTimeout, bufferSize, " (risque de retard)" if densest > bufferSize else ""), file=output)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Préparation des musiques animées.")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    check = commands.add_parser("check", help="vérifie les musiques de musics.hpp")
+    check.add_argument("musics", nargs="?", default=os.path.join(SOURCE, "musics.hpp"))
+
+    build = commands.add_parser("build", help="génère le bloc C++ d'une musique")
+    build.add_argument("timeline")
+    build.add_argument("--symbol", required=True, help="préfixe des noms C++ (ex. : cruelSummer)")
+    build.add_argument("--name", help="nom affiché de la musique")
+    build.add_argument("--url", help="adresse de la vidéo")
+
+    simulate = commands.add_parser("report", help="chronologie par périphérique et rapport de latence")
+    simulate.add_argument("timeline", help="chronologie CSV/JSON, ou musics.hpp:tableau")
+    simulate.add_argument("--latency", action="append", default=[], metavar="PÉRIPHÉRIQUE=MS", help="latence d'un périphérique distant")
+
+    export = commands.add_parser("export", help="convertit une musique de musics.hpp en CSV")
+    export.add_argument("musics")
+    export.add_argument("symbol")
+
+    arguments = parser.parse_args()
+
+    try:
+        devices = Devices()
+
+        if arguments.command == "check":
+            failed = False
+            for symbol, actions in load_sources(arguments.musics).items():
+                actions, errors, warnings = validate(actions, devices, symbol)
+                for message in warnings + errors:
+                    print(message, file=sys.stderr)
+                failed |= bool(errors)
+                print("%s : %d action(s)%s" % (symbol, len(actions), ", erreurs" if errors else ""))
+            return 1 if failed else 0
+
+        if arguments.command == "export":
+            writer = csv.writer(sys.stdout, lineterminator="\n")
+            writer.writerow(["time", "device", "action", "arguments"])
+            for action in load_sources(arguments.musics, arguments.symbol)[arguments.symbol]:
+                writer.writerow([action.timecode, devices.names.get(action.device, action.device), action.name] + action.arguments)
+            return 0
+
+        if arguments.command == "report" and ":" in arguments.timeline and arguments.timeline.split(":")[0].endswith(".hpp"):
+            path, symbol = arguments.timeline.rsplit(":", 1)
+            actions, information = load_sources(path, symbol)[symbol], {}
+        else:
+            actions, information = load(arguments.timeline, devices)
+
+        actions, errors, warnings = validate(actions, devices, arguments.timeline, fix=True)
+        for message in warnings + errors:
+            print(message, file=sys.stderr)
+        if errors:
+            return 1
+
+        if arguments.command == "build":
+            name = arguments.name or information.get("name") or arguments.symbol
+            url = arguments.url or information.get("url") or ""
+            print(emit(actions, arguments.symbol, name, url))
+            return 0
+
+        latencies = {}
+        for entry in arguments.latency:
+            device, _, value = entry.partition("=")
+            latencies[devices.resolve(device)] = int(value)
+
+        report(actions, devices, latencies)
+        return 0
+
+    except (ShowError, OSError, KeyError, json.JSONDecodeError) as error:
+        print("erreur : %s" % error, file=sys.stderr)
+        return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())